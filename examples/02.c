@@ -2,44 +2,85 @@
 //
 // Perlin noise landscape
 
+// the heightmap mode needs shaders
+#ifdef OS_WINDOWS
+#  include "../lib/glew-2.0.0/include/GL/glew.h"
+#  include "../lib/glew-2.0.0/src/wglew.c"
+#else
+#  include "../lib/glew-2.0.0/include/GL/glew.h"
+#  include "../lib/glew-2.0.0/src/glew.c"
+#endif
+
 #include "../world.h"
 #include "noise.c"
 
-static int LAND_WIDTH = 400;
-static int LAND_HEIGHT = 400;
+static int LAND_WIDTH = 1265;
+static int LAND_HEIGHT = 1265;
 #define ZSCALE 10.0
 
-static float *_points;
-static float *_normals;
-static uint32_t *_indices;
+static float *_heights;
+static float *_offsets;  // X and Y distortion
 static float *_colors;
+static Grid _grid;
 
 static unsigned int _numPoints;
-static unsigned int _numIndices;
 
 void buildWorld();
 
+// the landscape lives on the GPU in patches, far ones drawn with fewer triangles
+static GridLOD *_landscape;
+static float _pixelError = 2.0;
+// or only the heights on the GPU, without the X and Y distortion
+static Heightmap *_heightmap;
+static GLuint _heightShader;
+static unsigned char _useHeightmap = 0;
+static unsigned char _meshStale = 0;  // craters were dug since the patches were built
+
 void drawLandscape(){
-	glPushMatrix();
-		glEnableClientState(GL_COLOR_ARRAY);
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_NORMAL_ARRAY);
-		glColorPointer(3, GL_FLOAT, 0, _colors);
-		glVertexPointer(3, GL_FLOAT, 0, _points);
-		glNormalPointer(GL_FLOAT, 0, _normals);
-		// glDrawArrays(GL_POINTS, 0, _numPoints);
-		glDrawElements(GL_TRIANGLES, _numIndices, GL_UNSIGNED_INT, _indices);
-		glDisableClientState(GL_NORMAL_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
-		glDisableClientState(GL_COLOR_ARRAY);
-	glPopMatrix();
+	if(_useHeightmap){
+		drawHeightmap(_heightmap, _heightShader);
+		return;
+	}
+	_landscape->pixelError = _pixelError;
+	drawGridLOD(_landscape);
+}
+
+// positions, smooth normals and triangle strips in one pass, then the patches.
+// their errors depend on the heights, the levels are measured again
+void buildLandscape(){
+	buildGrid(&_grid);
+	_numPoints = _grid.numVertices;
+	freeGridLOD(_landscape);
+	_landscape = buildGridLOD(&_grid, _colors, 32);
+	_meshStale = 0;
+}
+
+// dig a crater under the camera, only the changed square of the texture is sent.
+// the mesh catches up when it's shown again
+void digCrater(int w, int h){
+	int radius = 40;
+	for(int y = max(h - radius, 0); y < min(h + radius, LAND_HEIGHT); y++){
+		for(int x = max(w - radius, 0); x < min(w + radius, LAND_WIDTH); x++){
+			float d = sqrtf((x-w)*(x-w) + (y-h)*(y-h)) / radius;
+			if(d < 1.0){ _heights[y*LAND_WIDTH+x] -= (1.0 - d*d) * 0.5; }
+		}
+	}
+	updateHeightmap(_heightmap, w - radius, h - radius, radius*2, radius*2, _heights);
+	_meshStale = 1;
 }
 
 void setup(){ 
-	_points = (float*)malloc(sizeof(float) * LAND_WIDTH*LAND_HEIGHT * 3);
-	_normals = (float*)malloc(sizeof(float) * LAND_WIDTH*LAND_HEIGHT * 3);
-	_indices = (uint32_t*)malloc(sizeof(uint32_t) * 2*(LAND_WIDTH-1)*(LAND_HEIGHT-1) * 3);
+	_heights = (float*)malloc(sizeof(float) * LAND_WIDTH*LAND_HEIGHT);
+	_offsets = (float*)malloc(sizeof(float) * LAND_WIDTH*LAND_HEIGHT * 2);
 	_colors = (float*)malloc(sizeof(float) * LAND_WIDTH*LAND_HEIGHT * 3);
+	_grid.columns = LAND_WIDTH;
+	_grid.rows = LAND_HEIGHT;
+	_grid.spacing = 0.1;
+	_grid.heights = _heights;
+	_grid.offsets = _offsets;
+	_grid.strips = 1;
+	_heightShader = loadShader("../examples/shaders/heightmap.vert", "../examples/shaders/heightmap.frag");
+	setShaderUniform1f(_heightShader, "u_zscale", ZSCALE);
 	buildWorld();
 	SETTINGS = SET_MOUSE_LOOK | SET_KEYBOARD_MOVE | SET_KEYBOARD_FUNCTIONS;
 
@@ -71,7 +112,7 @@ void update(){
 	float target = ORIGIN[2];
 	if(_numPoints > h*LAND_WIDTH+w){
 		if(PERSPECTIVE == FPP){
-			target = _points[(h*LAND_WIDTH+w)*3+2];
+			target = _heights[h*LAND_WIDTH+w];
 		}
 	}
 	ORIGIN[2] = ORIGIN[2]*0.5 + target*0.5;
@@ -79,9 +120,29 @@ void update(){
 void draw3D(){ 
 	drawLandscape();
 }
-void draw2D(){ }
+void draw2D(){
+	char line[96];
+	glDisable(GL_LIGHTING);
+	glColor4f(1.0, 1.0, 1.0, 1.0);
+	if(_useHeightmap){
+		sprintf(line, "heightmap: %.1f MB on the GPU  (H: mesh, C: dig a crater)", _heightmap->memoryUsed / 1048576.0);
+	} else{
+		sprintf(line, "%u triangles in %u patches, error %g pixels  ([ ] to change, H: heightmap)", _landscape->trianglesDrawn, _landscape->patchesDrawn, _pixelError);
+	}
+	text(line, 10, 20, 0);
+	glEnable(GL_LIGHTING);
+}
 void keyDown(unsigned int key){ 
 	if(key == ' ') buildWorld();
+	if(key == '[') _pixelError = max(_pixelError * 0.5, 0.25);
+	if(key == ']') _pixelError = min(_pixelError * 2.0, 64);
+	if(key == 'h' || key == 'H'){
+		_useHeightmap = !_useHeightmap;
+		if(!_useHeightmap && _meshStale) buildLandscape();
+	}
+	if((key == 'c' || key == 'C') && _useHeightmap){
+		digCrater(ORIGIN[0] * 10 + LAND_WIDTH*.5, ORIGIN[1] * 10 + LAND_HEIGHT*.5);
+	}
 }
 void keyUp(unsigned int key){ }
 void mouseDown(unsigned int button){ }
@@ -89,77 +150,23 @@ void mouseUp(unsigned int button){ }
 void mouseMoved(int x, int y){ }
 
 void buildWorld(){
-	#define START_FREQ .002
-	float freq = START_FREQ;
-
-	// reset data
-	memset(_points, 0, sizeof(float)*LAND_HEIGHT*LAND_WIDTH*3);
-	// set X Y to the grid
-	for(int h = 0; h < LAND_HEIGHT; h++){
-		for(int w = 0; w < LAND_WIDTH; w++){
-			_points[(h*LAND_WIDTH+w)*3+0] = (w - LAND_WIDTH*.5) * .1;    // x
-			_points[(h*LAND_WIDTH+w)*3+1] = (h - LAND_HEIGHT*.5) * .1;   // y
-		}
-	}
-
-	for(int loop = 0; loop < 20; loop++){
-		freq *= 2;
-		float RX = rand()%1000/500.0 - 1.0;
-		float RY = rand()%1000/500.0 - 1.0;
-		for(int h = 0; h < LAND_HEIGHT; h++){
-			for(int w = 0; w < LAND_WIDTH; w++){
-				float vec[2] = {w*freq + RX, h*freq + RY};
-				_points[(h*LAND_WIDTH+w)*3+2] += noise2(vec) * 1.5*ZSCALE/(freq/START_FREQ);
-			}
-		}
-	}
+	// every octave is summed per sample in one pass, rows split across threads
+	unsigned int seed = rand();
+	FractalNoise land = {20, .004, .75*ZSCALE, 2.0, 0.5, seed};
+	fbmGrid(&land, _heights, LAND_WIDTH, LAND_HEIGHT, 0, 0, 1, 1, 0);
 
-// these next 2 blocks distort along X and Y,
+// these next 2 fields distort along X and Y,
 // potential to make the land non-continuous, may create bad geometry
 	//////////////////////////////////////////////////////
-	freq = START_FREQ*.5;
-	for(int loop = 0; loop < 4; loop++){
-		freq *= 2;
-		float RX = rand()%1000/500.0 - 1.0;
-		float RY = rand()%1000/500.0 - 1.0;
-		for(int h = 0; h < LAND_HEIGHT; h++){
-			for(int w = 0; w < LAND_WIDTH; w++){
-				float vec[2] = {w*freq + RX, h*freq + RY};
-				_points[(h*LAND_WIDTH+w)*3+0] += noise2(vec) * 1.5*ZSCALE/(freq/START_FREQ*12);
-			}
-		}
-	}
-	freq = START_FREQ*.5;
-	for(int loop = 0; loop < 4; loop++){
-		freq *= 2;
-		float RX = rand()%1000/500.0 - 1.0;
-		float RY = rand()%1000/500.0 - 1.0;
-		for(int h = 0; h < LAND_HEIGHT; h++){
-			for(int w = 0; w < LAND_WIDTH; w++){
-				float vec[2] = {w*freq + RX, h*freq + RY};
-				_points[(h*LAND_WIDTH+w)*3+1] += noise2(vec) * 1.5*ZSCALE/(freq/START_FREQ*12);
-			}
-		}
-	}
-	
-	/////////////////////////////////////////////////////////
-	// inside INDICES, (WIDTH-1) and (HEIGHT-1) are max
-	// inside POINTS, WIDTH and HEIGHT are max
-	for(int h = 0; h < LAND_HEIGHT-1; h++){
-		for(int w = 0; w < LAND_WIDTH-1; w++){
-			_indices[(h*(LAND_WIDTH-1)+w)*6+0] = 1*(h*LAND_WIDTH+w);
-			_indices[(h*(LAND_WIDTH-1)+w)*6+1] = 1*((h+1)*LAND_WIDTH+w);
-			_indices[(h*(LAND_WIDTH-1)+w)*6+2] = 1*(h*LAND_WIDTH+w+1);
-			_indices[(h*(LAND_WIDTH-1)+w)*6+3] = 1*((h+1)*LAND_WIDTH+w);
-			_indices[(h*(LAND_WIDTH-1)+w)*6+4] = 1*((h+1)*LAND_WIDTH+w+1);
-			_indices[(h*(LAND_WIDTH-1)+w)*6+5] = 1*(h*LAND_WIDTH+w+1);
-		}
-	}
+	FractalNoise distort = {4, .002, 1.5*ZSCALE/12, 2.0, 0.5, seed+1};
+	fbmGrid(&distort, &_offsets[0], LAND_WIDTH, LAND_HEIGHT, 0, 0, 1, 2, 0);
+	distort.seed = seed+2;
+	fbmGrid(&distort, &_offsets[1], LAND_WIDTH, LAND_HEIGHT, 0, 0, 1, 2, 0);
 
-	// GENERATE COLORS
+	// GENERATE COLORS, CROP OCEAN
 	for(int i = 0; i < LAND_WIDTH*LAND_HEIGHT; i++){
 		// float RANDOM_WATER_LEVEL = rand()%100/500.0;
-		float scale = (.5*ZSCALE + _points[i*3+2]) / ZSCALE;// - RANDOM_WATER_LEVEL;
+		float scale = (.5*ZSCALE + _heights[i]) / ZSCALE;// - RANDOM_WATER_LEVEL;
 		if(scale < 0.0) scale = 0.0;
 		if(scale > 1.0) scale = 1.0;
 
@@ -195,30 +202,13 @@ void buildWorld(){
 			_colors[i*3+1] = 0.5f - 0.2f*dark;
 			_colors[i*3+2] = 0.0f;
 		}
-	}
-
-	// crop ocean
-	for(int i = 0; i < LAND_WIDTH * LAND_HEIGHT; i++){
-		if(_points[i*3+2] < -.33 * ZSCALE*.5){
-			_points[i*3+2] = -.33 * ZSCALE*.5;
-		}
-	}
-
-	// generate normals
-	for(int h = 0; h < LAND_HEIGHT; h++){
-		for(int w = 0; w < LAND_WIDTH; w++){
-			int i =        ((h)*LAND_WIDTH+(w))*3;
-			int nextOver = ((h)*LAND_WIDTH+(w+1))*3;
-			int downOne =  ((h+1)*LAND_WIDTH+(w))*3;
-			if(w == LAND_WIDTH-1)  nextOver = ((h)*LAND_WIDTH+(w-1))*3;
-			if(h == LAND_HEIGHT-1) downOne =  ((h-1)*LAND_WIDTH+(w))*3;
-			float a[3] = {_points[nextOver+0]-_points[i+0], _points[nextOver+1]-_points[i+1], _points[nextOver+2]-_points[i+2]};
-			float b[3] = {_points[downOne+0]-_points[i+0], _points[downOne+1]-_points[i+1], _points[downOne+2]-_points[i+2]};
-			vec3Cross(a, b, &_normals[i]);
-			vec3Normalize(&_normals[i]);
+		// crop ocean
+		if(_heights[i] < -.33 * ZSCALE*.5){
+			_heights[i] = -.33 * ZSCALE*.5;
 		}
 	}
 
-	_numPoints = LAND_HEIGHT * LAND_WIDTH;
-	_numIndices = 2*(LAND_WIDTH-1)*(LAND_HEIGHT-1)*3;
+	buildLandscape();
+	if(_heightmap == NULL){ _heightmap = createHeightmap(LAND_WIDTH, LAND_HEIGHT, _grid.spacing, _heights); }
+	else{ updateHeightmap(_heightmap, 0, 0, LAND_WIDTH, LAND_HEIGHT, _heights); }
 }
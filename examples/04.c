@@ -10,13 +10,19 @@ typedef struct{
 	float scale;  //  1 to 4
 	int randInt;  // 0 maxInt
 	float zFighting;  // 0 and .1
+	int batched;  // index in the static batch, -1 if it animates
 }worldObjects;
 
 GLuint texture;
 
-const int OBJ_DIST = 200;
-const int NUM_OBJ = 200;
-const int NUM_BLDG = 200;
+#define OBJ_DIST 200
+#define NUM_OBJ 200
+#define NUM_BLDG 200
+
+// everything that doesn't animate is baked into a few meshes
+StaticBatch *buildingBatch;
+StaticBatch *objectBatch;
+StaticBatch *shadowBatch;
 
 worldObjects obj[NUM_OBJ];
 worldObjects building[NUM_BLDG];
@@ -40,6 +46,54 @@ void drawDotsPlane(int dotRows){
 	}
 }
 
+void buildingTransform(int i, float *m){
+	makeMat4TranslateScale(m, building[i].x, building[i].y, building[i].scale*0.5, 7.0, building[i].zFighting, building[i].scale);
+}
+void objectTransform(int i, float *m){
+	makeMat4TranslateScale(m, obj[i].x, obj[i].y, obj[i].z, obj[i].scale, obj[i].scale, obj[i].scale);
+}
+// a square on the ground under the object, turned 45 degrees per polyNum
+void shadowTransform(int i, float *m){
+	float sc = obj[i].scale*1.414;
+	float c = cosf(45 * obj[i].polyNum * D2R) * sc;
+	float s = sinf(45 * obj[i].polyNum * D2R) * sc;
+	setMat4Identity(m);
+	m[0] = c;  m[1] = s;
+	m[4] = -s; m[5] = c;
+	m[12] = obj[i].x - (c - s)*0.5;
+	m[13] = obj[i].y - (s + c)*0.5;
+	m[14] = 0.01 + obj[i].zFighting;
+}
+void buildBatches(){
+	BatchObject list[NUM_OBJ + NUM_BLDG];
+	memset(list, 0, sizeof(list));
+	for(int i = 0; i < NUM_BLDG; i++){
+		list[i].primitive = BATCH_HEXAHEDRON;
+		buildingTransform(i, list[i].transform);
+	}
+	buildingBatch = buildStaticBatch(list, NUM_BLDG);
+
+	memset(list, 0, sizeof(list));
+	int count = 0;
+	for(int i = 0; i < NUM_OBJ; i++){
+		obj[i].batched = -1;
+		if(obj[i].polyNum == 2){ continue; }  // the cubes bob up and down
+		obj[i].batched = count;
+		list[count].primitive = obj[i].polyNum;
+		objectTransform(i, list[count].transform);
+		count++;
+	}
+	objectBatch = buildStaticBatch(list, count);
+
+	memset(list, 0, sizeof(list));
+	for(int i = 0; i < NUM_OBJ; i++){
+		list[i].primitive = BATCH_SQUARE;
+		list[i].color[3] = 0.2;
+		shadowTransform(i, list[i].transform);
+	}
+	shadowBatch = buildStaticBatch(list, NUM_OBJ);
+}
+
 void setup(){
 	texture = loadTexture("../examples/data/noise32.raw", 32, 32);
 
@@ -87,6 +141,8 @@ void setup(){
 	GLfloat ambient_position[] = { 0.0, 0.0, 100.0 };
 	glLightfv(GL_LIGHT1, GL_AMBIENT, white);
 	glLightfv(GL_LIGHT1, GL_POSITION, ambient_position);
+
+	buildBatches();
 }
 void update(){
 	float lfo0p5 = 0.5 + 0.2 * cos(ELAPSED*0.2);
@@ -101,6 +157,13 @@ void update(){
 				obj[i].y = random()%OBJ_DIST-(OBJ_DIST*0.5);
 				obj[i].z = random()%10 + 1;
 			}while(fabs(obj[i].y) < 4.0);
+			float m[16];
+			if(obj[i].batched != -1){
+				objectTransform(i, m);
+				setStaticBatchTransform(objectBatch, obj[i].batched, m);
+			}
+			shadowTransform(i, m);
+			setStaticBatchTransform(shadowBatch, i, m);
 		};
 	}
 	for(int i = 0; i < NUM_BLDG; i++){
@@ -109,6 +172,9 @@ void update(){
 				building[i].x = ORIGIN[0] + OBJ_DIST*0.25 + random()%OBJ_DIST; 
 				building[i].y = random()%OBJ_DIST-(OBJ_DIST*0.5);
 			}while(fabs(building[i].y) < 8.0);
+			float m[16];
+			buildingTransform(i, m);
+			setStaticBatchTransform(buildingBatch, i, m);
 		};
 	}
 }
@@ -150,55 +216,34 @@ void draw3D(){
 	glMaterialfv(GL_FRONT, GL_AMBIENT, white);
 
 	glEnable(GL_LIGHTING);
-	for(int i = 0; i < NUM_BLDG; i++){
-		glPushMatrix();
-			// buildings
-			glTranslatef(-ORIGIN[0], -ORIGIN[1], -ORIGIN[2]);
-			glTranslatef(building[i].x, building[i].y, building[i].scale*0.5);
-			glPushMatrix();
-				glScalef(7.0, building[i].zFighting, building[i].scale);
-				drawPlatonicSolidFaces( building[i].polyNum );
-			glPopMatrix();
-		glPopMatrix();
-	}
-
-	for(int i = 0; i < NUM_OBJ; i++){
-		glPushMatrix();
-			// objects
-
-		glEnable(GL_LIGHTING);
-
-			glTranslatef(-ORIGIN[0], -ORIGIN[1], -ORIGIN[2]);
-			glTranslatef(obj[i].x, obj[i].y, obj[i].z);
+	glPushMatrix();
+		glTranslatef(-ORIGIN[0], -ORIGIN[1], -ORIGIN[2]);
+		// buildings
+		drawStaticBatch(buildingBatch);
+		// objects
+		glShadeModel(GL_FLAT);
+		drawStaticBatch(objectBatch);
+		glShadeModel(GL_SMOOTH);
+		for(int i = 0; i < NUM_OBJ; i++){
+			if(obj[i].batched != -1){ continue; }
 			glPushMatrix();
+				glTranslatef(obj[i].x, obj[i].y, obj[i].z);
 				// make the cubes move up and down
-				if(obj[i].polyNum == 2){
-					glTranslatef(0, 0, obj[i].z);
-					float zPos = 0;
-					int intSec = ELAPSED;
-					if((intSec+obj[i].randInt)%7 == 0) zPos = (-cosf((ELAPSED-intSec)*M_PI)+1)*0.5;
-					if((intSec+obj[i].randInt)%7 == 1) zPos = 1.0;
-					if((intSec+obj[i].randInt)%7 == 2) zPos = 1.0 - ((-cosf((ELAPSED-intSec)*M_PI)+1)*0.5);
-					glTranslatef(0, 0, -zPos * obj[i].z * 2);
-					glShadeModel(GL_SMOOTH);
-				} else{
-					glShadeModel(GL_FLAT); //GL_SMOOTH);
-				}
+				glTranslatef(0, 0, obj[i].z);
+				float zPos = 0;
+				int intSec = ELAPSED;
+				if((intSec+obj[i].randInt)%7 == 0) zPos = (-cosf((ELAPSED-intSec)*M_PI)+1)*0.5;
+				if((intSec+obj[i].randInt)%7 == 1) zPos = 1.0;
+				if((intSec+obj[i].randInt)%7 == 2) zPos = 1.0 - ((-cosf((ELAPSED-intSec)*M_PI)+1)*0.5);
+				glTranslatef(0, 0, -zPos * obj[i].z * 2);
 				glScalef(obj[i].scale, obj[i].scale, obj[i].scale);
 				drawPlatonicSolidFaces( obj[i].polyNum );
 			glPopMatrix();
-			glShadeModel(GL_SMOOTH);
-			// object shadows
-
-			glDisable(GL_LIGHTING);
-			glPushMatrix();
-				glColor4f(0.0, 0.0, 0.0, 0.2);
-				glRotatef(45 * obj[i].polyNum,0,0,1);
-				float sc = obj[i].scale*1.414;
-				drawRect(-sc*0.5, -sc*0.5, -obj[i].z + 0.01 + obj[i].zFighting, sc, sc);
-			glPopMatrix();
-		glPopMatrix();
-	}
+		}
+		// object shadows
+		glDisable(GL_LIGHTING);
+		drawStaticBatch(shadowBatch);
+	glPopMatrix();
 	// my shadow
 	glPushMatrix();
 		glColor4f(0.0, 0.0, 0.0, 0.2);
@@ -4,22 +4,11 @@
 // geocentric astronomy model
 
 #include "../world.h"
-#include "../examples/data/518stars.c"
-#include "../examples/data/1619stars.c"
+
+StarCatalog *stars;  // 1619 stars, the 518 brightest at magnitude 3
 
 void renderStars(){
-	glPushMatrix();
-		glEnableClientState(GL_VERTEX_ARRAY);
-		// bright stars
-		glVertexPointer(3, GL_FLOAT, 0, _518_stars);
-		glColor3f(1.0, 1.0, 1.0);
-		glDrawArrays(GL_POINTS, 0, 518);
-		// dim stars
-		glVertexPointer(3, GL_FLOAT, 0, _1619_stars);
-		glColor3f(0.5, 0.5, 0.5);
-		glDrawArrays(GL_POINTS, 0, 1619);
-		glDisableClientState(GL_VERTEX_ARRAY);
-	glPopMatrix();
+	drawStarCatalog(stars);
 }
 
 // Matrix B, in the book
@@ -146,6 +135,7 @@ void drawUnitCubeLabels(){
 }
 
 void setup() {
+	stars = loadStarCatalog("../examples/data/stars.bin");
 	HANDED = RIGHT;
 	noFill();
 	// glutReshapeWindow(400, 400);
@@ -1,91 +1,6 @@
 
 #include "../world.h"
-#include "../examples/data/518stars.c"
-#include "../examples/data/1619stars.c"
-
-double KeplersEquation(double E, double M, double e){
-	double deltaM = M - ( E - (e*180.0/M_PI) * sin(E*M_PI/180.0) );
-	double deltaE = deltaM / (1.0 - e*cos(E*M_PI/180.0));
-	return E + deltaE;
-}
-void calculateLocationOfPlanet(int planet, double time, double *planet_x, double *planet_y, double *planet_z){
-//                          a           e           I           L           w         omega 
-//                         AU          rad         deg         deg         deg         deg
-static double elm[]={0.38709927, 0.20563593, 7.00497902,252.25032350, 77.45779628, 48.33076593,
-                     0.72333566, 0.00677672, 3.39467605,181.97909950,131.60246718, 76.67984255,
-                     1.00000261, 0.01671123,-0.00001531,100.46457166,102.93768193,  0.0,
-                     1.52371034, 0.09339410, 1.84969142, -4.55343205,-23.94362959, 49.55953891,
-                     5.20288700, 0.04838624, 1.30439695, 34.39644051, 14.72847983,100.47390909,
-                     9.53667594, 0.05386179, 2.48599187, 49.95424423, 92.59887831,113.66242448,
-                     19.18916464,0.04725744, 0.77263783,313.23810451,170.95427630, 74.01692503,
-                     30.06992276,0.00859048, 1.77004347,-55.12002969, 44.96476227,131.78422574,
-                     39.48211675,0.24882730,17.14001206,238.92903833,224.06891629,110.30393684 };
-//                         AU/Cy       rad/Cy      deg/Cy      deg/Cy         deg/Cy     deg/Cy
-static double rate[]={0.00000037, 0.00001906,-0.00594749,149472.67411175, 0.16047689,-0.12534081,
-                      0.00000390,-0.00004107,-0.00078890, 58517.81538729, 0.00268329,-0.27769418,
-                      0.00000562,-0.00004392,-0.01294668, 35999.37244981, 0.32327364, 0.0,
-                      0.00001847, 0.00007882,-0.00813131, 19140.30268499, 0.44441088,-0.29257343,
-                     -0.00011607,-0.00013253,-0.00183714,  3034.74612775, 0.21252668, 0.20469106,
-                     -0.00125060,-0.00050991, 0.00193609,  1222.49362201,-0.41897216,-0.28867794,
-                     -0.00196176,-0.00004397,-0.00242939,   428.48202785, 0.40805281, 0.04240589,
-                      0.00026291, 0.00005105, 0.00035372,   218.45945325,-0.32241464,-0.00508664,
-                     -0.00031596, 0.00005170, 0.00004818,   145.20780515,-0.04062942,-0.01183482 };
-	double a = elm[6*planet+0] + rate[6*planet+0]*time;	// (au) semi_major_axis
-	double e = elm[6*planet+1] + rate[6*planet+1]*time;	//  ( ) eccentricity
-	double I = elm[6*planet+2] + rate[6*planet+2]*time;	//  (°) inclination
-	double L = elm[6*planet+3] + rate[6*planet+3]*time;	//  (°) mean_longitude
-	double omega_bar = elm[6*planet+4] + rate[6*planet+4]*time;	//  (°) longitude_of_periapsis
-	double OMEGA = elm[6*planet+5] + rate[6*planet+5]*time;	//  (°) longitude_of_the_ascending_node
-	double omega = omega_bar - OMEGA;
-	double M = L - omega_bar;
-	while(M > 180) M-=360;  // in degrees
-	double E = M + (e*180.0/M_PI) * sin(M*M_PI/180.0);  // E0
-	for(int i = 0; i < 5; i++){
-		E = KeplersEquation(E, M, e);
-	}
-	omega = omega * M_PI/180.0;
-	E = E * M_PI/180.0;
-	I = I * M_PI/180.0;
-	OMEGA = OMEGA * M_PI/180.0;
-	double x0 = a*(cos(E)-e);
-	double y0 = a*sqrt((1.0-e*e))*sin(E);
-	*planet_x = ( cos(omega)*cos(OMEGA) - sin(omega)*sin(OMEGA)*cos(I) )*x0 + ( -sin(omega)*cos(OMEGA) - cos(omega)*sin(OMEGA)*cos(I) )*y0;
-	*planet_y = ( cos(omega)*sin(OMEGA) + sin(omega)*cos(OMEGA)*cos(I) )*x0 + ( -sin(omega)*sin(OMEGA) + cos(omega)*cos(OMEGA)*cos(I) )*y0;
-	*planet_z = (            sin(omega)*sin(I)                         )*x0 + (                          cos(omega)*sin(I)            )*y0;
-}
-void calculateLocationOfMoon(double time, double *moon_x, double *moon_y, double *moon_z){
-	//    a             e      w      M      i       node       n         P      Pw     Pnode     Ref.
-	//  (km)                 (deg)   (deg)  (deg)    (deg)   (deg/day)  (days)   (yr)    (yr)
-	// 384400.     0.0554   318.15   135.27   5.16   125.08   13.176358   27.322   5.997   18.600   1
-	// moon calculation http://njsas.org/projects/tidal_forces/altaz/pausch/ppcomp.html#6
-
-	// i dunno why. sorry.
-	// time = time + 1.42;
-	// time = time + M_PI*0.5;
-	// time = time + 1.5;
-	time = time + 1.6666666;
-
-	double N = (125.1228 - 0.0529538083 * time) / 180.0 * M_PI;
-	double i = 5.1454 / 180.0 * M_PI;
-	double w = (318.0634 + 0.1643573223 * time) / 180.0 * M_PI;
-	double e = 0.054900; //eccentricity
-	double M = (115.3654 + 13.0649929509 * time) / 180.0 * M_PI ; //mean anomaly
-	double E = M + e * sin(M) * ( 1.0 + e * cos(M) );
-	// for(int i = 0; i < 5; i++){
-	// 	E = E - ( E - e * sin(E) - M ) / ( 1 - e * cos(E) );
-	// }
-	// double a = 60.2666; // earth radius
-	// double a = 385000; // km
-	double a = 0.00257356604; // au
-	double xv = a * ( cos(E) - e );
-	double yv = a * ( sqrt(1.0 - e*e) * sin(E) );
-	double v = atan2(yv, xv);
-	double r = sqrt(xv*xv + yv*yv);
-	*moon_x = r * ( cos(N) * cos(v+w) - sin(N) * sin(v+w) * cos(i) );
-	*moon_y = r * ( sin(N) * cos(v+w) + cos(N) * sin(v+w) * cos(i) );
-	*moon_z = r * ( sin(v+w) * sin(i) );
-}
-
+#include "ephemeris.c"
 
 typedef enum { user, follow } ModeState;
 ModeState MODE = user;
@@ -131,6 +46,9 @@ int second = 0;
 float universeScale = 10;
 float coordinateScale = 500;
 
+// 1800 to 2050, the range the clock wraps around in
+Ephemeris *ephemeris;
+
 // heliocentric coordinates
 double planets[9][3];
 double moonPosition[3];
@@ -163,6 +81,8 @@ static float lastAngle;
 
 GLuint dot;
 GLuint constellationTexture = 0;
+StarCatalog *stars;  // 1619 stars, the 518 brightest at magnitude 3
+Skybox *background;  // the stars and celestial sphere
 GLuint planetTextures[9];
 GLuint moonTexture;
 
@@ -214,62 +134,127 @@ void setupLights(){
 void renderStars(){
 	glPushMatrix();
 		glRotatef(-23.4, 1, 0, 0);
-		glEnableClientState(GL_VERTEX_ARRAY);
-		// bright stars
-		glVertexPointer(3, GL_FLOAT, 0, _518_stars);
-		glColor3f(1.0, 1.0, 1.0);
-		glDrawArrays(GL_POINTS, 0, 518);
-		// dim stars
-		glVertexPointer(3, GL_FLOAT, 0, _1619_stars);
-		glColor3f(0.5, 0.5, 0.5);
-		glDrawArrays(GL_POINTS, 0, 1619);
-		glDisableClientState(GL_VERTEX_ARRAY);
+		drawStarCatalog(stars);
 	glPopMatrix();
 }
 
-void drawPlanet(int planetNumber, float x, float y, float z){
-	static float PLANET_SCALE = 0.0015;
+// 12 zodiac divisions, celestial sphere and fades, radius 1
+void renderCelestialSphere(){
+	noFill();
+	glLineWidth(2);
+	// glColor4f(0.6, 0.06, 0.06, 1.0);  // red
+	glColor4f(1.0, 1.0, 1.0, 0.1);
+	glPushMatrix();
+		glRotatef(90,1,0,0);
+		for(int i = 0; i < 12; i++){
+			drawCircle(0,0,0,1);
+			glRotatef(30,0,1,0);
+		}
+	glPopMatrix();
+	glLineWidth(1);
+
+	// earth celestial sphere
+	// glColor4f(.04, .07, .3, 1.0); // blue
+	glColor4f(1.0, 1.0, 1.0, 0.07);
+	glPushMatrix();
+		glRotatef(-23.4,1,0,0);
+		drawCircle(0,0,0,1);
+		drawSphere(0,0,0,1);
+	glPopMatrix();
+
+	// upper and lower black fades
+	glDisable(GL_CULL_FACE);
+	fill();
+	glColor4f(0.0, 0.0, 0.0, 0.2);
+	float NUM_DARK_PANELS = 7.0;
+	glPushMatrix();
+		for(int i = NUM_DARK_PANELS; i >= 0; i--){
+			float z1 =  0.5 + 0.5/NUM_DARK_PANELS*i;  // 0 to 1
+			float z2 = -0.5 - 0.5/NUM_DARK_PANELS*i;  // 0 to 1
+			// float r1 = sin((1-z1)*M_PI*0.5);
+			// float r2 = sin((-1-z2)*M_PI*0.5);
+			float r1 = sqrt(1-powf(z1,2));
+			float r2 = sqrt(1-powf(z2,2));
+			glPushMatrix();
+				glScalef(r1, r1, 1);
+				drawUnitCircle(0,0, z1);
+			glPopMatrix();
+			glPushMatrix();
+				glScalef(r1, r1, 1);
+				drawUnitCircle(0,0, z2);
+			glPopMatrix();
+		}
+	glPopMatrix();
+	noFill();
+}
+
+// everything far away, seen from the middle. the earth's offset from the sun is
+// lost at this distance, so the sphere is centered on the camera instead
+void renderBackground(void *context){
+	glDisable(GL_LIGHTING);
+	glPushMatrix();
+		glScalef(universeScale * 100, universeScale * 100, universeScale * 100);
+		renderStars();
+	glPopMatrix();
+	if(showCoordinates){
+		glPushMatrix();
+			glScalef(coordinateScale, coordinateScale, coordinateScale);
+			renderCelestialSphere();
+		glPopMatrix();
+	}
+}
+
+// planets and the moon go through the render queue, which binds each texture
+static int planetIndex[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+static float PLANET_SCALE = 0.0015;
+void renderPlanet(void *data){
+	int planetNumber = *(int*)data;
 	fill();
 	glColor4f(1.0, 1.0, 1.0, 1.0);
-	glBindTexture(GL_TEXTURE_2D, planetTextures[planetNumber]);
+	drawSphere(0, 0, 0, sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE );
+	// saturns rings
+	if(planetNumber == 5){
+		glBindTexture(GL_TEXTURE_2D, 0);
+		noFill();
+		glDisable(GL_LIGHTING);
+		float r1 = sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE * 1.3;
+		float r1_2 = sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE * 1.9;
+		float r2 = sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE * 2.2;
+		glColor4f(0.13, 0.13, 0.13, 1.0);
+		for(int i = 0; i < 60; i++){
+			float rr = (i/60.0) * (r1_2-r1) + r1;
+			drawCircle(0, 0, 0, rr);
+		}
+		glColor4f(0.1, 0.1, 0.1, 1.0);
+		for(int i = 0; i < 15; i++){
+			float rr = (i/15.0) * (r2-r1_2) + r1_2;
+			drawCircle(0, 0, 0, rr);
+		}
+		glEnable(GL_LIGHTING);
+		glBindTexture(GL_TEXTURE_2D, planetTextures[planetNumber]);
+		fill();
+	}
+}
+void drawPlanet(int planetNumber, float x, float y, float z){
 	glPushMatrix();
 		glTranslatef(x, y, z);
 		glRotatef(j2000Days(year, month, day, hour, minute, second) * 360 * planetSiderealDays[planetNumber], 0, 0, 1);
-		drawSphere(0, 0, 0, sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE );
-		glBindTexture(GL_TEXTURE_2D, 0);
-		// saturns rings
-		if(planetNumber == 5){
-			noFill();
-			glDisable(GL_LIGHTING);
-			float r1 = sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE * 1.3;
-			float r1_2 = sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE * 1.9;
-			float r2 = sqrt(planetRadiuses[planetNumber]) * PLANET_SCALE * 2.2;
-			glColor4f(0.13, 0.13, 0.13, 1.0);
-			for(int i = 0; i < 60; i++){
-				float rr = (i/60.0) * (r1_2-r1) + r1;
-				drawCircle(0, 0, 0, rr);
-			}
-			glColor4f(0.1, 0.1, 0.1, 1.0);
-			for(int i = 0; i < 15; i++){
-				float rr = (i/15.0) * (r2-r1_2) + r1_2;
-				drawCircle(0, 0, 0, rr);
-			}
-			glEnable(GL_LIGHTING);
-		}
+		submitDraw(RENDER_OPAQUE, 0, planetTextures[planetNumber], renderPlanet, &planetIndex[planetNumber]);
 	glPopMatrix();
 }
-void drawMoon(){
+void renderMoon(void *data){
 	fill();
 	glColor4f(1.0, 1.0, 1.0, 1.0);
+	drawSphere(0, 0, 0, .05);
+}
+void drawMoon(){
 	glPushMatrix();
 		// translate to earth's center
 		glTranslatef(planets[2][0], planets[2][1], planets[2][2]);
 		// translate to moon position
 		glTranslatef(moonPosition[0]*70, moonPosition[1]*70, moonPosition[2]*70);
 		glRotatef(moonLongitude*180/M_PI - 90, 0, 0, 1);
-		glBindTexture(GL_TEXTURE_2D, moonTexture);
-		drawSphere(0, 0, 0, .05);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		submitDraw(RENDER_OPAQUE, 0, moonTexture, renderMoon, NULL);
 
 		// glDisable(GL_LIGHTING);
 		// if(moonPosition[2] < 0) { glColor4f(1.0, 0.1, 0.1, 1.0); }
@@ -280,8 +265,10 @@ void drawMoon(){
 	glPopMatrix();
 }
 
-
 void setup(){
+	stars = loadStarCatalog("../examples/data/stars.bin");
+	background = createSkybox(512);
+	ephemeris = createEphemeris(j2000Days(1800, 1, 1, 0, 0, 0), j2000Days(2051, 1, 1, 0, 0, 0), 0);
 	dot = loadTexture("../examples/data/dot-black-on-white.raw", 64, 64);
 	// constellationTexture = loadTexture("../examples/data/constellations.raw", 1024, 512);
 	for(int i = 0; i < 8; i++){
@@ -381,69 +368,31 @@ void update(){
 		ZOOM_SPEED += 0.02;
 	}
 
-	double clockTime = j2000Centuries(year, month, day, hour, minute, second);
-
+	// looked up in the tables, as cheap at 50 days a frame as at 1 minute
+	EphemerisSky sky;
+	ephemerisSky(ephemeris, j2000Days(year, month, day, hour, minute, second), &sky);
+	memcpy(planets, sky.planets, sizeof(planets));
+	memcpy(moonPosition, sky.moon, sizeof(moonPosition));
+	memcpy(planetProjections, sky.direction, sizeof(planetProjections));
+	memcpy(moonProjection, sky.moonDirection, sizeof(moonProjection));
 	for(int i = 0; i < 9; i++){
-		calculateLocationOfPlanet(i, clockTime, &planets[i][0], &planets[i][1], &planets[i][2]);
-	}
-	// calculateLocationOfMoon(clockTime*36525.0+1.625, &moonPosition[0], &moonPosition[1], &moonPosition[2] );
-	calculateLocationOfMoon(clockTime*36525.0, &moonPosition[0], &moonPosition[1], &moonPosition[2] );
-
-	// planets
-	for(int i = 0; i < 9; i++){
-		if(i != 2){
-			float dX = planets[i][0] - planets[2][0];
-			float dY = planets[i][1] - planets[2][1];
-			float dZ = planets[i][2] - planets[2][2];
-			float mag = sqrt( powf(dX,2) + powf(dY,2) + powf(dZ,2) );
-			dX = dX / mag;
-			dY = dY / mag;
-			dZ = dZ / mag;
-			planetProjections[i][0] = dX;
-			planetProjections[i][1] = dY;
-			planetProjections[i][2] = dZ;
-			planetLongitude[i] = atan2(dY, dX);
-			planetLatitude[i] = M_PI*0.5 - acos( dZ );
-			if(planetLongitude[i] < 0) planetLongitude[i] += M_PI*2;
-			planetDistance[i] = mag;
-		}
-		else{
-			// this is earth. the distance of earth from earth
-			planetProjections[i][0] = 0.0;
-			planetProjections[i][1] = 0.0;
-			planetProjections[i][2] = 0.0;
-			planetLongitude[i] = 0.0;
-			planetDistance[i] = 0.0;
-		}
-	}
-	// moon
-	{
-		float dX = moonPosition[0];
-		float dY = moonPosition[1];
-		float dZ = moonPosition[2];
-		float mag = sqrt( powf(dX,2) + powf(dY,2) + powf(dZ,2) );
-		dX = dX / mag;
-		dY = dY / mag;
-		dZ = dZ / mag;
-		moonProjection[0] = dX;
-		moonProjection[1] = dY;
-		moonProjection[2] = dZ;
-		moonLongitude = atan2(dY, dX);
-		moonLatitude = M_PI*0.5 - acos(dZ );
-		if(moonLongitude < 0) moonLongitude += M_PI*2;
-		moonDistance = mag;
+		planetLongitude[i] = sky.longitude[i];
+		planetLatitude[i] = sky.latitude[i];
+		planetDistance[i] = sky.distance[i];
 	}
+	moonLongitude = sky.moonLongitude;
+	moonLatitude = sky.moonLatitude;
+	moonDistance = sky.moonDistance;
 	// sun
-	{
-		// float mag = sqrt( powf(planets[2][0],2) + powf(planets[2][1],2) + powf(planets[2][2],2) );
-		sunProjection[0] = -planets[2][0];
-		sunProjection[1] = -planets[2][1];
-		sunProjection[2] = -planets[2][2];
-		sunLongitude = atan2(-planets[2][1], -planets[2][0]);
-		// sunLatitude = acos(sunProjection[2] / sqrt( powf(sunProjection[0],2) + powf(sunProjection[1],2) + powf(sunProjection[2],2) ) );
-		if(sunLongitude < 0) sunLongitude += M_PI*2;
-		sunDistance = sqrt( powf(planets[2][0],2) + powf(planets[2][1],2) + powf(planets[2][2],2) );
-	}
+	sunProjection[0] = -planets[2][0];
+	sunProjection[1] = -planets[2][1];
+	sunProjection[2] = -planets[2][2];
+	sunLongitude = sky.sunLongitude;
+	sunDistance = sky.sunDistance;
+	zodiac = sky.zodiac;
+	// this is for new york latitude. ~40 N
+	daylightHours = sky.daylightHours;
+	moonPhase = sky.moonPhase;
 
 
 	if(MODE == follow){
@@ -453,15 +402,6 @@ void update(){
 		lastAngle = newAngle;
 	}
 
-	float sunLongitude = atan2(-planets[2][1], -planets[2][0]);
-	if(sunLongitude < 0){ sunLongitude += M_PI*2; }
-	zodiac = sunLongitude * 180 / M_PI / 30;
-
-	// this is for new york latitude. ~40 N
-	daylightHours = 9.25 + 2.92 + 2.92*sin(sunLongitude);
-	moonPhase = moonLongitude - sunLongitude;
-	if(moonPhase < 0) { moonPhase += M_PI*2; }
-
 	switch(clockSpeed){
 		case 0: day-=50; break;
 		case 1: day-=5; break;
@@ -563,13 +503,21 @@ void draw3D(){
 	// glBindTexture(GL_TEXTURE_2D, 0);
 	// noFill();
 
+	// the background only changes when coordinates are turned on or off
+	if(PERSPECTIVE != ORTHO){
+		bakeSkybox(background, showCoordinates, renderBackground, NULL);
+		drawSkybox(background);
+	}
+
 	glPushMatrix();
 	glScalef(universeScale, universeScale, universeScale);
 
-	glPushMatrix();
-		glScalef(100, 100, 100);
-		renderStars();
-	glPopMatrix();
+	if(PERSPECTIVE == ORTHO){
+		glPushMatrix();
+			glScalef(100, 100, 100);
+			renderStars();
+		glPopMatrix();
+	}
 	glColor4f(1.0, 1.0, 1.0, 1.0);
 
 	// sun
@@ -593,6 +541,8 @@ void draw3D(){
 	glPopMatrix();
 	// moon
 	drawMoon();
+	// the bodies are sorted by texture and distance, run them while lit
+	flushRenderQueue();
 
 	if(showPlanetLabels){
 		glDisable(GL_LIGHTING);
@@ -810,55 +760,7 @@ void draw3D(){
 		// 	drawCircle(0, 0, 0, powf(2,i));
 		// }
 
-		// 12 zodiac divisions
-		if(PERSPECTIVE != ORTHO){
-		glLineWidth(2);
-		// glColor4f(0.6, 0.06, 0.06, 1.0);  // red
-		glColor4f(1.0, 1.0, 1.0, 0.1);
-		glPushMatrix();
-			glRotatef(90,1,0,0);
-			for(int i = 0; i < 12; i++){
-				drawCircle(0,0,0,1);
-				glRotatef(30,0,1,0);
-			}
-		glPopMatrix();
-		glLineWidth(1);
-
-		// earth celestial sphere
-		// glColor4f(.04, .07, .3, 1.0); // blue
-		glColor4f(1.0, 1.0, 1.0, 0.07);
-		glPushMatrix();
-			glRotatef(-23.4,1,0,0);
-			drawCircle(0,0,0,1);
-			drawSphere(0,0,0,1);
-		glPopMatrix();
-
-		// upper and lower black fades
-		glDisable(GL_CULL_FACE);
-		fill();
-		glColor4f(0.0, 0.0, 0.0, 0.2);
-		float NUM_DARK_PANELS = 7.0;
-		glPushMatrix();
-			for(int i = NUM_DARK_PANELS; i >= 0; i--){
-				float z1 =  0.5 + 0.5/NUM_DARK_PANELS*i;  // 0 to 1
-				float z2 = -0.5 - 0.5/NUM_DARK_PANELS*i;  // 0 to 1
-				// float r1 = sin((1-z1)*M_PI*0.5);
-				// float r2 = sin((-1-z2)*M_PI*0.5);
-				float r1 = sqrt(1-powf(z1,2));
-				float r2 = sqrt(1-powf(z2,2));
-				glPushMatrix();
-					glScalef(r1, r1, 1);
-					drawUnitCircle(0,0, z1);
-				glPopMatrix();
-				glPushMatrix();
-					glScalef(r1, r1, 1);
-					drawUnitCircle(0,0, z2);
-				glPopMatrix();
-			}
-		glPopMatrix();
-		noFill();
-		}
-
+		// the zodiac divisions, celestial sphere and fades are in the background
 
 	glPopMatrix(); // coordinate matrix
 	}
@@ -72,6 +72,8 @@ RGB HSV2RGB(HSV in){
 	return out;     
 }
 
+static CommandList hsvGrid;
+
 void setup(){ 
 	SETTINGS = SET_MOUSE_LOOK | SET_KEYBOARD_MOVE | SET_KEYBOARD_FUNCTIONS;
 	HORIZON[2] = 50;
@@ -80,17 +82,22 @@ void setup(){
 }
 void update(){ }
 void draw3D(){
-	HSV groundHSV;
-	for(int i = 0; i < 100; i++){
-		for(int j = 0; j < 100; j++){
-			groundHSV.h = 360*j*0.01;
-			groundHSV.s = 1.0;
-			groundHSV.v = 1-i*0.01;
-			RGB ground = HSV2RGB(groundHSV);
-			glColor4f(ground.r, ground.g, ground.b, 1.0);
-			drawRect(-50 + i, -50 + j, 0, 1, 1);
+	// the grid never changes, record it once and replay it every frame
+	if(recordCommandList(&hsvGrid, 0)){
+		HSV groundHSV;
+		for(int i = 0; i < 100; i++){
+			for(int j = 0; j < 100; j++){
+				groundHSV.h = 360*j*0.01;
+				groundHSV.s = 1.0;
+				groundHSV.v = 1-i*0.01;
+				RGB ground = HSV2RGB(groundHSV);
+				glColor4f(ground.r, ground.g, ground.b, 1.0);
+				drawRect(-50 + i, -50 + j, 0, 1, 1);
+			}
 		}
+		endCommandList();
 	}
+	drawCommandList(&hsvGrid);
 }
 void draw2D(){ }
 void keyDown(unsigned int key){ }
@@ -12,8 +12,11 @@
 
 #include "../world.h"
 
-const unsigned int numPoly = 50;
+#define numPoly 50
 float poly[numPoly * 3];
+// the icosahedra never move, each set is baked into one mesh
+StaticBatch *polyFaces;
+StaticBatch *polyOutlines;
 
 GLuint shader = 0;
 GLuint shader2 = 0;
@@ -64,6 +67,16 @@ void setup() {
 		poly[i*3+1] = random()%range - range*0.5;
 		poly[i*3+2] = random()%range - range*0.5;
 	}
+	BatchObject faces[numPoly], outlines[numPoly];
+	memset(faces, 0, sizeof(faces));
+	memset(outlines, 0, sizeof(outlines));
+	for(int i = 0; i < numPoly; i++){
+		faces[i].primitive = outlines[i].primitive = BATCH_ICOSAHEDRON;
+		makeMat4TranslateScale(faces[i].transform, poly[i*3+0], poly[i*3+1], poly[i*3+2], 1.0, 1.0, 1.0);
+		makeMat4TranslateScale(outlines[i].transform, poly[i*3+0], poly[i*3+1], poly[i*3+2], 1.005, 1.005, 1.005);
+	}
+	polyFaces = buildStaticBatch(faces, numPoly);
+	polyOutlines = buildStaticBatch(outlines, numPoly);
 }
 void update() {
 	if(FRAME%60 == 0){ 
@@ -100,24 +113,16 @@ void draw3D() {
 	glPopMatrix();
 
 	glUseProgram(shader);
-	for(int i = 0; i < numPoly; i++){
-		glPushMatrix();
-			glTranslatef(poly[i*3+0], poly[i*3+1], poly[i*3+2] );
-			drawPlatonicSolidFaces(3);
-		glPopMatrix();
-	}
+	drawStaticBatch(polyFaces);
 	glUseProgram(0);
 
 	// glColor4f(0.7, 0.7, 0.7, (-cos(ELAPSED)*0.5+0.5) );
 	glColor4f(0.15, 0.15, 0.15, 1.0);
 	glLineWidth(1.5);// + 6*(cos(ELAPSED)*0.5+0.5) );
-	for(int i = 0; i < numPoly; i++){
-		glPushMatrix();
-			glTranslatef(poly[i*3+0], poly[i*3+1], poly[i*3+2] );
-			glScalef(1.005, 1.005, 1.005);
-			drawPlatonicSolidLines(3);
-		glPopMatrix();
-	}
+	// the faces are triangles, so their wireframe is the icosahedron's edges
+	noFill();
+	drawStaticBatch(polyOutlines);
+	fill();
 	glLineWidth(1);
 }
 void draw2D() { }
@@ -1,116 +1,85 @@
-// example 7
+// example 11
 //
-// OpenGL lighting, 1000 particles
+// a million particles, falling through a box that follows the camera
 
 #include "../world.h"
 
-// polyhedra into particles
-typedef struct{
-	unsigned int type;  // 0-4 which platonic solid
-	float pos[3];
-	float vel[3];
-	float spin[3];
-	float scale;
-} Particle;
+#define NUM_PARTICLES 1000000
 
-// particles
-const unsigned int numPolyhedra = 1000;
-Particle poly[numPolyhedra];
+Particles *particles;
 // +/- X,Y,Z boundary for the particles
 static float BOUNDS[3] = {5.0, 5.0, 20.0};
 // move the center of the bounding box up in the z
-static float B_OFFSET[3] = {0.0, 0.0, 19.0};  
+static float B_OFFSET[3] = {0.0, 0.0, 19.0};
+// the colors of the lights that used to shine on them
+static float COLORS[4][4] = {
+	{1.0f, 1.0f, 1.0f, 1.0f},
+	{1.0f, 0.2f, 0.0f, 1.0f},
+	{0.3f, 0.9f, 0.3f, 1.0f},
+	{0.0f, 0.2f, 1.0f, 1.0f}
+};
+// a soft disc, cut out by the alpha test
+GLuint disc;
 
-void setupLighting(){
-	GLfloat white[] = {1.0f, 1.0f, 1.0f, 0.0f};
-	GLfloat red[] =   {1.0f, 0.2f, 0.0f, 0.0f};
-	GLfloat green[] = {0.3f, 0.9f, 0.3f, 0.0f};
-	GLfloat blue[] =  {0.0f, 0.2f, 1.0f, 0.0f};
-	GLfloat spot_direction[] = { 0.0, 0.0, -1.0 };
-	GLfloat light_position0[] = { 0.0, 0.0, 10.0, 1.0 };
-	GLfloat light_position1[] = { 8.0, 0.0, -5.0, 0.0 };
-	GLfloat light_position2[] = { 5.0, 5.0, 5.0, 0.0 };
-	GLfloat light_position3[] = { -5.0, 5.0, -5.0, 0.0 };
-	glLightfv(GL_LIGHT0, GL_DIFFUSE, white);
-	glLightfv(GL_LIGHT0, GL_SPECULAR, white);
-	glLightfv(GL_LIGHT0, GL_POSITION, light_position0);
-	glLightfv(GL_LIGHT0, GL_SPOT_DIRECTION, spot_direction);
-	glLightf(GL_LIGHT0, GL_SPOT_CUTOFF, 40.0);
-	glLightf(GL_LIGHT0, GL_SPOT_EXPONENT, 40.0);
-	glLightf(GL_LIGHT0, GL_CONSTANT_ATTENUATION, 1.0);
-
-	glLightfv(GL_LIGHT1, GL_DIFFUSE, red);
-	glLightfv(GL_LIGHT1, GL_SPECULAR, red);
-	glLightfv(GL_LIGHT1, GL_POSITION, light_position1);
-	glLightfv(GL_LIGHT2, GL_DIFFUSE, green);
-	glLightfv(GL_LIGHT2, GL_SPECULAR, green);
-	glLightfv(GL_LIGHT2, GL_POSITION, light_position2);
-	glLightfv(GL_LIGHT3, GL_DIFFUSE, blue);
-	glLightfv(GL_LIGHT3, GL_SPECULAR, blue);
-	glLightfv(GL_LIGHT3, GL_POSITION, light_position3);
-
-	glEnable(GL_LIGHTING);
+void makeDisc(){
+	unsigned char pixels[32*32*2];
+	for(int y = 0; y < 32; y++){
+		for(int x = 0; x < 32; x++){
+			float d = sqrtf((x-15.5)*(x-15.5) + (y-15.5)*(y-15.5)) / 16.0;
+			pixels[(y*32+x)*2+0] = 255 * max(0, 1.0 - d*d*0.5);
+			pixels[(y*32+x)*2+1] = (d < 1.0) ? 255 : 0;
+		}
+	}
+	glGenTextures(1, &disc);
+	glBindTexture(GL_TEXTURE_2D, disc);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE_ALPHA, 32, 32, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, pixels);
+	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void setup() {
 	firstPersonPerspective();
-	setupLighting();
-	// glShadeModel(GL_FLAT);
-	glShadeModel(GL_SMOOTH);
 	SETTINGS = SET_MOUSE_LOOK | SET_KEYBOARD_MOVE | SET_KEYBOARD_FUNCTIONS | SET_SHOW_GROUND;
+	makeDisc();
 
-	for (int i = 0; i < numPolyhedra; i++){
-		poly[i].type = random() % 5;
+	particles = createParticles(NUM_PARTICLES);
+	particles->size = 0.05;
+	for (int i = 0; i < NUM_PARTICLES; i++){
+		float position[3], velocity[3];
 		for(int j = 0; j < 3; j++){
-			poly[i].pos[j] = ((random()%1000)*0.001-0.5)*2.0 * (BOUNDS[j]) + B_OFFSET[j];
-			poly[i].vel[j] = ((random()%1000)*0.001-0.5)*2.0 * 0.01;
-			poly[i].spin[j] = ((random()%1000)*0.001-0.5)*2.0 * 200.0;
+			position[j] = ((random()%1000)*0.001-0.5)*2.0 * (BOUNDS[j]) + B_OFFSET[j];
+			velocity[j] = ((random()%1000)*0.001-0.5)*2.0 * 0.01;
 		}
-		poly[i].scale = 0.01 + 0.05 * (random()%100)*0.01;
-		poly[i].vel[2] = -0.03;  // z velocity (falling) is fixed
+		velocity[2] = -0.03;  // z velocity (falling) is fixed
+		emitParticle(particles, position, velocity, 0, COLORS[random() % 4]);
 	}
 }
-void update() { 
-	// update particle positions
-	for (int i = 0; i < numPolyhedra; i++){
-		for(int j = 0; j < 3; j++){
-			poly[i].pos[j] += poly[i].vel[j];
-			if(poly[i].pos[j] < ORIGIN[j]-BOUNDS[j]+B_OFFSET[j]){ poly[i].pos[j] = ORIGIN[j]+BOUNDS[j]+B_OFFSET[j]; }
-			if(poly[i].pos[j] > ORIGIN[j]+BOUNDS[j]+B_OFFSET[j]){ poly[i].pos[j] = ORIGIN[j]-BOUNDS[j]+B_OFFSET[j]; }
-		}
+void update() {
+	if(particles == NULL){ return; }  // update() runs once before setup()
+	// the box moves with the camera, positions wrap around inside it
+	for(int j = 0; j < 3; j++){
+		particles->boundsMin[j] = ORIGIN[j]-BOUNDS[j]+B_OFFSET[j];
+		particles->boundsMax[j] = ORIGIN[j]+BOUNDS[j]+B_OFFSET[j];
 	}
+	// velocities are per frame
+	updateParticles(particles, 1.0);
 }
 void draw3D() {
-	// color lights only
-	glDisable(GL_LIGHT0);
-	glEnable(GL_LIGHT1);
-	glEnable(GL_LIGHT2);
-	glEnable(GL_LIGHT3);
-	// material
-	GLfloat mat_white[] = { 0.1f, 0.1f, 0.1f, 1.0f };
-	glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_white);
-	// draw particles
-	for (int i = 0; i < numPolyhedra; i++){
-		glPushMatrix();
-			glTranslatef(poly[i].pos[0], poly[i].pos[1], poly[i].pos[2]);
-			glRotatef(poly[i].spin[0]*ELAPSED, 1, 0, 0);
-			glRotatef(poly[i].spin[1]*ELAPSED, 0, 1, 0);
-			glRotatef(poly[i].spin[2]*ELAPSED, 0, 0, 1);
-			glPushMatrix();
-				glScalef(poly[i].scale, poly[i].scale, poly[i].scale);
-				drawPlatonicSolidFaces(poly[i].type);
-			glPopMatrix();
-		glPopMatrix();
-	}
-	// reset: white light only
-	glEnable(GL_LIGHT0);
-	glDisable(GL_LIGHT1);
-	glDisable(GL_LIGHT2);
-	glDisable(GL_LIGHT3);
+	glEnable(GL_ALPHA_TEST);
+	glAlphaFunc(GL_GREATER, 0.5);
+	glBindTexture(GL_TEXTURE_2D, disc);
+	drawParticles(particles);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glDisable(GL_ALPHA_TEST);
+}
+void draw2D() {
+	char line[64];
+	sprintf(line, "%d particles", particles->count);
+	text(line, 10, 20, 0);
 }
-void draw2D() { }
 void keyDown(unsigned int key) { }
 void keyUp(unsigned int key) { }
 void mouseDown(unsigned int button) { }
 void mouseUp(unsigned int button) { }
-void mouseMoved(int x, int y) { }
\ No newline at end of file
+void mouseMoved(int x, int y) { }
@@ -0,0 +1,168 @@
+// example 12
+//
+// Perlin vs. simplex noise: a benchmark, and both animated through 3D slices
+
+#include "../world.h"
+#include "noise.c"
+
+#define SAMPLES (1 << 19)
+#define IMAGE 128
+
+typedef struct{
+	char *name;
+	double nanoseconds;  // per sample
+} Benchmark;
+
+static Benchmark results[12];
+static int numResults = 0;
+static float batchError[2];  // 2D and 3D, against the scalar reference
+
+static float *X, *Y, *Z, *W, *OUT;
+// Perlin, simplex, and simplex lit by its own derivative
+static GLuint images[3];
+static unsigned char pixels[3][IMAGE*IMAGE];
+
+static double seconds(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+static void record(char *name, double start){
+	results[numResults].name = name;
+	results[numResults].nanoseconds = (seconds() - start) * 1000000000.0 / SAMPLES;
+	printf("%-28s %6.1f ns\n", name, results[numResults].nanoseconds);
+	numResults++;
+}
+
+void runBenchmark(){
+	float derivative[4], sum = 0;
+	double start;
+	batchError[0] = batchError[1] = 0;
+	for(int i = 0; i < SAMPLES; i++){
+		X[i] = random()%100000 / 97.0;
+		Y[i] = random()%100000 / 89.0;
+		Z[i] = random()%100000 / 83.0;
+		W[i] = random()%100000 / 79.0;
+	}
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[2] = {X[i], Y[i]}; sum += noise2(v); }
+	record("perlin 2D", start);
+	start = seconds();
+	noise2Batch(NULL, X, Y, OUT, SAMPLES);
+	record("perlin 2D batch", start);
+	// each batch has to agree with the scalar reference, checked before OUT is reused
+	for(int i = 0; i < SAMPLES; i++){
+		float v[2] = {X[i], Y[i]};
+		batchError[0] = max(batchError[0], fabs(OUT[i] - noise2(v)));
+	}
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[2] = {X[i], Y[i]}; sum += simplex2(v); }
+	record("simplex 2D", start);
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[2] = {X[i], Y[i]}; sum += generatorSimplex2(NULL, v, derivative); }
+	record("simplex 2D + derivative", start);
+
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[3] = {X[i], Y[i], Z[i]}; sum += noise3(v); }
+	record("perlin 3D", start);
+	start = seconds();
+	noise3Batch(NULL, X, Y, Z, OUT, SAMPLES);
+	record("perlin 3D batch", start);
+	for(int i = 0; i < SAMPLES; i++){
+		float v[3] = {X[i], Y[i], Z[i]};
+		batchError[1] = max(batchError[1], fabs(OUT[i] - noise3(v)));
+	}
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[3] = {X[i], Y[i], Z[i]}; sum += simplex3(v); }
+	record("simplex 3D", start);
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[3] = {X[i], Y[i], Z[i]}; sum += generatorSimplex3(NULL, v, derivative); }
+	record("simplex 3D + derivative", start);
+	// Perlin has no 4D, its 3D cost with finite differences is the comparison
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[3] = {X[i], Y[i], Z[i]}; sum += sampleNoise(NULL, NOISE_PERLIN, 3, v, derivative); }
+	record("perlin 3D + differences", start);
+
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[4] = {X[i], Y[i], Z[i], W[i]}; sum += simplex4(v); }
+	record("simplex 4D", start);
+	start = seconds();
+	for(int i = 0; i < SAMPLES; i++){ float v[4] = {X[i], Y[i], Z[i], W[i]}; sum += generatorSimplex4(NULL, v, derivative); }
+	record("simplex 4D + derivative", start);
+	printf("batch vs. scalar max error 2D %g 3D %g  (%g)\n", batchError[0], batchError[1], sum);
+}
+
+void setup(){
+	X = (float*)malloc(sizeof(float) * SAMPLES * 5);
+	Y = &X[SAMPLES];
+	Z = &X[SAMPLES*2];
+	W = &X[SAMPLES*3];
+	OUT = &X[SAMPLES*4];
+	runBenchmark();
+
+	glGenTextures(3, images);
+	for(int i = 0; i < 3; i++){
+		glBindTexture(GL_TEXTURE_2D, images[i]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, IMAGE, IMAGE, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, pixels[i]);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+	SETTINGS = SET_KEYBOARD_FUNCTIONS;
+}
+void update(){
+	// a slice through 3D noise, moving along Z
+	for(int y = 0; y < IMAGE; y++){
+		for(int x = 0; x < IMAGE; x++){
+			float v[3] = {x * 0.05f, y * 0.05f, ELAPSED * 0.5f};
+			float d[3];
+			float perlin = noise3(v) * 0.7 + 0.5;
+			float simplex = generatorSimplex3(NULL, v, d) * 0.5 + 0.5;
+			// the derivative is the slope, a normal without extra samples
+			float normal[3] = {-d[0], -d[1], 4.0};
+			vec3Normalize(normal);
+			float light = max(0, normal[0] * 0.5 + normal[1] * 0.5 + normal[2] * 0.7);
+			pixels[0][y*IMAGE+x] = min(255, max(0, perlin * 255));
+			pixels[1][y*IMAGE+x] = min(255, max(0, simplex * 255));
+			pixels[2][y*IMAGE+x] = min(255, light * 255);
+		}
+	}
+	for(int i = 0; i < 3; i++){
+		glBindTexture(GL_TEXTURE_2D, images[i]);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, IMAGE, IMAGE, GL_LUMINANCE, GL_UNSIGNED_BYTE, pixels[i]);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+void draw3D(){ }
+void draw2D(){
+	char line[64];
+	glColor4f(1.0, 1.0, 1.0, 1.0);
+	text("nanoseconds per sample", 10, 20, 0);
+	for(int i = 0; i < numResults; i++){
+		sprintf(line, "%-24s %6.1f", results[i].name, results[i].nanoseconds);
+		text(line, 10, 40 + i*15, 0);
+	}
+	sprintf(line, "batch vs. scalar max error 2D %g 3D %g", batchError[0], batchError[1]);
+	text(line, 10, 40 + numResults*15 + 10, 0);
+
+	char *labels[3] = {"perlin 3D", "simplex 3D", "simplex derivative lit"};
+	float size = min(WIDTH / 3.0, HEIGHT * 0.5) - 20;
+	for(int i = 0; i < 3; i++){
+		float x = 10 + i * (size + 20);
+		glColor4f(1.0, 1.0, 1.0, 1.0);
+		glBindTexture(GL_TEXTURE_2D, images[i]);
+		drawRect(x, HEIGHT - size - 10, 0, size, size);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		text(labels[i], x, HEIGHT - size - 20, 0);
+	}
+}
+void keyDown(unsigned int key){
+	if(key == ' '){
+		numResults = 0;
+		runBenchmark();
+	}
+}
+void keyUp(unsigned int key){ }
+void mouseDown(unsigned int button){ }
+void mouseUp(unsigned int button){ }
+void mouseMoved(int x, int y){ }
@@ -0,0 +1,91 @@
+// example 13
+//
+// an endless landscape, streamed in tiles around the camera
+
+#include "../world.h"
+#include "noise.c"
+
+#define ZSCALE 10.0
+
+static FractalNoise land = {12, .004, .75*ZSCALE, 2.0, 0.5, 0};
+static Terrain terrain;
+
+// samples are 0.1 apart, like example 2
+float landHeight(float x, float y, void *context){
+	float h = fbm2((FractalNoise*)context, x * 10, y * 10);
+	// crop ocean
+	return max(h, -.33 * ZSCALE*.5);
+}
+void landColor(float x, float y, float height, float rgb[3], void *context){
+	float scale = (.5*ZSCALE + height) / ZSCALE;
+	if(scale < 0.0) scale = 0.0;
+	if(scale > 1.0) scale = 1.0;
+	if(scale < .3){
+		rgb[0] = 1.0 * scale;
+		rgb[1] = 0.24f + .76 * scale;
+		rgb[2] = 0.666f + .334 * scale;
+	}
+	else if(scale > .8333){
+		float white = min((scale-.83333)/0.166666666667, 1.0);
+		rgb[0] = white;
+		rgb[1] = 0.3f + 0.7f*white;
+		rgb[2] = white;
+	}
+	else if(scale < .333){
+		rgb[0] = 0.8;
+		rgb[1] = 0.5f;
+		rgb[2] = 0.0;
+	}
+	else{
+		float dark = min((scale-.3333)/.5, 1.0);
+		rgb[0] = 0.0f;
+		rgb[1] = 0.5f - 0.2f*dark;
+		rgb[2] = 0.0f;
+	}
+}
+
+void setup(){
+	land.seed = rand();
+	terrain.resolution = 65;
+	terrain.tileSize = 12.8;
+	terrain.radius = 4;
+	terrain.memoryBudget = 32 << 20;
+	terrain.uploadsPerFrame = 2;
+	terrain.height = landHeight;
+	terrain.color = landColor;
+	terrain.context = &land;
+	SETTINGS = SET_MOUSE_LOOK | SET_KEYBOARD_MOVE | SET_KEYBOARD_FUNCTIONS;
+	firstPersonPerspective();
+
+	GLfloat white_color[] = { 1.0, 1.0, 1.0, 1.0 };
+	GLfloat sun[] = { 0.3, 0.2, 1.0, 0.0 };
+	glLightfv(GL_LIGHT0, GL_DIFFUSE, white_color);
+	glLightfv(GL_LIGHT0, GL_POSITION, sun);
+	glEnable(GL_LIGHT0);
+	glEnable(GL_LIGHTING);
+	glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+	glEnable(GL_COLOR_MATERIAL);
+	glClearColor(0.55, 0.75, 0.95, 1.0);
+}
+void update(){
+	// the camera's tile is never waited on, the height function fills in until it arrives
+	updateTerrain(&terrain, ORIGIN[0], ORIGIN[1]);
+	if(PERSPECTIVE == FPP){
+		float target = terrainHeight(&terrain, ORIGIN[0], ORIGIN[1]) + 0.5;
+		ORIGIN[2] = ORIGIN[2]*0.5 + target*0.5;
+	}
+}
+void draw3D(){
+	drawTerrain(&terrain);
+}
+void draw2D(){
+	char line[96];
+	glColor4f(0.0, 0.0, 0.0, 1.0);
+	sprintf(line, "tiles drawn %u  pending %u  memory %.1f MB", terrain.tilesDrawn, terrain.tilesPending, terrain.memoryUsed / 1048576.0);
+	text(line, 10, 20, 0);
+}
+void keyDown(unsigned int key){ }
+void keyUp(unsigned int key){ }
+void mouseDown(unsigned int button){ }
+void mouseUp(unsigned int button){ }
+void mouseMoved(int x, int y){ }
@@ -0,0 +1,97 @@
+// example 14
+//
+// a star cluster under its own gravity. the simulation of the next frame
+// runs on its own thread while this frame draws. space bar turns it off and on
+
+#include "../world.h"
+
+#define NUM_STARS 2048
+
+// everything update() writes, draw code reads its copy through drawState()
+typedef struct{
+	float position[NUM_STARS][3];
+	float velocity[NUM_STARS][3];
+	float milliseconds;  // the last update()
+} Cluster;
+
+static Cluster cluster;
+
+static double seconds(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+// every star pulls on every other, softened so close passes don't explode
+void gravity(void *context, int first, int end){
+	Cluster *c = (Cluster*)context;
+	for(int i = first; i < end; i++){
+		float a[3] = {0, 0, 0};
+		for(int j = 0; j < NUM_STARS; j++){
+			float d[3] = {c->position[j][0] - c->position[i][0],
+			              c->position[j][1] - c->position[i][1],
+			              c->position[j][2] - c->position[i][2]};
+			float r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2] + 0.05;
+			float f = 1.0 / (r2 * sqrtf(r2));
+			a[0] += d[0] * f;
+			a[1] += d[1] * f;
+			a[2] += d[2] * f;
+		}
+		for(int k = 0; k < 3; k++){ c->velocity[i][k] += a[k] * 0.00002; }
+	}
+}
+
+void setup(){
+	for(int i = 0; i < NUM_STARS; i++){
+		// a flattened disc, spinning
+		float angle = (random()%10000) / 10000.0 * M_PI * 2;
+		float radius = sqrtf((random()%10000) / 10000.0) * 5.0 + 0.2;
+		cluster.position[i][0] = cosf(angle) * radius;
+		cluster.position[i][1] = sinf(angle) * radius;
+		cluster.position[i][2] = ((random()%1000) / 1000.0 - 0.5) * 0.4;
+		cluster.velocity[i][0] = -sinf(angle) * 0.02;
+		cluster.velocity[i][1] = cosf(angle) * 0.02;
+		cluster.velocity[i][2] = 0.0;
+	}
+	pipelineState(&cluster, sizeof(Cluster));
+	PIPELINE = 1;
+	SETTINGS = SET_MOUSE_LOOK | SET_KEYBOARD_FUNCTIONS;
+	polarPerspective();
+	HORIZON[1] = 30;
+	HORIZON[2] = 14;
+}
+void update(){
+	double start = seconds();
+	parallelFor(0, NUM_STARS, 0, gravity, &cluster);
+	for(int i = 0; i < NUM_STARS; i++){
+		for(int k = 0; k < 3; k++){ cluster.position[i][k] += cluster.velocity[i][k]; }
+	}
+	cluster.milliseconds = (seconds() - start) * 1000.0;
+}
+void draw3D(){
+	const Cluster *c = (const Cluster*)drawState();
+	noFill();
+	glColor4f(1.0, 0.9, 0.6, 0.5);
+	for(int i = 0; i < NUM_STARS; i++){
+		glPushMatrix();
+			glTranslatef(c->position[i][0], c->position[i][1], c->position[i][2]);
+			drawIcosahedron(0.02);
+		glPopMatrix();
+	}
+}
+void draw2D(){
+	static double last;
+	double now = seconds();
+	char line[96];
+	const Cluster *c = (const Cluster*)drawState();
+	sprintf(line, "%s  update %.1f ms  frame %.1f ms", PIPELINE ? "pipelined" : "one thread", c->milliseconds, (now - last) * 1000.0);
+	text(line, 10, 20, 0);
+	last = now;
+}
+void keyDown(unsigned int key){
+	if(key == ' '){ PIPELINE = !PIPELINE; }
+}
+void keyUp(unsigned int key){ }
+void mouseDown(unsigned int button){ }
+void mouseUp(unsigned int button){ }
+void mouseMoved(int x, int y){ }
@@ -0,0 +1,39 @@
+// example 7's calendar, exported without a window
+//
+// calendar 1990-01-01 2020-01-01 [minutes per row] [csv | binary] [file]
+
+#include <time.h>
+#include "ephemeris.c"
+
+static double seconds(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+int main(int argc, char **argv){
+	int first[3], last[3];
+	if(argc < 3 || sscanf(argv[1], "%d-%d-%d", &first[0], &first[1], &first[2]) != 3 || sscanf(argv[2], "%d-%d-%d", &last[0], &last[1], &last[2]) != 3){
+		fprintf(stderr, "usage: %s YYYY-MM-DD YYYY-MM-DD [minutes per row] [csv | binary] [file]\n", argv[0]);
+		return 1;
+	}
+	double minutes = (argc > 3) ? atof(argv[3]) : 60.0;
+	int format = (argc > 4 && !strcmp(argv[4], "binary")) ? EPHEMERIS_BINARY : EPHEMERIS_CSV;
+	const char *path = (argc > 5) ? argv[5] : (format == EPHEMERIS_BINARY) ? "../examples/data/calendar-data.bin" : "../examples/data/calendar-data.csv";
+	if(!(minutes > 0)){
+		fprintf(stderr, "minutes per row must be more than 0\n");
+		return 1;
+	}
+	double start = seconds();
+	long rows = exportEphemeris(path,
+		ephemerisDay(first[0], first[1], first[2], 0, 0, 0),
+		ephemerisDay(last[0], last[1], last[2], 0, 0, 0),
+		minutes / 1440.0, format, 0);
+	if(rows < 0){
+		fprintf(stderr, "can't write %s\n", path);
+		return 1;
+	}
+	double elapsed = seconds() - start;
+	printf("%ld rows to %s in %.2f seconds, %.0f rows per second\n", rows, path, elapsed, rows / elapsed);
+	return 0;
+}
@@ -1,1622 +0,0 @@
-// 1619 stars
-float _1619_stars[] = {
-15.154706, 0.105637, -65.986847,
-126.521637, 1.081976, -13.329641,
-66.697891, 1.088394, -20.822796,
-484.253693, 9.513831, -89.851456,
-39.195129, 0.912692, -3.918667,
-25.990032, 0.951437, 14.470105,
-8.555331, 0.342427, 14.334859,
-29.950174, 1.230281, -30.767408,
-18.183201, 0.894487, -5.037567,
-98.414948, 5.690009, 26.753136,
-93.561302, 5.969092, 34.506283,
-142.593826, 9.121509, -49.011650,
-60.439472, 4.515894, 48.524311,
-34.544571, 2.768532, 25.911661,
-87.443718, 7.430486, -13.623164,
-3.634064, 0.318449, -7.779714,
-1.638744, 0.184201, -7.290789,
-16.901623, 1.940784, -16.246269,
-17.435064, 2.008142, -15.972442,
-139.896561, 17.132866, -91.553307,
-34.394566, 4.744233, -39.665573,
-19.286636, 2.671325, -38.144505,
-23.758625, 3.292125, -47.004356,
-62.480167, 8.717628, 88.515411,
-570.052979, 82.653183, 1127.171387,
-165.195206, 26.815447, 111.695259,
-106.518188, 17.333809, 147.977707,
-44.449432, 7.549646, 25.313892,
-26.275408, 4.553503, 15.935397,
-38.038025, 6.793835, 58.461533,
-51.731968, 9.430737, -54.614838,
-212.662659, 39.476833, 262.504700,
-38.927647, 7.452971, -62.125664,
-35.780834, 6.868961, 39.104591,
-27.437685, 5.282069, -9.071561,
-62.077923, 12.120170, -11.847520,
-181.334167, 35.843494, 207.349121,
-49.625038, 10.398814, 22.858473,
-90.642784, 19.548647, 12.348023,
-73.537643, 15.910560, 92.807220,
-3.098176, 0.673883, 5.038080,
-153.347687, 33.865696, 136.895493,
-154.964493, 36.495129, -3.179791,
-8.728547, 2.058167, 16.261154,
-62.427895, 15.276937, 106.848213,
-31.360117, 7.915946, 54.216637,
-89.141045, 22.518227, 163.949677,
-31.706820, 8.015939, 26.013559,
-66.160141, 16.866201, 29.570858,
-173.863174, 45.454689, -101.083885,
-55.624813, 15.673218, 8.008922,
-39.931870, 11.844490, -44.228069,
-46.729633, 14.372416, -70.463585,
-33.916454, 10.464482, -6.374839,
-5.979397, 1.849103, 95.672775,
-146.258636, 45.766033, 165.739410,
-47.405479, 14.885503, 35.600159,
-22.931017, 7.351182, 34.582821,
-119.725998, 38.585796, 48.373703,
-40.939301, 13.234828, 24.930664,
-99.846931, 33.286728, 48.150826,
-9.982845, 3.397278, -10.742782,
-6.965123, 2.390069, -19.060160,
-79.695213, 28.796692, 43.669445,
-353.336578, 128.747116, 607.273804,
-39.317883, 14.766851, 42.781902,
-32.445164, 12.458461, -4.997577,
-79.660942, 31.226866, -22.285439,
-14.082442, 5.533743, 26.457554,
-20.522423, 8.076938, 54.945595,
-18.436007, 7.416032, 20.155994,
-48.360588, 19.628767, -49.214024,
-101.466286, 42.123344, 11.826131,
-27.262018, 11.466853, -34.110416,
-80.120163, 33.795986, 23.863348,
-29.398064, 12.772287, 53.837509,
-9.213801, 4.140828, 8.907683,
-21.725090, 9.867803, -37.077293,
-32.059631, 14.609014, 40.002121,
-143.539551, 67.376411, 135.797653,
-101.524651, 48.116165, 10.793499,
-8.402498, 3.997676, 8.560543,
-331.863434, 159.581848, -23.749142,
-125.236572, 60.852310, 170.047470,
-3.151621, 1.538603, -1.001653,
-70.046799, 34.692768, 12.601057,
-20.600830, 10.676918, -4.378503,
-69.079262, 36.521645, -14.249583,
-15.056807, 8.097229, 9.703738,
-52.028908, 28.111221, 20.702824,
-51.337212, 27.745079, 3.249755,
-59.865932, 32.385254, -71.231201,
-52.767460, 28.768179, 121.443840,
-14.984444, 8.190080, 6.489631,
-22.172586, 12.155938, -61.493458,
-9.498562, 5.262280, -13.705148,
-68.369072, 37.897625, 200.343597,
-98.603409, 55.033817, -46.835464,
-48.322079, 27.107815, -60.222862,
-32.573452, 18.415966, 16.344898,
-9.041969, 5.155593, -19.226034,
-74.545639, 43.040573, -33.176647,
-10.099245, 5.946486, 33.858444,
-36.696106, 21.625727, 2.056206,
-113.404778, 67.001450, 184.578079,
-12.885702, 7.699454, 47.380848,
-68.972282, 41.401226, 73.275047,
-82.676567, 49.918228, -54.189850,
-15.757537, 9.767368, 8.046751,
-40.574268, 25.473352, 37.240467,
-74.547546, 47.227875, 42.927307,
-26.366255, 16.723177, 21.851988,
-67.726250, 44.138428, 47.244946,
-91.713280, 60.129971, 17.069052,
-102.190857, 67.141121, 119.037804,
-24.462378, 16.579145, -37.167130,
-7.411856, 5.048460, 6.100236,
-24.733585, 16.890131, 20.085890,
-12.302719, 8.755242, -38.648701,
-54.369156, 40.092949, 81.306725,
-127.319214, 94.168457, -34.500416,
-87.397156, 65.253693, -119.882668,
-42.608364, 32.153969, 7.939581,
-13.272648, 10.098833, 40.070580,
-1.339647, 1.044621, 132.264221,
-19.624458, 15.344441, -6.788939,
-95.949471, 76.215904, -65.792511,
-88.231216, 71.368469, 11.113632,
-152.278061, 127.191582, 1.137633,
-13.355966, 11.166039, -43.672741,
-22.332010, 18.705374, -27.062185,
-26.165489, 22.085249, -28.583899,
-14.321428, 12.258569, 15.927513,
-18.991888, 16.408123, 1.419101,
-75.913658, 65.672623, 52.715744,
-98.972809, 86.128723, -32.368629,
-5.531760, 4.816946, 8.506368,
-19.124958, 16.763216, 4.536582,
-9.955457, 8.738365, -4.450906,
-25.832386, 22.762741, -83.603729,
-35.916012, 32.312645, 27.053268,
-32.352257, 29.409742, -27.753464,
-32.050503, 29.364540, 22.398111,
-19.115757, 17.589485, -97.401939,
-22.595901, 20.811117, 24.277132,
-168.261581, 155.126755, 337.965942,
-38.399033, 35.507851, -20.080269,
-75.261467, 69.884560, 72.074333,
-33.343739, 31.713358, 60.542503,
-28.967106, 28.077629, -6.315605,
-26.870634, 26.466131, -31.990742,
-54.618340, 54.030884, 63.699448,
-29.884996, 29.572664, -86.474892,
-62.329727, 61.821503, 61.889526,
-59.272079, 58.865997, 32.637558,
-90.955452, 90.729462, 20.134981,
-47.115772, 48.062527, 4.812555,
-16.936480, 17.293940, -10.587537,
-32.362141, 33.745899, 63.201557,
-53.657631, 56.137218, 62.527916,
-23.740711, 24.917231, 52.405052,
-14.645698, 15.728803, 18.653234,
-4.632073, 5.013057, 8.023712,
-16.524990, 17.954088, 24.280577,
-48.387177, 53.405762, 59.642616,
-32.458683, 35.931503, 17.362856,
-8.936285, 9.919292, 47.798203,
-8.257044, 9.176118, -6.839448,
-64.198997, 73.141754, 37.444736,
-23.872042, 27.421450, -5.641208,
-46.820477, 54.998436, -29.934572,
-242.079132, 285.274200, 254.484451,
-5.896798, 6.987745, 0.538406,
-47.386776, 56.231846, -29.349659,
-2.847127, 3.389681, -4.138354,
-65.115669, 77.593315, 223.847809,
-110.203987, 131.731735, 95.392876,
-22.097919, 26.674675, 32.675949,
-73.499161, 91.025482, 138.745102,
-40.129223, 49.916916, 10.177399,
-41.526802, 52.756313, 11.515882,
-70.504402, 90.282791, 132.068146,
-403.344086, 521.249756, 1138.821411,
-67.929283, 88.022835, 130.223999,
-5.958116, 7.720715, -19.089352,
-238.481430, 310.549286, 648.541992,
-43.992031, 57.630184, 80.507957,
-70.506813, 92.400688, -10.322348,
-65.233253, 85.687332, 24.737474,
-1.899908, 2.542904, -0.528817,
-50.237701, 67.760849, -33.453449,
-83.837204, 115.911644, 159.955154,
-8.021356, 11.129592, 0.096456,
-29.939585, 41.624950, -43.444248,
-107.843620, 157.278244, -118.878006,
-132.758957, 193.848541, 158.268250,
-24.432337, 35.828346, -33.051998,
-61.216824, 89.845474, 119.847870,
-5.007815, 7.372184, -1.533830,
-7.267914, 10.794681, -27.663704,
-213.461685, 317.421417, 241.710129,
-57.670769, 86.208900, 46.425533,
-69.722847, 104.539124, 115.460800,
-57.713299, 86.544006, 47.334297,
-55.556568, 83.798965, 45.540119,
-60.672646, 91.700165, 219.050125,
-82.190094, 124.342659, -31.958565,
-55.433552, 84.010368, 44.704266,
-9.038829, 13.766822, -7.075081,
-9.763154, 14.924950, -63.191349,
-56.241905, 86.179871, 46.044415,
-21.238905, 32.892326, -30.174170,
-57.579388, 89.656578, 47.560078,
-28.004955, 43.729015, -38.005615,
-66.071510, 103.235146, 269.274994,
-17.631647, 27.771761, 97.368057,
-56.265255, 91.557526, -49.228672,
-133.508514, 218.147964, 159.095230,
-55.044468, 90.081337, -5.448940,
-140.215256, 236.004440, 497.465759,
-23.919922, 40.375557, 92.391533,
-64.217766, 108.861153, 106.093224,
-33.450344, 56.803757, -15.836289,
-39.286201, 67.193680, -142.761658,
-222.144608, 380.783936, 317.842743,
-46.393429, 80.294754, -41.319374,
-55.125313, 96.137802, 24.548878,
-34.875584, 60.955860, -132.969925,
-24.306553, 42.657677, -88.861702,
-19.229881, 34.392418, 4.134029,
-131.744843, 238.785172, 456.681976,
-24.766619, 45.001133, 20.838928,
-32.203403, 59.673569, 81.824837,
-53.339314, 101.018707, 125.599144,
-18.310568, 35.491486, -35.951073,
-17.370295, 34.041737, -4.582705,
-50.183372, 100.586159, 18.335077,
-11.850987, 23.769753, -24.162779,
-27.693081, 55.784218, -11.268650,
-10.282566, 20.719511, -44.384434,
-64.756226, 131.151749, 124.852318,
-65.157166, 131.977036, 165.832962,
-2.205495, 4.486800, -0.671041,
-57.987514, 118.281143, 20.610601,
-5.540175, 11.362170, -15.884450,
-4.063180, 8.375668, -15.679575,
-11.636397, 24.195242, 10.080134,
-19.600603, 41.044495, -30.447258,
-26.771759, 56.281609, 75.058624,
-19.262455, 41.210888, 12.724867,
-39.258114, 84.529861, 48.209805,
-24.041122, 51.798634, 39.345764,
-40.780090, 89.022667, 103.180923,
-18.406237, 40.828827, 14.157565,
-28.201946, 63.369469, -46.814949,
-17.337641, 38.984413, 13.406843,
-17.455559, 39.844353, 17.835402,
-17.294029, 39.532101, 13.960156,
-17.390793, 40.142853, 18.402273,
-18.346004, 42.366982, 12.906434,
-53.462326, 123.849854, 35.424255,
-22.241796, 52.678978, 16.785786,
-18.075920, 42.882431, 13.310910,
-17.428921, 41.368534, 15.615283,
-17.052547, 40.497761, 12.492988,
-16.208189, 39.401810, 12.373197,
-95.445488, 235.873718, -0.195367,
-12.199465, 30.777208, -18.934263,
-16.590330, 42.035007, 11.977390,
-11.314197, 28.721037, -44.159611,
-19.856333, 51.426281, -32.552822,
-16.334627, 42.361835, 8.137148,
-6.865749, 17.867243, 5.673362,
-64.110977, 167.712204, -10.517603,
-52.609917, 138.297592, 129.830841,
-15.661605, 41.976337, 9.941483,
-11.348306, 30.425724, -8.279480,
-23.627998, 63.954727, -14.645216,
-16.175797, 44.008484, 13.372098,
-35.476665, 98.058762, -37.278286,
-5.093470, 14.102020, -13.435861,
-37.646244, 106.672058, 47.916435,
-52.014359, 154.339966, -9.261561,
-2.401027, 7.596085, 0.972697,
-38.656517, 122.437172, 98.478607,
-17.492147, 55.999020, 9.187336,
-113.617325, 367.072845, 37.711006,
-46.714184, 154.075256, 40.891438,
-39.980587, 132.074844, 102.869171,
-19.967350, 66.233940, -6.603541,
-242.300919, 818.652466, 1948.854614,
-116.339890, 394.346069, 17.524639,
-10.202712, 34.944351, 6.517954,
-13.836325, 48.550293, 12.133580,
-35.673786, 126.476173, 85.882027,
-18.408363, 65.585419, 92.910843,
-77.430801, 281.823303, 8.745934,
-10.084345, 37.152607, 29.958736,
-22.563917, 84.104797, -19.364273,
-15.223061, 58.260834, -21.978903,
-73.539612, 281.512512, -36.622475,
-112.961624, 436.545746, 432.773010,
-45.223167, 176.381760, 158.709686,
-11.419758, 45.043724, 18.388969,
-36.866852, 146.282104, 266.011993,
-11.094563, 44.835407, -32.924534,
-28.332273, 114.848465, 32.592205,
-15.148774, 62.451622, -26.448929,
-1.475441, 6.088451, -9.823349,
-11.695547, 49.201786, 44.327118,
-3.755204, 15.847830, 20.547281,
-6.120895, 26.433861, -2.415023,
-116.941246, 518.343750, -81.824570,
-20.478788, 91.803711, 26.257223,
-14.946129, 70.768555, -15.201564,
-11.070249, 53.142262, -15.776265,
-33.877480, 163.701141, -38.413803,
-21.300817, 103.064560, 5.260015,
-7.867094, 38.180721, 30.991299,
-13.016386, 63.632324, -154.399323,
-46.220867, 229.943756, -33.805035,
-1.688459, 8.827823, 9.306870,
-5.105885, 27.206705, -19.306969,
-31.056490, 165.975464, -20.267546,
-10.887786, 58.997784, 39.516720,
-1.715595, 9.519300, 8.145328,
-10.345766, 57.609692, 23.763155,
-56.386913, 316.357849, -75.233086,
-22.511400, 129.145920, -50.952335,
-65.638771, 389.759705, -2.638458,
-47.537281, 290.557953, 18.236826,
-8.295527, 52.298012, -7.260991,
-2.163871, 13.826807, 4.381388,
-42.608707, 272.692596, -11.554075,
-52.086514, 335.945557, 10.959518,
-11.224151, 73.203018, 8.241212,
-5.169121, 34.891056, 19.237144,
-62.602345, 429.610962, 23.479773,
-27.837996, 195.812607, 79.655991,
-6.302877, 45.198479, -17.298277,
-18.413574, 138.617065, -2.665861,
-11.190163, 87.304893, 9.170761,
-8.668653, 68.648994, -49.301853,
-57.430119, 466.569336, -60.232712,
-34.224377, 278.802277, -1.466332,
-67.432571, 553.436707, 187.567139,
-125.582146, 1050.353271, 665.948242,
-44.491955, 372.157104, -120.498322,
-16.891573, 146.130676, -282.461487,
-32.672035, 296.183990, 49.809162,
-61.758480, 564.930420, -59.750675,
-34.513000, 316.898529, 55.830563,
-62.053886, 575.463684, -54.876408,
-25.737444, 238.721802, -20.324009,
-43.260105, 402.022675, -41.855446,
-42.625080, 409.218109, -8.632048,
-3.533041, 34.942120, 5.745761,
-11.615465, 118.702309, 46.124069,
-32.573738, 350.238678, -15.973300,
-4.297262, 46.510323, -5.911172,
-45.004906, 494.180786, 35.756790,
-6.040792, 67.849564, -46.074329,
-21.004774, 249.600281, -8.495712,
-53.503101, 638.664124, -12.628046,
-17.925049, 219.142014, 65.272331,
-7.069958, 92.291519, 2.382863,
-0.561442, 8.270766, -3.424850,
-1.213626, 18.240314, -40.554199,
-1.183396, 20.769531, -5.504973,
-0.671817, 12.096553, -14.996687,
-11.645684, 217.784592, -37.160706,
-6.971413, 145.348373, 66.522537,
-2.386013, 50.475098, 41.184753,
-3.706523, 81.225548, 18.251505,
-1.315660, 29.618370, -44.231041,
-0.843405, 21.369162, -15.406507,
-4.531849, 115.860886, 88.348000,
-1.217960, 32.140251, -12.267515,
-1.897829, 51.086220, 41.617153,
-11.249267, 340.932526, 11.048790,
-2.613693, 86.973351, -58.253036,
-3.462430, 118.889763, 62.212894,
-0.317777, 12.337725, -24.317606,
-0.199088, 8.123972, 3.002249,
-0.935635, 41.601482, 61.016708,
-2.738015, 129.939102, 16.896118,
-1.577200, 80.283287, -60.774906,
-0.228781, 14.584967, -3.682361,
-2.296619, 213.680298, -151.209366,
-5.076682, 580.072205, 282.353607,
-0.444915, 119.469971, -110.689705,
-0.052014, 25.140087, 34.966862,
-0.036581, 17.818575, 17.785946,
-0.051556, 42.293926, 32.117710,
-0.050824, 179.240189, 185.199112,
--0.031259, 128.514938, -6.901805,
--2.370352, 295.168243, -55.230030,
--0.477027, 45.872711, 7.798223,
--160.565979, 9387.260742, 3442.899902,
--0.763196, 42.446800, 18.251499,
--6.838625, 314.318054, -93.034340,
--1.355708, 50.463379, -13.465407,
--6.106983, 185.874283, -141.433319,
--5.236385, 158.432114, 41.789276,
--13.089140, 291.088837, -415.653900,
--9.821245, 188.344818, 47.754189,
--11.996239, 227.862991, 65.991722,
--12.724591, 196.031982, -21.599976,
--6.416699, 98.703201, 40.984310,
--3.022303, 44.971924, 25.499950,
--7.666755, 111.400055, -27.258612,
--3.309493, 45.743633, -32.281925,
--1.563750, 18.973282, 50.434910,
--2.012381, 23.445553, 39.180317,
--13.511181, 154.484802, -7.976465,
--7.897809, 88.873657, -51.645119,
--5.847032, 60.408535, -40.073395,
--14.405571, 144.966568, -47.210594,
--6.566555, 65.327301, 27.214411,
--4.064221, 39.048180, 3.153775,
--6.061528, 57.789185, -76.263489,
--83.202148, 762.838989, 891.760681,
--12.865911, 104.144684, -67.058350,
--26.370138, 208.610168, -25.941074,
--18.224659, 143.441589, 53.235359,
--79.961372, 571.557556, -249.964294,
--65.697723, 454.452240, 59.090511,
--49.481434, 321.705872, -431.556458,
--17.713442, 114.898224, -49.263393,
--2.984771, 18.488173, -6.542049,
--5.049569, 30.409986, 9.072353,
--15.508861, 93.274231, -88.780190,
--22.234568, 133.259888, -44.517197,
--79.891769, 461.580170, -118.062469,
--16.701227, 96.362732, 89.582062,
--54.922153, 303.892548, 53.873413,
--47.779385, 246.192642, 117.643143,
--15.710416, 80.845253, 19.359480,
--0.494399, 2.476801, -0.758367,
--3.356390, 16.762621, 3.914118,
--7.144065, 34.930141, 60.386551,
--30.169420, 144.002457, 20.775251,
--23.699598, 111.831436, 4.815584,
--2.978776, 13.956450, -26.774021,
--44.056953, 199.382172, -130.126999,
--21.695814, 98.156776, -136.462158,
--7.684298, 34.707775, -43.299332,
--18.304964, 81.281677, 74.446091,
--50.478771, 223.662094, -156.804520,
--11.414032, 48.674469, 33.672924,
--107.551857, 451.905853, -171.136444,
--129.375580, 537.517944, -248.285965,
--17.705187, 73.477119, -16.118277,
--6.425096, 26.435381, 6.369860,
--6.595637, 26.640108, -10.063121,
--65.500366, 262.167694, -67.592644,
--218.715973, 874.991455, -276.676422,
--52.229939, 208.450012, -244.790848,
--6.766405, 26.508627, 44.510857,
--12.119889, 47.187828, 48.879723,
--29.241518, 111.808228, -63.987255,
--3.349501, 12.486532, 55.896809,
--87.707726, 317.775299, -174.801178,
--92.579933, 328.741364, -25.315472,
--195.580887, 693.193054, -318.170868,
--32.609585, 114.177635, -33.227974,
--10.507432, 36.707676, -44.838642,
--92.649086, 322.527130, 125.934189,
--144.702667, 470.425964, -244.246704,
--4.284953, 13.853774, -40.948601,
--52.494980, 169.449677, -147.044327,
--19.471193, 61.541149, -4.782737,
--24.409557, 76.095451, 46.596004,
--33.896202, 104.858826, 90.264717,
--35.453167, 109.333801, -0.988567,
--4.517019, 13.786757, -15.427475,
--12.319673, 37.238789, -39.474445,
--13.633564, 41.021538, -42.688732,
--137.811859, 410.366516, -214.440918,
--23.146393, 68.544815, -81.120888,
--81.100334, 239.562683, -127.606796,
--40.264187, 115.975853, -64.950127,
--579.436157, 1668.273438, -761.145325,
--24.994064, 71.742424, -187.632309,
--88.400536, 252.634644, -202.407043,
--9.261693, 26.120365, 8.230488,
--69.748199, 196.128387, -155.350754,
--19.906151, 55.800491, 69.280418,
--280.849335, 785.753235, -381.307739,
--299.297272, 836.961792, -413.624084,
--5.728102, 15.711555, 6.750600,
--52.609459, 140.289459, -51.638958,
--306.715515, 798.031555, -479.833282,
--109.181511, 278.425598, 48.846207,
--12.479839, 31.792545, 18.006186,
--18.407045, 46.305233, 57.751934,
--19.169744, 47.957394, 7.524701,
--45.210373, 111.669716, 18.920748,
--5.960862, 14.550328, 9.743241,
--15.571657, 37.952862, -38.660786,
--64.176735, 155.326553, 35.743050,
--348.185699, 842.081299, -387.248993,
--177.745544, 425.382629, -276.598755,
--7.417604, 17.672827, 143.866791,
--397.143677, 915.557861, -258.540039,
--9.486878, 21.804424, -9.750566,
--5.383373, 12.292792, 8.349454,
--24.532494, 55.503002, -32.769135,
--29.781946, 67.157982, -95.858994,
--26.710785, 60.047787, 33.336220,
--37.117779, 82.045715, -62.980991,
--63.478909, 138.808670, -72.361465,
--51.961048, 112.930733, -62.804760,
--16.741949, 36.247051, 27.527786,
--1.462376, 3.160924, 0.318647,
--58.087090, 125.344231, -109.135452,
--84.893196, 181.254593, -54.619179,
--18.647512, 39.427780, -7.338650,
--5.274398, 11.080404, -39.173740,
--16.410929, 34.020473, 62.149376,
--14.298013, 29.540207, 18.104908,
--114.965523, 236.920212, -142.452820,
--17.634047, 35.976578, 18.173105,
--148.708130, 300.706146, -261.799774,
--4.047311, 8.178082, 4.857111,
--44.353638, 88.838356, 33.243244,
--309.517731, 606.898010, -331.352600,
--21.592218, 42.223312, -50.994144,
--190.693604, 369.310608, -436.053955,
--172.100235, 333.101685, -173.718613,
--37.761246, 70.856331, -68.758293,
--72.197517, 134.867844, -123.272690,
--67.734383, 125.979774, -168.142654,
--188.605270, 349.902222, -443.063049,
--33.097591, 61.278339, 35.128361,
--34.836632, 62.346218, -94.715370,
--69.288628, 123.902069, -59.908283,
--187.574905, 332.659241, -223.472900,
--115.022820, 202.804840, -270.538269,
--38.129787, 66.218483, -4.913983,
--34.621288, 60.045933, -23.055870,
--37.064980, 63.983654, -148.747421,
--73.110130, 125.085953, -3.521738,
--40.681797, 68.881126, 3.261025,
--35.862686, 59.970673, 36.832581,
--168.812286, 282.108063, -275.892792,
--9.259819, 14.884480, -7.916617,
--38.014587, 60.877022, -183.300171,
--22.118271, 35.239590, 52.318226,
--301.929108, 480.410980, -29.575674,
--5.481619, 8.686636, -18.762793,
--73.027588, 115.711075, -47.769314,
--93.545403, 147.499817, -189.522629,
--29.945375, 46.434082, -12.681958,
--240.074005, 371.957306, -366.479004,
--566.976318, 877.825500, -974.051514,
--13.289304, 20.422390, 7.751742,
--199.538406, 303.384583, -102.672577,
--133.812683, 203.145767, -176.085846,
--40.074360, 60.518139, -61.659515,
--49.319893, 72.765961, 14.214975,
--2.502102, 3.622905, -18.950487,
--13.005527, 18.825062, -17.029627,
--5.881099, 8.348730, -46.005550,
--124.648346, 175.747955, -140.214554,
--57.281418, 79.925522, -166.998764,
--178.750504, 249.380905, -346.687347,
--50.721825, 70.563805, 81.573196,
--22.700445, 30.772928, -2.611197,
--7.953260, 10.774009, -30.271833,
--16.790457, 21.829016, 49.111858,
--23.377394, 29.042526, -59.685719,
--204.582993, 248.965881, -300.378510,
--34.694042, 42.215881, 5.457756,
--68.923164, 83.049721, 6.301263,
--40.366478, 48.231491, -35.672291,
--80.680367, 96.129555, -27.766064,
--62.479557, 74.392776, -68.806656,
--21.577406, 25.666021, 69.759125,
--58.896679, 70.008064, -121.064522,
--140.584747, 166.628937, -373.996674,
--421.608643, 499.674377, -692.532471,
--254.957764, 300.585358, -427.393860,
--39.022545, 45.801815, -17.189199,
--57.449593, 67.013672, -117.622314,
--93.326622, 108.096298, 8.481133,
--29.560362, 34.219765, 17.783829,
--141.950241, 163.882736, -141.804337,
--120.327477, 138.820450, -23.318005,
--33.882786, 38.840767, -47.477882,
--26.096796, 29.840279, 12.999019,
--9.299873, 10.632211, -19.956577,
--219.053055, 247.534454, -342.782532,
--44.880028, 50.560493, -16.290325,
--53.279331, 59.853413, 43.980057,
--61.036377, 68.560318, -140.113159,
--27.392748, 30.751047, 4.633106,
--68.981987, 76.321785, 10.518521,
--120.475700, 131.713501, -180.430603,
--38.363789, 41.671555, -29.750319,
--32.446873, 33.880329, -83.406372,
--31.840565, 33.146603, 4.786641,
--42.626991, 44.324928, -32.260979,
--48.541306, 50.125164, -91.673050,
--67.990395, 69.810059, -163.661377,
--36.585037, 37.071434, 10.935761,
--6.895990, 6.943455, 10.884648,
--32.848106, 32.822128, -40.728527,
--8.687991, 8.639161, 10.948359,
--10.904837, 10.674459, -34.921253,
--23.972889, 23.446207, 81.475121,
--63.343281, 61.370003, 95.099312,
--46.446545, 44.792114, -69.432770,
--30.099813, 28.777283, -132.904510,
--79.905426, 76.066498, -312.207184,
--268.561493, 254.915527, 32.996719,
--118.358566, 111.799194, 129.285294,
--93.337234, 87.041199, -120.826195,
--98.393631, 91.715347, -65.194420,
--13.359958, 12.363547, 22.970243,
--5.871396, 5.361691, 18.854467,
--12.318544, 11.197668, 33.409542,
--48.980602, 44.503174, -109.996132,
--52.721371, 47.771511, -135.609741,
--8.821604, 7.859485, -31.969828,
--29.573513, 26.080994, 1.594073,
--40.662563, 35.468239, -43.027550,
--30.415499, 26.497820, -30.856161,
--16.104965, 13.976655, 29.373491,
--66.670128, 57.852520, -138.779572,
--82.204285, 70.775238, -182.512054,
--22.832514, 19.355772, 22.394918,
--73.407043, 61.719673, -20.341457,
--56.516186, 47.219791, -12.397695,
--24.305664, 20.224291, -60.494267,
--43.197491, 35.908600, 38.451965,
--110.795128, 91.744614, -70.052574,
--73.165085, 60.251644, -135.414734,
--37.884003, 30.895899, -26.912523,
--45.747128, 36.829433, 28.876364,
--39.240051, 30.849787, -20.515766,
--42.278961, 33.154659, -8.181955,
--13.511616, 10.447927, -0.826070,
--137.469193, 106.204575, -125.986710,
--11.226272, 8.559726, -12.043207,
--31.592752, 23.975306, -61.151413,
--8.362055, 6.328407, 20.636473,
--75.814835, 57.275593, 40.270172,
--57.279877, 43.184437, 14.334065,
--112.295090, 84.634079, -2.907826,
--6.697612, 5.007170, 10.580510,
--34.962460, 25.818260, 32.040245,
--249.599747, 183.946228, -520.742920,
--8.986878, 6.620689, 30.387653,
--40.593513, 29.812111, 64.583504,
--43.662083, 31.995554, 44.814640,
--17.408484, 12.552207, -25.000376,
--40.403851, 29.062748, 326.258575,
--55.802120, 40.093533, 8.236951,
--68.284668, 48.502094, 6.811644,
--26.921228, 18.964340, -60.218365,
--69.199295, 48.518879, -1.685698,
--33.573917, 23.258099, 7.122653,
--114.881317, 79.485512, -61.008144,
--11.220690, 7.694154, -6.033639,
--177.826019, 118.542419, -410.682739,
--58.631504, 38.861927, 30.986511,
--175.412918, 114.893822, -451.163330,
--15.346772, 9.683575, 30.247570,
--68.671791, 43.128674, -21.495903,
--193.599228, 121.352600, -241.178238,
--66.645760, 41.602047, 108.390358,
--31.148535, 19.319319, 17.882639,
--79.012627, 48.320736, -45.037247,
--174.894592, 106.263763, -70.502411,
--294.706390, 175.571213, -482.131439,
--138.158661, 79.594231, 22.534349,
--72.581848, 39.768330, -19.205671,
--551.710022, 295.413605, 188.501938,
--20.126915, 10.766104, 16.128271,
--73.115959, 38.915207, 14.601178,
--77.779961, 41.383221, -0.571461,
--20.539488, 10.878042, 4.926386,
--181.750381, 95.686752, -261.122406,
--30.507395, 15.781466, -7.522799,
--34.659996, 17.330345, -106.687714,
--20.959986, 10.366138, -21.144775,
--65.762093, 31.829561, 31.642153,
--97.554535, 47.010948, -198.062500,
--27.185099, 13.098092, 28.055452,
--237.007690, 111.006447, -374.175964,
--18.078300, 8.455173, 7.056242,
--32.837055, 15.317512, 13.074932,
--216.739685, 100.017464, -354.469757,
--41.843777, 18.997299, -40.872074,
--52.019318, 23.616152, 50.542534,
--47.124428, 21.235516, -121.189980,
--34.868309, 15.500498, 83.989098,
--4.078426, 1.807402, -15.589643,
--48.348488, 21.043989, 35.294510,
--66.811646, 29.018734, -22.042223,
--88.451935, 37.932198, -57.983379,
--152.578827, 64.860901, -273.104156,
--33.026371, 14.038447, 26.756033,
--22.680836, 9.355937, -75.477562,
--6.649601, 2.732985, 10.650840,
--79.051636, 32.326962, -283.262726,
--11.987874, 4.881757, -17.631092,
--67.041878, 27.078262, -134.200638,
--1607.512817, 642.867859, 283.714752,
--24.282265, 9.659001, 22.260876,
--18.141699, 7.046436, 76.425217,
--23.351093, 9.025621, -124.245644,
--211.170517, 81.496040, -356.089233,
--122.124603, 46.128784, -67.705345,
--16.528748, 6.237099, -19.776556,
--147.340851, 55.415451, -37.456940,
--61.789398, 22.922953, -19.993940,
--115.621895, 42.815601, 76.971977,
--272.977142, 101.044716, -487.959045,
--146.481812, 53.817287, -227.940842,
--56.848038, 20.065161, -126.200432,
--54.910206, 19.187029, -121.371590,
--151.737000, 52.589283, -284.616913,
--61.593018, 21.173424, -133.308044,
--17.370493, 5.830162, -109.966690,
--21.915560, 7.251199, -26.951733,
--56.544334, 18.685459, -124.202202,
--38.887020, 12.331229, -11.847610,
--23.717508, 7.103113, 16.835571,
--14.702033, 4.390357, -25.388475,
--57.204941, 16.950733, 56.008186,
--77.284523, 22.301872, 37.082005,
--46.767738, 13.252315, -36.812767,
--49.002785, 13.180877, -16.781267,
--44.740334, 11.955894, -42.029705,
--101.114273, 26.828543, 6.613830,
--44.483479, 11.764006, 4.918564,
--152.531448, 39.569614, -6.837392,
--13.048848, 3.384391, 20.276373,
--34.473076, 8.862458, 13.081776,
--17.403656, 4.360952, 33.392719,
--27.892643, 6.822643, 3.696871,
--51.064171, 12.131954, -100.498718,
--913.633118, 208.453094, -1558.077881,
--31.343269, 6.996816, 31.557465,
--73.512390, 15.740191, -31.641724,
--1863.993286, 391.103333, -3341.476807,
--16.238697, 3.295914, 6.203118,
--51.460072, 10.413399, 14.491117,
--1841.503784, 364.593872, 800.541321,
--58.728634, 11.239542, -3.815927,
--106.468010, 19.502485, 70.544930,
--43.408947, 7.823727, 34.692062,
--56.820366, 10.187247, -15.229380,
--56.398453, 9.689166, -80.199455,
--64.317917, 11.012132, 6.892254,
--108.002754, 17.673111, 103.791245,
--209.722290, 33.956619, -155.291931,
--23.533789, 3.735513, 4.429111,
--108.425339, 16.877146, -21.050200,
--24.205236, 3.738186, -7.808928,
--188.380890, 26.527895, 9.491626,
--183.381668, 23.886522, -9.703008,
--35.883492, 4.500565, 95.864326,
--23.130943, 2.812096, -13.055408,
--33.431534, 3.956243, -20.919889,
--82.459045, 9.117450, -115.300858,
--56.677330, 6.011506, -111.955223,
--91.617340, 9.353622, -15.911053,
--54.333328, 5.483330, -0.785280,
--124.224541, 10.751545, -86.482567,
--104.352783, 8.719541, -197.692352,
--362.770844, 26.131060, -698.366455,
--101.724030, 6.773162, -33.816441,
--36.188763, 2.326995, 5.263240,
--15.511584, 0.975263, -36.138687,
--95.165291, 5.879117, 10.913648,
--40.309113, 2.456191, 44.504948,
--64.081261, 3.775095, -116.661079,
--7.013576, 0.412462, -6.000792,
--65.075691, 3.414150, 24.000586,
--52.077518, 2.674244, -121.753319,
--10.722375, 0.512003, 2.790618,
--62.146309, 2.799007, -126.361931,
--150.887863, 6.624980, -420.104065,
--10.886206, 0.442558, 0.335805,
--100.204391, 3.873173, -100.888214,
--43.474457, 1.545786, -94.172264,
--92.893166, 2.874918, -62.470650,
--15.180115, 0.408838, 20.668732,
--22.807037, 0.037001, -109.379349,
--108.442863, -0.413171, 12.574968,
--31.647491, -0.418198, -62.964962,
--104.233582, -1.965278, -206.077576,
--51.789913, -1.177805, 7.957414,
--8.437230, -0.253391, -17.787703,
--72.984955, -2.576628, -89.102730,
--76.685715, -2.798227, -93.828827,
--13.405499, -0.492291, -6.178163,
--85.783875, -3.792441, -35.778065,
--63.986645, -3.256131, -83.101067,
--57.774235, -3.823672, -95.413155,
--13.556302, -0.913728, 20.948322,
--48.090450, -3.322289, -15.237844,
--69.482452, -4.963069, 30.934929,
--78.489281, -5.661606, 51.224720,
--34.642582, -2.662145, -85.826523,
--15.341258, -1.230898, -81.547928,
--48.383789, -3.900984, -99.536812,
--76.275856, -6.641926, -0.891016,
--86.998688, -7.746276, 5.055624,
--104.898293, -9.508754, 33.802349,
--34.389980, -3.215015, -60.804668,
--75.073929, -7.395900, 36.542885,
--74.488159, -7.837135, 94.371544,
--74.075485, -8.571224, 38.436012,
--75.860092, -8.820848, -95.842072,
--44.189339, -5.151772, -87.688309,
--45.602692, -5.385082, 24.692696,
--76.661163, -9.069510, 39.037907,
--86.265938, -10.607481, -104.432793,
--25.616156, -3.357236, -7.660144,
--14.504649, -1.984663, -22.640577,
--17.314722, -2.439185, -5.078693,
--30.162369, -4.301939, -94.515503,
--52.184807, -7.679010, 143.270523,
--6.215343, -0.922002, 5.531104,
--38.880314, -5.877880, -17.013445,
--56.573959, -8.640468, 157.424210,
--102.053947, -15.640130, 43.038662,
--32.941040, -5.392047, -87.575027,
--26.368189, -4.377691, -30.255672,
--95.292404, -16.479935, -13.583535,
--82.113083, -14.432959, -69.925682,
--25.823339, -4.730163, -30.157938,
--11.631422, -2.138264, -0.299257,
--35.708378, -6.599375, 6.557209,
--157.559433, -29.161585, -274.054169,
--37.387566, -7.029435, -43.475727,
--18.170174, -3.666383, -33.414604,
--34.854965, -7.135864, -88.539017,
--65.635185, -13.466741, -101.186615,
--53.383301, -11.279309, -93.329330,
--96.406670, -21.676004, -66.648666,
--81.376472, -18.674631, 43.538521,
--59.354229, -14.007851, -70.014801,
--90.154167, -21.351505, 36.019585,
--35.347649, -8.394234, -30.678804,
--13.505998, -3.244198, 20.561922,
--122.579216, -29.628380, -21.191559,
--60.963684, -14.803380, -97.263596,
--55.003185, -13.371130, -94.755287,
--60.149094, -14.887632, 3.678742,
--25.717844, -6.415836, 20.946922,
--84.585426, -22.239668, 27.424074,
--228.527145, -61.527386, 140.996841,
--13.343756, -3.620818, 20.783722,
--29.650511, -8.247805, 5.959507,
--8.490358, -2.365078, -26.415861,
--41.702583, -11.870600, -50.815941,
--80.655327, -23.997986, -94.991188,
--77.877129, -23.405401, -96.589806,
--78.903358, -23.814247, 43.133137,
--62.112106, -19.302578, -27.767017,
--120.779770, -38.052849, -12.280160,
--13.027353, -4.107038, 4.314431,
--7.697863, -2.496807, 4.280510,
--15.387847, -5.004106, -12.552741,
--50.580799, -16.506416, -91.861061,
--116.206558, -38.722305, 103.337967,
--8.772385, -2.946147, -15.463877,
--44.304623, -15.093303, -115.235443,
--135.288666, -47.388870, -334.189545,
--62.907589, -22.135975, 57.103645,
--155.708252, -54.837193, 15.807938,
--7.624436, -2.715548, -2.678049,
--35.049015, -12.570227, -15.936948,
--13.525926, -4.963249, -10.743965,
--49.326447, -18.597853, -95.056656,
--12.857498, -4.930617, 19.611902,
--31.630249, -12.142889, -71.146790,
--73.479073, -28.645859, -15.560351,
--13.300187, -5.187102, 20.378998,
--70.644447, -28.346617, -21.788988,
--16.294970, -6.619393, 4.313612,
--274.032043, -114.973694, -244.164886,
--121.202866, -51.426212, -14.432576,
--51.431236, -22.398109, 3.587332,
--35.101143, -15.345571, 44.094143,
--20.556580, -9.012572, -0.233466,
--32.481220, -14.257545, 26.908058,
--43.162560, -19.547993, 34.799564,
--62.170872, -28.953732, -92.569992,
--88.074730, -41.415821, 137.365768,
--43.456234, -20.668680, -67.611343,
--14.461311, -7.185955, -10.504212,
--43.937962, -22.063950, -61.662178,
--13.277451, -6.711815, 4.678512,
--17.951738, -9.101768, 23.411104,
--39.823814, -20.608742, -30.761063,
--64.297691, -33.285446, 20.484831,
--96.527870, -49.984516, -96.807793,
--105.786224, -54.844208, -109.087486,
--93.358803, -48.451374, 40.933048,
--62.551769, -32.518139, -23.089146,
--45.318794, -23.952629, 108.554153,
--134.907013, -71.573959, 104.741669,
--67.595726, -35.875900, -49.685356,
--153.441513, -82.627640, -108.592819,
--9.442415, -5.163430, 3.579740,
--70.037903, -38.639317, -86.648071,
--24.737072, -13.945583, -57.423634,
--92.060287, -52.229221, -95.639900,
--78.937576, -44.970222, -90.227646,
--57.704002, -33.870441, 1.804203,
--82.862640, -48.675922, -98.147507,
--68.266922, -40.947620, -139.977753,
--35.067814, -21.152262, 85.383522,
--87.778336, -53.815086, -90.071312,
--23.658300, -14.550576, -13.958303,
--12.804442, -7.899598, -11.079578,
--27.981682, -17.629562, 149.766083,
--28.026241, -17.840240, -44.797562,
--27.977680, -17.892326, 15.550795,
--134.150269, -86.157143, -46.627953,
--67.253174, -43.784882, 3.376807,
--56.416901, -36.951828, -12.224570,
--24.563290, -16.178446, 37.363235,
--8.820912, -5.931455, 3.699008,
--17.639299, -11.899511, -2.236205,
--15.424470, -10.420377, 23.290434,
--17.103264, -11.578287, 21.453392,
--45.855156, -31.514475, 39.701809,
--5.510435, -3.795465, -42.282070,
--45.741714, -31.764700, -13.237454,
--61.431129, -42.776836, -77.674614,
--45.957150, -32.106487, 16.400740,
--164.734848, -115.698013, -302.832947,
--48.931396, -34.439976, -46.556656,
--26.245192, -18.498375, -32.319336,
--36.768795, -26.376976, -73.725563,
--80.365906, -57.875206, -81.673515,
--38.456680, -27.709932, -24.942270,
--52.855244, -38.183201, 9.682813,
--7.253685, -5.328378, 11.458761,
--179.670166, -133.115540, -225.344055,
--54.365067, -40.294151, -68.571465,
--7.554901, -5.637869, -84.948654,
--20.890541, -15.674428, 102.431107,
--88.504051, -66.798012, -62.712818,
--33.022655, -24.930393, -1.609742,
--31.033865, -24.209475, 23.065662,
--16.144629, -12.622566, 16.189266,
--88.139519, -69.245750, -135.765549,
--10.483952, -8.390083, 7.673026,
--54.597847, -44.018551, -63.498016,
--47.772884, -39.341553, -72.270576,
--0.503598, -0.421285, -1.176707,
--0.503620, -0.421397, -1.176658,
--71.289024, -60.204453, 27.494928,
--41.008362, -34.761829, 13.133288,
--133.161880, -113.375687, 25.082727,
--86.546471, -73.871674, -123.690247,
--56.219006, -47.998684, -57.326138,
--5.265760, -4.517745, -14.861736,
--14.077450, -12.136262, -1.841247,
--184.394424, -159.478149, 121.698471,
--38.874115, -33.691063, -36.252384,
--38.988297, -34.187775, -36.568256,
--43.053619, -37.752857, 29.269686,
--49.617344, -43.605873, 20.150381,
--29.499979, -26.156773, 1.303037,
--17.819151, -16.025030, -123.805267,
--60.904396, -55.951084, -43.900600,
--7.783159, -7.176222, 37.301517,
--16.711752, -15.431911, -6.540483,
--48.620354, -44.950893, -2.658167,
--4.641615, -4.305263, 2.192338,
--66.327667, -61.656368, -86.163399,
--19.918571, -19.435059, -2.115010,
--35.535435, -34.794411, 111.349365,
--83.356400, -82.295746, -109.744026,
--87.030975, -86.396591, -110.823189,
--64.956116, -65.510101, -13.818680,
--35.812889, -36.426460, 43.460464,
--69.998970, -71.298981, 46.609577,
--39.237022, -40.243198, 2.052389,
--56.214939, -58.248398, -38.233799,
--47.391052, -49.267086, 34.752789,
--71.784195, -75.064354, -111.579689,
--12.244205, -13.050057, 8.294958,
--59.599377, -64.386162, -88.597427,
--24.674858, -27.388830, -42.017788,
--72.624481, -80.814857, -39.099365,
--14.628442, -16.287462, -28.120962,
--66.203285, -74.061745, -97.620300,
--196.897125, -223.772736, -182.791321,
--19.671221, -22.530033, 19.657949,
--31.599648, -36.675739, -7.999556,
--9.992716, -11.650061, -25.344360,
--33.086899, -38.619568, -102.493492,
--53.076435, -62.051682, -47.426380,
--38.718895, -45.548523, -66.103874,
--13.166849, -15.541132, -52.188290,
--29.402363, -35.267643, 139.934769,
--75.776932, -91.413506, -101.940994,
--51.392555, -62.237431, -59.205883,
--14.550794, -17.673494, -25.360340,
--69.640221, -84.994034, -108.696342,
--94.018265, -115.232628, -111.494423,
--50.339870, -61.820549, -134.380737,
--20.015289, -24.760710, -5.798647,
--18.500277, -22.946531, 22.516926,
--10.113280, -12.592969, 26.844040,
--55.890339, -69.848404, -71.754593,
--18.826128, -24.059715, 17.007662,
--33.736019, -44.533298, 248.909058,
--60.007774, -79.476509, 86.262512,
--48.725609, -65.209923, 49.609249,
--16.938759, -22.928085, -5.059277,
--12.123138, -16.486528, 10.299003,
--37.452740, -50.987213, 11.769777,
--77.350082, -105.628395, -114.478607,
--26.607359, -36.462944, -11.917342,
--55.420708, -76.201523, -94.086876,
--15.578424, -21.584091, -60.687946,
--30.736137, -42.704765, -28.135546,
--30.129105, -42.261024, -47.671467,
--68.485733, -96.597466, -67.753883,
--67.060272, -95.221001, 86.607658,
--35.577126, -50.699280, -42.427799,
--61.263691, -87.722969, -47.232006,
--7.093004, -10.242833, -12.312231,
--31.518597, -45.668137, 19.835627,
--65.380577, -95.082237, -41.267548,
--56.260391, -82.384979, -69.105316,
--22.481934, -32.939999, 19.706450,
--13.615164, -20.196280, 112.603180,
--12.454459, -18.510897, 2.512608,
--24.937033, -37.742573, 12.478886,
--6.415000, -9.733088, 1.504305,
--55.020073, -85.325500, 33.265968,
--24.554932, -38.393620, 22.295593,
--25.679474, -40.162018, -2.857283,
--11.482360, -18.165911, 1.682884,
--28.023012, -44.396198, -34.917118,
--76.910339, -121.871071, -69.514351,
--13.472453, -21.400568, 18.143448,
--60.209454, -95.671783, 43.342304,
--6.169613, -9.937963, 10.699847,
--62.976063, -102.378242, -56.886322,
--25.025362, -40.767635, -14.378406,
--2.853270, -4.708840, -11.009190,
--5.496971, -9.189305, 3.002756,
--56.039520, -94.086311, -61.238789,
--31.978111, -54.065765, 31.837511,
--9.921393, -16.808479, 27.617064,
--77.227486, -131.354675, -38.781326,
--63.781609, -109.206017, -61.994267,
--43.592091, -75.128494, -77.509743,
--59.228848, -102.713928, -93.963966,
--56.695641, -98.530632, -47.369911,
--46.170341, -81.145203, 53.578831,
--5.378237, -9.495858, 17.853678,
--24.587399, -43.588833, 21.041601,
--39.139809, -69.744576, 82.924706,
--21.279240, -38.080322, -50.590111,
--28.492039, -51.056019, -28.346622,
--61.494915, -110.261894, -100.793747,
--11.154994, -20.028605, -36.369709,
--73.327316, -134.264938, -55.093735,
--156.580902, -286.721771, -117.627831,
--12.686633, -23.485563, -26.855055,
--47.889683, -88.748329, -75.447678,
--57.603569, -106.989441, -45.840374,
--35.780380, -66.873726, -28.914518,
--53.400700, -100.512321, 34.899517,
--23.142406, -43.879551, 49.495579,
--12.982720, -24.668821, 20.620111,
--57.305225, -112.462616, -44.599640,
--22.587393, -44.330288, -8.830283,
--57.400364, -113.024384, -67.193062,
--34.826595, -69.455406, -109.454391,
--23.169176, -46.646481, -3.362598,
--37.200932, -75.800705, -170.738174,
--122.828560, -254.694290, -337.800903,
--3.174631, -6.619174, 28.915607,
--16.224659, -34.130112, -20.615709,
--14.100493, -29.669060, -2.696438,
--28.217600, -60.334591, 69.732613,
--10.600983, -22.693218, -30.015041,
--19.383236, -41.732437, -230.187759,
--138.366058, -298.890991, -147.810104,
--84.889496, -184.539017, -97.290916,
--23.489231, -51.495239, 19.658012,
--11.332949, -24.889177, 0.491168,
--20.018579, -43.976662, 28.908638,
--5.218013, -11.718720, 23.639977,
--20.836802, -46.857037, -18.702532,
--28.054491, -64.073578, 17.482893,
--44.418980, -101.653343, -48.113964,
--56.124352, -130.670654, -47.463203,
--32.586830, -76.016281, -90.431664,
--14.523699, -34.134422, -5.459107,
--21.313856, -50.202702, 140.379822,
--1.603450, -3.798826, -11.381153,
--32.003075, -75.985733, 73.930748,
--63.854786, -153.039322, -82.432320,
--41.655914, -100.824913, -51.137226,
--16.096575, -38.966831, 16.598692,
--19.295399, -47.113785, 1.763737,
--23.329182, -57.123589, -18.409517,
--70.942207, -174.234833, -130.284103,
--18.655254, -46.252640, -19.611834,
--35.441738, -88.394241, 19.355366,
--3.473696, -8.757673, -48.007946,
--375.990509, -955.530212, -993.181396,
--25.039543, -63.650543, 62.537327,
--41.660713, -108.364021, -62.291996,
--30.258904, -79.213623, -59.939930,
--48.826561, -129.145660, -25.756712,
--26.306479, -71.066269, 86.953606,
--30.301847, -84.303543, 188.570679,
--3.096057, -8.657821, 5.657066,
--38.321503, -107.579559, -36.538857,
--8.822829, -25.227806, 21.582552,
--3.440530, -9.864653, -47.189877,
--4.689202, -13.872888, 22.362717,
--4.673062, -13.960114, 105.245308,
--13.963737, -43.403709, -118.949440,
--11.340306, -35.553490, 38.621864,
--14.903817, -47.114864, -82.376411,
--10.949686, -34.639866, -6.918878,
--4.971860, -15.809793, -11.302298,
--58.102829, -189.662918, -155.242355,
--36.328480, -119.450958, -97.607262,
--20.037457, -67.654373, 12.651692,
--9.601040, -32.719044, -31.093515,
--1.748068, -6.098512, 13.688874,
--6.976380, -25.016586, 4.287877,
--26.059214, -94.964211, -145.940231,
--14.573915, -53.998417, -74.656540,
--11.026625, -41.361240, 25.645491,
--31.277035, -118.925774, -9.078796,
--29.888105, -117.967224, 30.549721,
--161.792969, -658.983093, -459.811676,
--10.153072, -41.790390, 9.724063,
--9.493886, -41.776646, 94.948784,
--5.333755, -24.248083, -6.990532,
--3.314089, -15.642885, -15.035923,
--22.324711, -111.339035, 29.135416,
--4.257937, -21.421783, 10.110209,
--17.551567, -88.333412, 67.396126,
--12.570622, -65.604774, -0.518979,
--41.136066, -218.365402, 144.855072,
--7.966281, -42.640923, 33.035343,
--9.835967, -56.984615, -13.187801,
--2.748220, -15.995189, -6.266516,
--5.970614, -35.671570, -88.496834,
--25.828434, -154.384872, -72.989670,
--15.490553, -96.935127, 74.365395,
--15.779346, -103.419998, -152.388336,
--29.021385, -190.737122, -290.141357,
--3.423721, -23.164646, -10.511432,
--52.233074, -354.950806, 25.971127,
--4.342216, -29.613087, -2.664047,
--4.207364, -29.337099, -17.019268,
--8.722000, -67.231323, 87.720398,
--12.875795, -100.296959, 49.561417,
--16.090040, -125.445869, -96.332153,
--3.535006, -27.884279, -50.053341,
--14.859746, -118.524529, -53.090183,
--5.867672, -47.517559, -56.809158,
--2.098027, -17.194723, 24.908705,
--0.403431, -3.311345, 55.923004,
--2.112298, -17.369064, 25.149456,
--19.749361, -170.746231, -130.012970,
--1.525532, -13.892244, 3.113856,
--8.624136, -80.899040, -85.749588,
--3.524540, -34.322189, -27.577522,
--0.853510, -8.458243, 21.868919,
--6.026968, -60.700657, -56.878273,
--3.043460, -31.021538, -8.584847,
--16.085848, -165.884781, -23.775206,
--9.445604, -105.135651, 109.333801,
--1.215720, -14.177485, -16.610748,
--4.068314, -50.059475, -11.480047,
--0.531786, -6.733869, 20.975309,
--8.435199, -110.177887, -89.576981,
--1.177580, -16.259899, -6.481973,
--1.805475, -24.993320, 2.001593,
--3.021911, -48.481945, -102.873665,
--0.438971, -7.422654, 3.907515,
--15.833670, -291.428406, -154.079697,
--22.747610, -419.503510, -354.112000,
--1.532360, -28.979959, 1.372356,
--7.480771, -158.255676, -97.862007,
--1.373463, -31.015100, -23.431324,
--37.218765, -868.554077, -731.813416,
--0.527440, -18.670086, 28.621191,
--2.672158, -163.427139, 124.291840,
--0.417190, -28.171822, 35.406700,
--1.066580, -76.156334, -74.434738,
--0.352944, -36.172146, 20.256618,
--1.204007, -125.237404, -111.651367,
--1.377518, -210.817200, 122.648300,
--0.196043, -46.158222, -7.950872,
--0.984887, -247.507812, -144.360825,
--0.110838, -122.469398, -54.056351,
-0.047959, -192.669327, 57.990356,
-0.237630, -206.865952, 15.803612,
-0.048689, -23.148329, -1.492947,
-1.222422, -434.211914, 22.236320,
-0.882055, -134.167984, 53.110329,
-0.621233, -81.211319, 1.850243,
-12.133059, -553.794922, -314.420074,
-0.120897, -5.079664, 0.222062,
-0.643873, -25.398581, -14.920146,
-4.596508, -174.608566, 71.348312,
-5.764205, -199.160126, -238.220337,
-0.949772, -31.854000, -30.162527,
-2.297814, -72.057060, 11.075406,
-0.802561, -25.015089, 4.216833,
-2.637199, -80.784393, 76.600647,
-3.071857, -93.306427, 51.243828,
-3.304878, -93.670372, -50.799503,
-0.704963, -18.822094, -38.056866,
-16.687820, -436.473328, 166.048920,
-4.267116, -87.017189, -90.073410,
-3.506591, -68.498650, -30.109846,
-8.174783, -157.260498, 96.141777,
-509.179291, -8468.451172, -3266.603271,
-2.814937, -36.523418, -27.365446,
-15.040096, -190.537903, -97.565102,
-5.103415, -58.739723, 42.939087,
-10.709398, -120.600609, 48.822784,
-2.565791, -28.251566, 83.991241,
-7.495366, -82.091515, 4.864424,
-7.437297, -80.963905, -46.616550,
-0.219234, -2.381464, 7.694267,
-1.756352, -18.829870, -0.957068,
-6.222334, -61.186001, -113.243088,
-5.960144, -57.529701, -9.092824,
-3.773556, -36.366867, 14.601857,
-3.116530, -29.763231, 49.414764,
-3.852837, -36.393887, -25.043949,
-18.932007, -170.456924, -64.265106,
-4.552538, -39.983273, 88.562325,
-6.239763, -52.771202, -54.966034,
-2.605613, -21.243076, -10.172276,
-3.210644, -25.389051, -29.512146,
-10.989326, -85.792290, -22.474689,
-9.321791, -67.669182, -129.987747,
-23.438221, -168.063248, -175.196426,
-68.193253, -476.535828, 742.569824,
-28.647745, -194.573837, -179.035461,
-8.089544, -52.244301, -7.659030,
-0.970212, -5.967750, 4.858237,
-10.385627, -55.664696, -9.021809,
-3.823573, -20.122305, -60.959660,
-29.934322, -155.737076, -23.065483,
-21.602861, -110.307671, -80.597198,
-7.362666, -37.580791, 31.759430,
-7.288423, -37.166893, 31.346771,
-7.243778, -36.606995, 28.743053,
-2.445492, -12.170038, -26.464577,
-12.471088, -61.772041, -32.096684,
-3.538899, -17.526443, 6.701883,
-13.769560, -67.567123, 34.624035,
-5.503478, -26.447220, 8.871870,
-43.062668, -206.243347, -17.499037,
-48.934082, -220.363632, 148.631561,
-11.147877, -49.067482, 85.043282,
-58.549080, -252.511414, -491.377594,
-15.072628, -63.729851, 80.034309,
-122.701927, -509.428894, -219.674759,
-7.961520, -32.911449, 100.020485,
-51.900383, -214.102051, 165.399643,
-32.544937, -133.636292, 57.380249,
-18.208885, -74.248138, -31.933983,
-14.724646, -59.874367, -30.468904,
-18.451654, -74.931541, 74.381432,
-9.793657, -39.120674, 2.963996,
-10.608562, -42.356853, 3.208143,
-15.862445, -62.514927, -153.681641,
-15.543943, -61.136654, -6.459019,
-26.543018, -103.136002, -41.107841,
-24.767761, -94.978539, -129.965836,
-6.046077, -23.077225, -18.046864,
-41.648968, -158.351639, 105.075272,
-11.705273, -43.973747, 12.251335,
-103.391861, -385.771759, 250.976883,
-7.081734, -25.780643, 28.605316,
-12.052969, -43.697952, -4.555688,
-6.390192, -22.805599, -13.607944,
-11.367496, -40.229557, -37.766861,
-11.012635, -37.978577, -15.769148,
-6.976642, -23.777296, 6.115701,
-10.902999, -36.661518, -3.267168,
-4.079981, -13.682252, -10.783493,
-9.413736, -31.307791, -17.141953,
-11.967814, -38.932884, -34.783260,
-9.365088, -29.942934, -24.427181,
-37.755932, -120.178108, -48.414474,
-36.239395, -114.885597, -98.743073,
-3.636220, -11.100000, 28.425116,
-78.372635, -235.055069, 201.692734,
-8.408621, -25.160131, 41.971741,
-29.598440, -86.523964, -43.141865,
-4.267313, -12.471811, 44.091072,
-84.909729, -245.838058, 101.877510,
-60.678658, -175.307938, 145.636551,
-7.438332, -21.269753, 30.305365,
-51.607342, -146.476059, -53.331772,
-16.189241, -44.151249, -4.458392,
-9.765374, -26.588825, 62.775955,
-12.395724, -33.298679, -11.440105,
-172.124908, -462.046173, -140.965302,
-29.213678, -77.477257, -81.252617,
-10.715405, -28.201935, -29.958752,
-14.150097, -36.917202, -33.905285,
-74.104530, -192.731659, 117.402672,
-5.594392, -14.294328, 0.835248,
-1316.419556, -3319.894043, 21.104376,
-31.184137, -76.503227, 37.937695,
-8.873055, -21.499516, 29.481600,
-40.258007, -96.332634, 55.419662,
-61.815044, -146.030746, 108.794167,
-0.785759, -1.843455, 5.407297,
-13.416681, -30.824209, 4.353818,
-70.415390, -160.827148, 63.115868,
-32.912025, -74.606956, -90.879265,
-4.860026, -10.859337, 14.289924,
-21.550474, -48.004337, -24.406939,
-38.596272, -85.959564, -2.116179,
-181.786606, -404.065460, -54.618397,
-27.946093, -60.358597, 38.639565,
-58.383808, -125.067154, 44.883652,
-58.235088, -123.407829, 42.962570,
-29.856466, -61.028252, 51.858257,
-16.358644, -33.181538, 37.164021,
-62.084785, -124.170532, 26.013979,
-26.460918, -52.862179, -21.237165,
-7.769632, -15.511139, 11.582414,
-58.816666, -116.200600, 43.663685,
-6.852737, -13.424598, 42.021481,
-2.361666, -4.499359, 0.792779,
-81.607582, -154.998428, 72.952148,
-169.503387, -317.209137, 6.313487,
-47.769768, -88.476227, 44.934387,
-29.630404, -54.432434, 9.219761,
-20.819420, -37.846382, -38.713577,
-6.568501, -11.934152, 1.529904,
-26.078085, -47.225563, 70.150887,
-10.327597, -18.662758, -10.541668,
-139.880280, -252.707809, 229.643188,
-70.608353, -127.481598, 241.064819,
-16.995062, -30.563389, 24.562799,
-160.935486, -287.526794, -169.122223,
-39.235893, -68.818230, 28.040064,
-46.460373, -81.327553, -46.079388,
-77.154305, -133.990997, -109.378632,
-4.802790, -8.269449, -31.104630,
-30.412619, -52.097061, 31.742985,
-34.315758, -58.404896, -114.431808,
-62.021645, -104.604317, -63.872898,
-23.980352, -40.380531, 115.505508,
-50.295238, -84.073166, -76.377975,
-43.536510, -72.223969, -52.811134,
-122.469635, -197.165649, -306.685333,
-1.313523, -2.087905, -5.587333,
-11.382674, -18.059889, 98.002785,
-113.013474, -178.378311, 158.199661,
-47.714390, -73.964203, -1.262057,
-82.631599, -125.674217, 160.254028,
-14.146721, -21.496107, 38.978779,
-156.564285, -237.370682, 302.185547,
-25.122635, -37.856888, 12.342115,
-18.197361, -27.354753, 24.583885,
-184.533524, -275.484222, 158.808578,
-127.535721, -190.022446, 251.631958,
-49.682922, -73.818138, 46.942287,
-116.152542, -169.561050, -45.595699,
-856.787476, -1249.121582, 1184.835693,
-18.429602, -26.801794, -7.237719,
-46.888458, -66.552788, -18.435009,
-58.869438, -83.290054, -26.912651,
-207.376846, -290.119690, 301.968689,
-38.920521, -53.638393, 41.717411,
-18.291574, -24.799324, -46.974239,
-17.427738, -22.947630, -9.259153,
-121.727127, -159.507294, 117.572166,
-11.471194, -15.006347, 37.061569,
-35.525562, -46.444778, -2.947294,
-106.641464, -138.904037, 201.107864,
-66.864700, -84.655724, 21.562506,
-144.756668, -182.141953, 164.432358,
-42.236908, -52.481243, 17.640818,
-8.503273, -10.540154, -24.015812,
-426.457733, -523.228210, -30.060661,
-18.336155, -22.333157, 7.524285,
-13.363544, -16.273903, -22.813284,
-18.084711, -22.019171, -52.544216,
-74.952545, -90.652069, -2.268950,
-38.943150, -47.023361, 23.683287,
-45.534512, -54.440514, 20.233322,
-451.137695, -530.873352, 703.522766,
-39.411156, -45.554043, 16.224445,
-9.780043, -11.247039, -19.022701,
-66.652763, -76.086304, 47.751785,
-11.218381, -12.796703, -38.590572,
-4.469333, -5.083404, 12.643149,
-9.604218, -10.917515, 22.895136,
-35.902210, -40.700615, 32.249866,
-8.795377, -9.932968, -6.263095,
-12.154128, -13.712736, 12.345357,
-19.869848, -22.329153, 8.641258,
-67.246712, -75.225372, 69.021271,
-144.583984, -161.412170, 160.294556,
-46.370441, -51.646431, -11.609671,
-90.819542, -101.098106, -11.955752,
-321.353424, -353.974152, 497.049805,
-57.843990, -63.412716, -89.588715,
-65.513733, -71.515732, -64.877571,
-117.070038, -125.738380, -87.231674,
-40.338974, -43.209560, 30.245703,
-32.160393, -34.291264, -7.431962,
-75.300903, -79.875443, 107.450768,
-66.815689, -69.912704, -157.527039,
-57.328167, -58.759903, 71.783913,
-164.538223, -164.788422, 254.318710,
-41.215057, -40.753307, -36.581848,
-187.764069, -179.853470, 250.452011,
-33.607845, -31.907631, -14.374254,
-147.555496, -139.290848, 222.597824,
-105.840431, -99.453308, -67.741852,
-36.208084, -33.297005, -9.893244,
-25.608490, -23.395815, 6.198579,
-29.808571, -26.620047, 23.285309,
-12.377021, -10.874518, 12.892695,
-42.892166, -37.343697, 5.223766,
-814.381653, -699.145325, 881.470703,
-172.232315, -147.207169, 158.039017,
-32.565529, -27.828960, -26.946856,
-5.249266, -4.460515, 13.280948,
-13.578913, -11.407721, -23.922865,
-33.242897, -27.706842, -37.366852,
-34.271362, -28.229656, 15.989119,
-48.857265, -40.186722, -19.141382,
-3.010872, -2.385499, -8.377922,
-88.543358, -70.010735, -46.551159,
-47.964397, -37.252102, 172.079300,
-40.341980, -31.314457, -20.433662,
-98.596672, -75.691437, 54.405693,
-148.913376, -112.664474, -18.214235,
-21.468493, -15.888576, 27.266251,
-49.402695, -36.298321, 48.822617,
-155.564423, -111.907562, -67.733261,
-44.132099, -31.551609, -7.483665,
-529.279480, -377.808777, 1227.247437,
-33.431458, -23.389610, -12.211647,
-3.804350, -2.627521, -20.666595,
-14.232248, -9.789054, 51.065922,
-266.321136, -182.876022, 401.662140,
-69.642044, -47.570305, -28.820045,
-692.075745, -468.977509, 1379.328857,
-16.290009, -10.973274, 10.772515,
-168.495026, -113.452782, 35.360699,
-218.924362, -146.956528, 82.378082,
-26.421572, -17.713583, 15.271487,
-43.755062, -29.250994, -34.212994,
-628.273315, -418.021454, 1368.187500,
-193.231384, -126.937210, 268.880585,
-9.499482, -6.225875, -3.283993,
-42.161564, -25.854979, -37.765278,
-27.999796, -16.506779, -46.406662,
-1.734636, -0.968555, -3.033693,
-101.933022, -56.902000, -4.393556,
-11.680021, -6.488602, 28.174088,
-70.656410, -38.491859, 7.121897,
-204.268112, -111.158211, -1.298139,
-51.354656, -27.849916, -48.231651,
-45.189182, -24.424341, -12.683172,
-9.359470, -5.028607, 5.032547,
-18.747997, -9.944233, -22.726517,
-29.638371, -15.695605, -21.770061,
-118.503548, -62.723133, -90.586632,
-31.128979, -16.238203, 110.287018,
-57.282574, -29.823376, 42.225754,
-14.016758, -7.285673, -10.082692,
-26.124392, -13.570963, 3.196950,
-104.299080, -53.801430, 189.288239,
-118.865501, -59.342949, 110.357132,
-12.556112, -6.190082, 21.592474,
-54.195602, -26.545828, -53.104053,
-136.660202, -66.676163, 117.730743,
-52.352486, -25.298933, -7.947518,
-27.296923, -12.946503, -52.879478,
-97.614998, -44.987984, 113.408363,
-148.954819, -68.415382, 88.371902,
-264.446014, -121.187462, 62.920544,
-43.980141, -20.122906, -1.171336,
-29.102970, -13.024391, 41.148907,
-385.831573, -170.742188, 493.596344,
-309.301605, -135.650146, 8.120851,
-31.861380, -13.634220, -74.206367,
-44.981499, -19.126425, 4.015501,
-29.239260, -12.286547, -0.011106,
-145.530960, -60.898735, 256.586090,
-60.681717, -25.362177, -62.402386,
-221.846893, -92.424988, 264.182861,
-66.443504, -27.604242, -68.874832,
-283.578613, -116.755692, 287.215057,
-73.957687, -30.389967, -15.076270,
-18.572781, -7.570948, 24.143248,
-35.590233, -14.468914, -24.330660,
-36.480469, -14.554184, -73.812767,
-52.479855, -20.314634, -0.115269,
-30.707901, -11.576849, 41.324585,
-236.655579, -87.000435, 204.546143,
-62.289482, -22.513739, 64.580841,
-191.281982, -69.002090, -103.805618,
-59.147991, -21.102003, 12.015310,
-76.792282, -27.285322, 45.747616,
-33.642536, -11.803605, -38.079197,
-53.740337, -18.766394, 33.158192,
-48.168251, -16.703405, -44.969185,
-132.891098, -46.025787, -47.959347,
-68.171417, -22.931997, -97.201759,
-6.118022, -2.045218, -42.561703,
-105.315598, -34.967144, 48.401943,
-15.078448, -4.994699, 3.426758,
-11.261257, -3.687140, 98.694786,
-23.644247, -7.619421, -31.025940,
-107.981689, -34.258045, -27.391085,
-13.607652, -4.311252, 32.365219,
-31.024834, -9.781848, 14.894724,
-69.655769, -21.285124, 68.666199,
-54.786392, -16.612492, -37.001678,
-113.892250, -34.486774, -15.834913,
-11.318715, -3.330935, 119.177872,
-45.169815, -13.240538, -13.338008,
-82.162834, -23.859970, 13.269563,
-42.335907, -12.149989, -28.102606,
-357.264648, -101.713440, 438.532715,
-6.437051, -1.795832, -3.799763,
-20.186684, -5.325901, -27.459307,
-151.955978, -39.354507, 142.961319,
-52.281689, -13.090506, 28.756367,
-146.225082, -36.541538, 10.063961,
-34.238766, -8.508036, 42.122196,
-40.115448, -9.860665, 11.227721,
-167.797974, -39.809940, 291.836487,
-51.426014, -12.185009, -23.246925,
-28.793928, -6.796047, -28.095139,
-94.796310, -22.319725, 16.139183,
-144.792496, -34.019234, 70.842224,
-16.573681, -3.834161, 65.249802,
-65.179298, -14.615279, -25.872263,
-39.001926, -8.582778, -40.280441,
-15.600143, -3.276896, 18.602135,
-66.399673, -13.411966, -7.177843,
-44.115307, -8.597533, -7.189168,
-191.239502, -36.438339, -26.413345,
-39.364651, -7.445455, 2.297539,
-11.395762, -2.141402, -18.727379,
-129.466095, -24.144987, 151.583252,
-95.812302, -17.799561, -15.753159,
-23.691452, -4.324327, 59.942539,
-45.478180, -8.259923, -29.482903,
-74.061028, -13.405473, -12.744535,
-46.251842, -8.022949, 20.645779,
-46.020947, -7.500826, -17.063820,
-108.662819, -16.803705, 209.279999,
-48.182404, -7.334726, 21.094643,
-87.564003, -13.068169, -33.351505,
-49.173504, -7.144768, 1.089301,
-47.912292, -6.740133, 5.409269,
-52.698025, -7.135739, 12.043405,
-91.237427, -11.998671, 150.456055,
-42.914150, -5.084967, -33.542679,
-91.136658, -10.675031, -35.066292,
-142.641693, -16.281891, 87.377594,
-61.373402, -6.701012, -56.801170,
-17.696756, -1.738158, 18.711506,
-42.911015, -4.160413, -43.859566,
-111.686279, -10.687116, 105.610596,
-2.942366, -0.265839, 13.472992,
-39.605503, -3.502650, -10.077126,
-13.672235, -1.199349, 1.352338,
-37.079407, -3.177630, 36.360020,
-187.185150, -14.926307, -60.349121,
-30.773703, -2.415457, 0.959516,
-45.614471, -3.445500, -11.868430,
-62.503056, -4.373209, 35.249390,
-276.338745, -16.860456, 290.930115,
-232.258682, -13.806615, 14.177116,
-27.510990, -1.555389, 45.234215,
-38.752773, -1.874201, -20.742363,
-1918.383179, -47.018410, 3012.091797,
-21.123484, -0.222797, -43.890038,
-120.055458, -1.173864, 56.346802,
-68.453926, -0.396193, -4.253821,
-262.957184, -1.137228, 386.279572,
-32.255653, -0.097108, 3.882586,
-47.470577, -0.017580, -104.537117,
-1.688885, 8.826471, 9.308075,
--5.384182, 12.291923, 8.350214,
--9.299857, 10.632949, -19.956192,
--11.226861, 8.559062, -12.043131,
--8.730985, 1.609890, 5.448405,
--8.730985, 1.609890, 5.448405,
--11.631287, -2.139010, -0.299218,
--12.961219, -4.971058, 19.767132,
--11.530508, -20.880980, -4.798419,
--11.530508, -20.880980, -4.798419,
--5.335027, -24.247421, -6.991861,
-4.079381, -13.682763, -10.783071
-};
\ No newline at end of file
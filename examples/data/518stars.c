@@ -1,521 +0,0 @@
-// 518 stars
-float _518_stars[] = {
-25.990032, 0.951437, 14.470105,
-8.555331, 0.342427, 14.334859,
-29.950174, 1.230281, -30.767408,
-98.414948, 5.690009, 26.753136,
-87.443718, 7.430486, -13.623164,
-1.638744, 0.184201, -7.290789,
-16.901623, 1.940784, -16.246269,
-17.435064, 2.008142, -15.972442,
-106.518188, 17.333809, 147.977707,
-26.275408, 4.553503, 15.935397,
-38.038025, 6.793835, 58.461533,
-27.437685, 5.282069, -9.071561,
-3.098176, 0.673883, 5.038080,
-89.141045, 22.518227, 163.949677,
-31.706820, 8.015939, 26.013559,
-39.931870, 11.844490, -44.228069,
-46.729633, 14.372416, -70.463585,
-33.916454, 10.464482, -6.374839,
-47.405479, 14.885503, 35.600159,
-32.445164, 12.458461, -4.997577,
-14.082442, 5.533743, 26.457554,
-48.360588, 19.628767, -49.214024,
-27.262018, 11.466853, -34.110416,
-80.120163, 33.795986, 23.863348,
-21.725090, 9.867803, -37.077293,
-32.059631, 14.609014, 40.002121,
-3.151621, 1.538603, -1.001653,
-69.079262, 36.521645, -14.249583,
-15.056807, 8.097229, 9.703738,
-52.028908, 28.111221, 20.702824,
-52.767460, 28.768179, 121.443840,
-14.984444, 8.190080, 6.489631,
-9.498562, 5.262280, -13.705148,
-9.041969, 5.155593, -19.226034,
-74.545639, 43.040573, -33.176647,
-36.696106, 21.625727, 2.056206,
-12.885702, 7.699454, 47.380848,
-68.972282, 41.401226, 73.275047,
-15.757537, 9.767368, 8.046751,
-26.366255, 16.723177, 21.851988,
-24.462378, 16.579145, -37.167130,
-1.339647, 1.044621, 132.264221,
-18.991888, 16.408123, 1.419101,
-32.050503, 29.364540, 22.398111,
-168.261581, 155.126755, 337.965942,
-33.343739, 31.713358, 60.542503,
-28.967106, 28.077629, -6.315605,
-26.870634, 26.466131, -31.990742,
-47.115772, 48.062527, 4.812555,
-32.362141, 33.745899, 63.201557,
-53.657631, 56.137218, 62.527916,
-14.645698, 15.728803, 18.653234,
-16.524990, 17.954088, 24.280577,
-8.257044, 9.176118, -6.839448,
-47.386776, 56.231846, -29.349659,
-73.499161, 91.025482, 138.745102,
-40.129223, 49.916916, 10.177399,
-41.526802, 52.756313, 11.515882,
-1.899908, 2.542904, -0.528817,
-61.216824, 89.845474, 119.847870,
-5.007815, 7.372184, -1.533830,
-7.267914, 10.794681, -27.663704,
-213.461685, 317.421417, 241.710129,
-57.670769, 86.208900, 46.425533,
-69.722847, 104.539124, 115.460800,
-55.556568, 83.798965, 45.540119,
-9.763154, 14.924950, -63.191349,
-56.241905, 86.179871, 46.044415,
-57.579388, 89.656578, 47.560078,
-133.508514, 218.147964, 159.095230,
-64.217766, 108.861153, 106.093224,
-33.450344, 56.803757, -15.836289,
-222.144608, 380.783936, 317.842743,
-55.125313, 96.137802, 24.548878,
-19.229881, 34.392418, 4.134029,
-53.339314, 101.018707, 125.599144,
-11.850987, 23.769753, -24.162779,
-10.282566, 20.719511, -44.384434,
-19.600603, 41.044495, -30.447258,
-19.262455, 41.210888, 12.724867,
-18.406237, 40.828827, 14.157565,
-28.201946, 63.369469, -46.814949,
-18.075920, 42.882431, 13.310910,
-17.428921, 41.368534, 15.615283,
-17.052547, 40.497761, 12.492988,
-11.314197, 28.721037, -44.159611,
-19.856333, 51.426281, -32.552822,
-6.865749, 17.867243, 5.673362,
-64.110977, 167.712204, -10.517603,
-11.348306, 30.425724, -8.279480,
-2.401027, 7.596085, 0.972697,
-113.617325, 367.072845, 37.711006,
-116.339890, 394.346069, 17.524639,
-35.673786, 126.476173, 85.882027,
-112.961624, 436.545746, 432.773010,
-45.223167, 176.381760, 158.709686,
-15.148774, 62.451622, -26.448929,
-11.695547, 49.201786, 44.327118,
-6.120895, 26.433861, -2.415023,
-11.070249, 53.142262, -15.776265,
-46.220867, 229.943756, -33.805035,
-1.688459, 8.827823, 9.306870,
-31.056490, 165.975464, -20.267546,
-42.608707, 272.692596, -11.554075,
-11.224151, 73.203018, 8.241212,
-5.169121, 34.891056, 19.237144,
-6.302877, 45.198479, -17.298277,
-8.668653, 68.648994, -49.301853,
-34.224377, 278.802277, -1.466332,
-44.491955, 372.157104, -120.498322,
-16.891573, 146.130676, -282.461487,
-34.513000, 316.898529, 55.830563,
-43.260105, 402.022675, -41.855446,
-42.625080, 409.218109, -8.632048,
-11.615465, 118.702309, 46.124069,
-32.573738, 350.238678, -15.973300,
-6.040792, 67.849564, -46.074329,
-21.004774, 249.600281, -8.495712,
-0.561442, 8.270766, -3.424850,
-1.183396, 20.769531, -5.504973,
-0.671817, 12.096553, -14.996687,
-11.645684, 217.784592, -37.160706,
-0.843405, 21.369162, -15.406507,
-1.217960, 32.140251, -12.267515,
-1.897829, 51.086220, 41.617153,
-2.738015, 129.939102, 16.896118,
-0.228781, 14.584967, -3.682361,
-0.444915, 119.469971, -110.689705,
-0.052014, 25.140087, 34.966862,
-0.036581, 17.818575, 17.785946,
-0.051556, 42.293926, 32.117710,
--12.724591, 196.031982, -21.599976,
--6.416699, 98.703201, 40.984310,
--7.897809, 88.873657, -51.645119,
--5.847032, 60.408535, -40.073395,
--14.405571, 144.966568, -47.210594,
--6.566555, 65.327301, 27.214411,
--6.061528, 57.789185, -76.263489,
--26.370138, 208.610168, -25.941074,
--2.984771, 18.488173, -6.542049,
--5.049569, 30.409986, 9.072353,
--15.508861, 93.274231, -88.780190,
--47.779385, 246.192642, 117.643143,
--0.494399, 2.476801, -0.758367,
--3.356390, 16.762621, 3.914118,
--2.978776, 13.956450, -26.774021,
--44.056953, 199.382172, -130.126999,
--7.684298, 34.707775, -43.299332,
--11.414032, 48.674469, 33.672924,
--129.375580, 537.517944, -248.285965,
--29.241518, 111.808228, -63.987255,
--87.707726, 317.775299, -174.801178,
--195.580887, 693.193054, -318.170868,
--144.702667, 470.425964, -244.246704,
--4.284953, 13.853774, -40.948601,
--24.994064, 71.742424, -187.632309,
--88.400536, 252.634644, -202.407043,
--9.261693, 26.120365, 8.230488,
--5.728102, 15.711555, 6.750600,
--306.715515, 798.031555, -479.833282,
--12.479839, 31.792545, 18.006186,
--19.169744, 47.957394, 7.524701,
--15.571657, 37.952862, -38.660786,
--5.383373, 12.292792, 8.349454,
--51.961048, 112.930733, -62.804760,
--1.462376, 3.160924, 0.318647,
--18.647512, 39.427780, -7.338650,
--5.274398, 11.080404, -39.173740,
--17.634047, 35.976578, 18.173105,
--148.708130, 300.706146, -261.799774,
--4.047311, 8.178082, 4.857111,
--172.100235, 333.101685, -173.718613,
--37.761246, 70.856331, -68.758293,
--34.836632, 62.346218, -94.715370,
--168.812286, 282.108063, -275.892792,
--9.259819, 14.884480, -7.916617,
--93.545403, 147.499817, -189.522629,
--49.319893, 72.765961, 14.214975,
--57.281418, 79.925522, -166.998764,
--22.700445, 30.772928, -2.611197,
--7.953260, 10.774009, -30.271833,
--16.790457, 21.829016, 49.111858,
--62.479557, 74.392776, -68.806656,
--58.896679, 70.008064, -121.064522,
--421.608643, 499.674377, -692.532471,
--141.950241, 163.882736, -141.804337,
--26.096796, 29.840279, 12.999019,
--9.299873, 10.632211, -19.956577,
--219.053055, 247.534454, -342.782532,
--27.392748, 30.751047, 4.633106,
--32.446873, 33.880329, -83.406372,
--31.840565, 33.146603, 4.786641,
--6.895990, 6.943455, 10.884648,
--63.343281, 61.370003, 95.099312,
--46.446545, 44.792114, -69.432770,
--93.337234, 87.041199, -120.826195,
--48.980602, 44.503174, -109.996132,
--52.721371, 47.771511, -135.609741,
--8.821604, 7.859485, -31.969828,
--29.573513, 26.080994, 1.594073,
--82.204285, 70.775238, -182.512054,
--22.832514, 19.355772, 22.394918,
--43.197491, 35.908600, 38.451965,
--73.165085, 60.251644, -135.414734,
--42.278961, 33.154659, -8.181955,
--31.592752, 23.975306, -61.151413,
--8.362055, 6.328407, 20.636473,
--6.697612, 5.007170, 10.580510,
--69.199295, 48.518879, -1.685698,
--33.573917, 23.258099, 7.122653,
--177.826019, 118.542419, -410.682739,
--58.631504, 38.861927, 30.986511,
--175.412918, 114.893822, -451.163330,
--15.346772, 9.683575, 30.247570,
--31.148535, 19.319319, 17.882639,
--294.706390, 175.571213, -482.131439,
--551.710022, 295.413605, 188.501938,
--20.539488, 10.878042, 4.926386,
--30.507395, 15.781466, -7.522799,
--34.659996, 17.330345, -106.687714,
--20.959986, 10.366138, -21.144775,
--65.762093, 31.829561, 31.642153,
--97.554535, 47.010948, -198.062500,
--27.185099, 13.098092, 28.055452,
--32.837055, 15.317512, 13.074932,
--52.019318, 23.616152, 50.542534,
--4.078426, 1.807402, -15.589643,
--66.811646, 29.018734, -22.042223,
--152.578827, 64.860901, -273.104156,
--67.041878, 27.078262, -134.200638,
--1607.512817, 642.867859, 283.714752,
--16.528748, 6.237099, -19.776556,
--54.910206, 19.187029, -121.371590,
--21.915560, 7.251199, -26.951733,
--38.887020, 12.331229, -11.847610,
--23.717508, 7.103113, 16.835571,
--14.702033, 4.390357, -25.388475,
--13.048848, 3.384391, 20.276373,
--17.403656, 4.360952, 33.392719,
--913.633118, 208.453094, -1558.077881,
--31.343269, 6.996816, 31.557465,
--16.238697, 3.295914, 6.203118,
--51.460072, 10.413399, 14.491117,
--106.468010, 19.502485, 70.544930,
--56.820366, 10.187247, -15.229380,
--56.398453, 9.689166, -80.199455,
--23.533789, 3.735513, 4.429111,
--35.883492, 4.500565, 95.864326,
--33.431534, 3.956243, -20.919889,
--56.677330, 6.011506, -111.955223,
--15.511584, 0.975263, -36.138687,
--40.309113, 2.456191, 44.504948,
--10.722375, 0.512003, 2.790618,
--10.886206, 0.442558, 0.335805,
--15.180115, 0.408838, 20.668732,
--76.685715, -2.798227, -93.828827,
--85.783875, -3.792441, -35.778065,
--63.986645, -3.256131, -83.101067,
--57.774235, -3.823672, -95.413155,
--13.556302, -0.913728, 20.948322,
--48.090450, -3.322289, -15.237844,
--76.275856, -6.641926, -0.891016,
--34.389980, -3.215015, -60.804668,
--44.189339, -5.151772, -87.688309,
--86.265938, -10.607481, -104.432793,
--25.616156, -3.357236, -7.660144,
--14.504649, -1.984663, -22.640577,
--30.162369, -4.301939, -94.515503,
--52.184807, -7.679010, 143.270523,
--38.880314, -5.877880, -17.013445,
--32.941040, -5.392047, -87.575027,
--26.368189, -4.377691, -30.255672,
--25.823339, -4.730163, -30.157938,
--11.631422, -2.138264, -0.299257,
--34.854965, -7.135864, -88.539017,
--53.383301, -11.279309, -93.329330,
--13.505998, -3.244198, 20.561922,
--60.149094, -14.887632, 3.678742,
--25.717844, -6.415836, 20.946922,
--29.650511, -8.247805, 5.959507,
--8.490358, -2.365078, -26.415861,
--35.049015, -12.570227, -15.936948,
--13.525926, -4.963249, -10.743965,
--12.857498, -4.930617, 19.611902,
--73.479073, -28.645859, -15.560351,
--274.032043, -114.973694, -244.164886,
--20.556580, -9.012572, -0.233466,
--62.170872, -28.953732, -92.569992,
--17.951738, -9.101768, 23.411104,
--96.527870, -49.984516, -96.807793,
--105.786224, -54.844208, -109.087486,
--9.442415, -5.163430, 3.579740,
--70.037903, -38.639317, -86.648071,
--92.060287, -52.229221, -95.639900,
--78.937576, -44.970222, -90.227646,
--68.266922, -40.947620, -139.977753,
--35.067814, -21.152262, 85.383522,
--23.658300, -14.550576, -13.958303,
--12.804442, -7.899598, -11.079578,
--8.820912, -5.931455, 3.699008,
--61.431129, -42.776836, -77.674614,
--31.033865, -24.209475, 23.065662,
--16.144629, -12.622566, 16.189266,
--54.597847, -44.018551, -63.498016,
--0.503598, -0.421285, -1.176707,
--0.503620, -0.421397, -1.176658,
--41.008362, -34.761829, 13.133288,
--86.546471, -73.871674, -123.690247,
--5.265760, -4.517745, -14.861736,
--14.077450, -12.136262, -1.841247,
--43.053619, -37.752857, 29.269686,
--29.499979, -26.156773, 1.303037,
--17.819151, -16.025030, -123.805267,
--7.783159, -7.176222, 37.301517,
--16.711752, -15.431911, -6.540483,
--83.356400, -82.295746, -109.744026,
--87.030975, -86.396591, -110.823189,
--35.812889, -36.426460, 43.460464,
--56.214939, -58.248398, -38.233799,
--71.784195, -75.064354, -111.579689,
--24.674858, -27.388830, -42.017788,
--14.628442, -16.287462, -28.120962,
--19.671221, -22.530033, 19.657949,
--31.599648, -36.675739, -7.999556,
--13.166849, -15.541132, -52.188290,
--29.402363, -35.267643, 139.934769,
--75.776932, -91.413506, -101.940994,
--51.392555, -62.237431, -59.205883,
--69.640221, -84.994034, -108.696342,
--10.113280, -12.592969, 26.844040,
--18.826128, -24.059715, 17.007662,
--12.123138, -16.486528, 10.299003,
--37.452740, -50.987213, 11.769777,
--77.350082, -105.628395, -114.478607,
--26.607359, -36.462944, -11.917342,
--30.736137, -42.704765, -28.135546,
--68.485733, -96.597466, -67.753883,
--22.481934, -32.939999, 19.706450,
--12.454459, -18.510897, 2.512608,
--24.937033, -37.742573, 12.478886,
--25.679474, -40.162018, -2.857283,
--11.482360, -18.165911, 1.682884,
--28.023012, -44.396198, -34.917118,
--2.853270, -4.708840, -11.009190,
--5.496971, -9.189305, 3.002756,
--56.039520, -94.086311, -61.238789,
--63.781609, -109.206017, -61.994267,
--59.228848, -102.713928, -93.963966,
--56.695641, -98.530632, -47.369911,
--73.327316, -134.264938, -55.093735,
--57.603569, -106.989441, -45.840374,
--57.305225, -112.462616, -44.599640,
--23.169176, -46.646481, -3.362598,
--37.200932, -75.800705, -170.738174,
--14.100493, -29.669060, -2.696438,
--28.217600, -60.334591, 69.732613,
--84.889496, -184.539017, -97.290916,
--23.489231, -51.495239, 19.658012,
--5.218013, -11.718720, 23.639977,
--63.854786, -153.039322, -82.432320,
--16.096575, -38.966831, 16.598692,
--19.295399, -47.113785, 1.763737,
--3.473696, -8.757673, -48.007946,
--41.660713, -108.364021, -62.291996,
--48.826561, -129.145660, -25.756712,
--3.096057, -8.657821, 5.657066,
--8.822829, -25.227806, 21.582552,
--13.963737, -43.403709, -118.949440,
--14.903817, -47.114864, -82.376411,
--4.971860, -15.809793, -11.302298,
--58.102829, -189.662918, -155.242355,
--36.328480, -119.450958, -97.607262,
--9.601040, -32.719044, -31.093515,
--6.976380, -25.016586, 4.287877,
--26.059214, -94.964211, -145.940231,
--11.026625, -41.361240, 25.645491,
--9.493886, -41.776646, 94.948784,
--5.333755, -24.248083, -6.990532,
--3.314089, -15.642885, -15.035923,
--22.324711, -111.339035, 29.135416,
--4.257937, -21.421783, 10.110209,
--17.551567, -88.333412, 67.396126,
--25.828434, -154.384872, -72.989670,
--15.779346, -103.419998, -152.388336,
--29.021385, -190.737122, -290.141357,
--8.722000, -67.231323, 87.720398,
--16.090040, -125.445869, -96.332153,
--3.535006, -27.884279, -50.053341,
--5.867672, -47.517559, -56.809158,
--19.749361, -170.746231, -130.012970,
--1.525532, -13.892244, 3.113856,
--6.026968, -60.700657, -56.878273,
--3.043460, -31.021538, -8.584847,
--9.445604, -105.135651, 109.333801,
--8.435199, -110.177887, -89.576981,
--1.805475, -24.993320, 2.001593,
--3.021911, -48.481945, -102.873665,
--0.438971, -7.422654, 3.907515,
--22.747610, -419.503510, -354.112000,
--1.532360, -28.979959, 1.372356,
--1.373463, -31.015100, -23.431324,
--0.527440, -18.670086, 28.621191,
--2.672158, -163.427139, 124.291840,
--0.417190, -28.171822, 35.406700,
--0.352944, -36.172146, 20.256618,
--0.196043, -46.158222, -7.950872,
-1.222422, -434.211914, 22.236320,
-0.643873, -25.398581, -14.920146,
-5.764205, -199.160126, -238.220337,
-0.802561, -25.015089, 4.216833,
-3.071857, -93.306427, 51.243828,
-509.179291, -8468.451172, -3266.603271,
-2.814937, -36.523418, -27.365446,
-7.437297, -80.963905, -46.616550,
-0.219234, -2.381464, 7.694267,
-1.756352, -18.829870, -0.957068,
-3.773556, -36.366867, 14.601857,
-3.852837, -36.393887, -25.043949,
-6.239763, -52.771202, -54.966034,
-2.605613, -21.243076, -10.172276,
-8.089544, -52.244301, -7.659030,
-0.970212, -5.967750, 4.858237,
-12.471088, -61.772041, -32.096684,
-48.934082, -220.363632, 148.631561,
-14.724646, -59.874367, -30.468904,
-26.543018, -103.136002, -41.107841,
-41.648968, -158.351639, 105.075272,
-6.390192, -22.805599, -13.607944,
-11.012635, -37.978577, -15.769148,
-6.976642, -23.777296, 6.115701,
-10.902999, -36.661518, -3.267168,
-9.413736, -31.307791, -17.141953,
-37.755932, -120.178108, -48.414474,
-3.636220, -11.100000, 28.425116,
-7.438332, -21.269753, 30.305365,
-12.395724, -33.298679, -11.440105,
-29.213678, -77.477257, -81.252617,
-14.150097, -36.917202, -33.905285,
-5.594392, -14.294328, 0.835248,
-8.873055, -21.499516, 29.481600,
-40.258007, -96.332634, 55.419662,
-16.358644, -33.181538, 37.164021,
-62.084785, -124.170532, 26.013979,
-58.816666, -116.200600, 43.663685,
-6.852737, -13.424598, 42.021481,
-2.361666, -4.499359, 0.792779,
-169.503387, -317.209137, 6.313487,
-6.568501, -11.934152, 1.529904,
-16.995062, -30.563389, 24.562799,
-39.235893, -68.818230, 28.040064,
-4.802790, -8.269449, -31.104630,
-1.313523, -2.087905, -5.587333,
-47.714390, -73.964203, -1.262057,
-156.564285, -237.370682, 302.185547,
-127.535721, -190.022446, 251.631958,
-18.429602, -26.801794, -7.237719,
-58.869438, -83.290054, -26.912651,
-207.376846, -290.119690, 301.968689,
-18.291574, -24.799324, -46.974239,
-18.336155, -22.333157, 7.524285,
-13.363544, -16.273903, -22.813284,
-45.534512, -54.440514, 20.233322,
-451.137695, -530.873352, 703.522766,
-11.218381, -12.796703, -38.590572,
-4.469333, -5.083404, 12.643149,
-12.154128, -13.712736, 12.345357,
-46.370441, -51.646431, -11.609671,
-66.815689, -69.912704, -157.527039,
-57.328167, -58.759903, 71.783913,
-187.764069, -179.853470, 250.452011,
-29.808571, -26.620047, 23.285309,
-12.377021, -10.874518, 12.892695,
-42.892166, -37.343697, 5.223766,
-5.249266, -4.460515, 13.280948,
-88.543358, -70.010735, -46.551159,
-47.964397, -37.252102, 172.079300,
-148.913376, -112.664474, -18.214235,
-21.468493, -15.888576, 27.266251,
-33.431458, -23.389610, -12.211647,
-3.804350, -2.627521, -20.666595,
-168.495026, -113.452782, 35.360699,
-9.499482, -6.225875, -3.283993,
-42.161564, -25.854979, -37.765278,
-204.268112, -111.158211, -1.298139,
-9.359470, -5.028607, 5.032547,
-18.747997, -9.944233, -22.726517,
-26.124392, -13.570963, 3.196950,
-104.299080, -53.801430, 189.288239,
-27.296923, -12.946503, -52.879478,
-43.980141, -20.122906, -1.171336,
-29.239260, -12.286547, -0.011106,
-60.681717, -25.362177, -62.402386,
-18.572781, -7.570948, 24.143248,
-59.147991, -21.102003, 12.015310,
-33.642536, -11.803605, -38.079197,
-53.740337, -18.766394, 33.158192,
-105.315598, -34.967144, 48.401943,
-23.644247, -7.619421, -31.025940,
-13.607652, -4.311252, 32.365219,
-31.024834, -9.781848, 14.894724,
-113.892250, -34.486774, -15.834913,
-45.169815, -13.240538, -13.338008,
-6.437051, -1.795832, -3.799763,
-151.955978, -39.354507, 142.961319,
-52.281689, -13.090506, 28.756367,
-40.115448, -9.860665, 11.227721,
-65.179298, -14.615279, -25.872263,
-39.001926, -8.582778, -40.280441,
-39.364651, -7.445455, 2.297539,
-11.395762, -2.141402, -18.727379,
-46.020947, -7.500826, -17.063820,
-17.696756, -1.738158, 18.711506,
-2.942366, -0.265839, 13.472992,
-1.688885, 8.826471, 9.308075,
--5.384182, 12.291923, 8.350214,
--11.631287, -2.139010, -0.299218,
--12.961219, -4.971058, 19.767132,
--5.335027, -24.247421, -6.991861
-};
\ No newline at end of file
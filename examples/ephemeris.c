@@ -0,0 +1,558 @@
+// the planets and the moon, computed from their orbital elements or looked up
+// in Chebyshev tables precomputed over a range of days
+
+#include "ephemeris.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define DEGREES (M_PI / 180.0)
+
+//                          a           e           I           L           w         omega
+//                         AU          rad         deg         deg         deg         deg
+static const double ELEMENTS[9][6] = {
+	{ 0.38709927, 0.20563593, 7.00497902,252.25032350, 77.45779628, 48.33076593},
+	{ 0.72333566, 0.00677672, 3.39467605,181.97909950,131.60246718, 76.67984255},
+	{ 1.00000261, 0.01671123,-0.00001531,100.46457166,102.93768193,  0.0},
+	{ 1.52371034, 0.09339410, 1.84969142, -4.55343205,-23.94362959, 49.55953891},
+	{ 5.20288700, 0.04838624, 1.30439695, 34.39644051, 14.72847983,100.47390909},
+	{ 9.53667594, 0.05386179, 2.48599187, 49.95424423, 92.59887831,113.66242448},
+	{19.18916464, 0.04725744, 0.77263783,313.23810451,170.95427630, 74.01692503},
+	{30.06992276, 0.00859048, 1.77004347,-55.12002969, 44.96476227,131.78422574},
+	{39.48211675, 0.24882730,17.14001206,238.92903833,224.06891629,110.30393684}
+};
+//                         AU/Cy       rad/Cy      deg/Cy      deg/Cy         deg/Cy     deg/Cy
+static const double RATES[9][6] = {
+	{ 0.00000037, 0.00001906,-0.00594749,149472.67411175, 0.16047689,-0.12534081},
+	{ 0.00000390,-0.00004107,-0.00078890, 58517.81538729, 0.00268329,-0.27769418},
+	{ 0.00000562,-0.00004392,-0.01294668, 35999.37244981, 0.32327364, 0.0},
+	{ 0.00001847, 0.00007882,-0.00813131, 19140.30268499, 0.44441088,-0.29257343},
+	{-0.00011607,-0.00013253,-0.00183714,  3034.74612775, 0.21252668, 0.20469106},
+	{-0.00125060,-0.00050991, 0.00193609,  1222.49362201,-0.41897216,-0.28867794},
+	{-0.00196176,-0.00004397,-0.00242939,   428.48202785, 0.40805281, 0.04240589},
+	{ 0.00026291, 0.00005105, 0.00035372,   218.45945325,-0.32241464,-0.00508664},
+	{-0.00031596, 0.00005170, 0.00004818,   145.20780515,-0.04062942,-0.01183482}
+};
+// days, a table segment is a quarter of one
+static const double PERIODS[EPHEMERIS_BODIES] = {
+	87.969, 224.701, 365.256, 686.980, 4332.59, 10759.22, 30688.5, 60182.0, 90560.0, 27.322
+};
+// the moon, from http://njsas.org/projects/tidal_forces/altaz/pausch/ppcomp.html#6
+#define MOON_DAYS 1.6666666  // a correction to line up the phases
+#define MOON_AXIS 0.00257356604  // AU
+#define MOON_ECCENTRICITY 0.054900
+#define MOON_INCLINATION (5.1454 * DEGREES)
+
+////////// DIRECT //////////
+
+static void _planet(int planet, double day, double *x, double *y, double *z){
+	const double *elm = ELEMENTS[planet], *rate = RATES[planet];
+	double T = day / 36525.0;
+	double a = elm[0] + rate[0]*T;
+	double e = elm[1] + rate[1]*T;
+	double I = (elm[2] + rate[2]*T) * DEGREES;
+	double L = (elm[3] + rate[3]*T) * DEGREES;
+	double periapsis = (elm[4] + rate[4]*T) * DEGREES;  // longitude of
+	double node = (elm[5] + rate[5]*T) * DEGREES;
+	double omega = periapsis - node;
+	// Kepler's equation, M = E - e sin(E), by Newton's method
+	double M = remainder(L - periapsis, 2*M_PI);
+	double E = M + e * sin(M);
+	for(int i = 0; i < 5; i++){
+		E -= (E - e*sin(E) - M) / (1.0 - e*cos(E));
+	}
+	double x0 = a*(cos(E) - e);
+	double y0 = a*sqrt(1.0 - e*e)*sin(E);
+	*x = ( cos(omega)*cos(node) - sin(omega)*sin(node)*cos(I) )*x0 + ( -sin(omega)*cos(node) - cos(omega)*sin(node)*cos(I) )*y0;
+	*y = ( cos(omega)*sin(node) + sin(omega)*cos(node)*cos(I) )*x0 + ( -sin(omega)*sin(node) + cos(omega)*cos(node)*cos(I) )*y0;
+	*z = ( sin(omega)*sin(I) )*x0 + ( cos(omega)*sin(I) )*y0;
+}
+static void _moon(double day, double *x, double *y, double *z){
+	double d = day + MOON_DAYS;
+	double N = (125.1228 - 0.0529538083 * d) * DEGREES;
+	double w = (318.0634 + 0.1643573223 * d) * DEGREES;
+	double M = (115.3654 + 13.0649929509 * d) * DEGREES;
+	double e = MOON_ECCENTRICITY;
+	double E = M + e * sin(M) * (1.0 + e * cos(M));
+	double xv = MOON_AXIS * (cos(E) - e);
+	double yv = MOON_AXIS * sqrt(1.0 - e*e) * sin(E);
+	// r cos(v+w) and r sin(v+w), without the angle v
+	double c = xv*cos(w) - yv*sin(w);
+	double s = xv*sin(w) + yv*cos(w);
+	*x = c*cos(N) - s*sin(N)*cos(MOON_INCLINATION);
+	*y = c*sin(N) + s*cos(N)*cos(MOON_INCLINATION);
+	*z = s*sin(MOON_INCLINATION);
+}
+void ephemerisPoint(int body, double day, double position[3]){
+	if(body == EPHEMERIS_MOON){ _moon(day, &position[0], &position[1], &position[2]); }
+	else{ _planet(body, day, &position[0], &position[1], &position[2]); }
+}
+
+#ifdef __SSE2__
+// sine and cosine of 2 angles: reduced by pi/2 (in two parts, exact for
+// thousands of turns) to within pi/4, then fdlibm's polynomials
+static void _sincos2(__m128d x, __m128d *s, __m128d *c){
+	__m128i q = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(2.0 / M_PI)));
+	__m128d n = _mm_cvtepi32_pd(q);
+	__m128d r = _mm_sub_pd(_mm_sub_pd(x, _mm_mul_pd(n, _mm_set1_pd(1.57079632673412561417e+00))), _mm_mul_pd(n, _mm_set1_pd(6.07710050650619224932e-11)));
+	__m128d z = _mm_mul_pd(r, r);
+	__m128d ps = _mm_set1_pd(1.58969099521155010221e-10);
+	ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(-2.50507602534068634195e-08));
+	ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(2.75573137070700676789e-06));
+	ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(-1.98412698298579493134e-04));
+	ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(8.33333333332248946124e-03));
+	ps = _mm_add_pd(_mm_mul_pd(ps, z), _mm_set1_pd(-1.66666666666666324348e-01));
+	__m128d sr = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, z), ps));
+	__m128d pc = _mm_set1_pd(-1.13596475577881948265e-11);
+	pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(2.08757232129817482790e-09));
+	pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(-2.75573143513906633035e-07));
+	pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(2.48015872894767294178e-05));
+	pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(-1.38888888888741095749e-03));
+	pc = _mm_add_pd(_mm_mul_pd(pc, z), _mm_set1_pd(4.16666666666666019037e-02));
+	__m128d cr = _mm_add_pd(_mm_sub_pd(_mm_set1_pd(1.0), _mm_mul_pd(z, _mm_set1_pd(0.5))), _mm_mul_pd(_mm_mul_pd(z, z), pc));
+	// the quadrant swaps sine and cosine and flips their signs
+	q = _mm_shuffle_epi32(q, _MM_SHUFFLE(1, 1, 0, 0));
+	__m128d swap = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128d sinSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(q, _mm_set1_epi32(2)), 62));
+	__m128d cosSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 62));
+	*s = _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, cr), _mm_andnot_pd(swap, sr)), sinSign);
+	*c = _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, sr), _mm_andnot_pd(swap, cr)), cosSign);
+}
+#define LINEAR2(e, r, t) _mm_add_pd(_mm_set1_pd(e), _mm_mul_pd(_mm_set1_pd(r), t))
+static void _planet2(int planet, __m128d day, __m128d *x, __m128d *y, __m128d *z){
+	const double *elm = ELEMENTS[planet], *rate = RATES[planet];
+	__m128d T = _mm_div_pd(day, _mm_set1_pd(36525.0));
+	__m128d a = LINEAR2(elm[0], rate[0], T);
+	__m128d e = LINEAR2(elm[1], rate[1], T);
+	__m128d I = LINEAR2(elm[2] * DEGREES, rate[2] * DEGREES, T);
+	__m128d L = LINEAR2(elm[3] * DEGREES, rate[3] * DEGREES, T);
+	__m128d periapsis = LINEAR2(elm[4] * DEGREES, rate[4] * DEGREES, T);
+	__m128d node = LINEAR2(elm[5] * DEGREES, rate[5] * DEGREES, T);
+	__m128d omega = _mm_sub_pd(periapsis, node);
+	// reduced to [-pi, pi] like remainder() in _planet()
+	__m128d M = _mm_sub_pd(L, periapsis);
+	__m128d turns = _mm_cvtepi32_pd(_mm_cvtpd_epi32(_mm_mul_pd(M, _mm_set1_pd(0.5 / M_PI))));
+	M = _mm_sub_pd(M, _mm_mul_pd(turns, _mm_set1_pd(2 * M_PI)));
+	__m128d one = _mm_set1_pd(1.0);
+	__m128d sinE, cosE;
+	_sincos2(M, &sinE, &cosE);
+	__m128d E = _mm_add_pd(M, _mm_mul_pd(e, sinE));
+	for(int i = 0; i < 5; i++){
+		_sincos2(E, &sinE, &cosE);
+		__m128d f = _mm_sub_pd(_mm_sub_pd(E, _mm_mul_pd(e, sinE)), M);
+		E = _mm_sub_pd(E, _mm_div_pd(f, _mm_sub_pd(one, _mm_mul_pd(e, cosE))));
+	}
+	_sincos2(E, &sinE, &cosE);
+	__m128d x0 = _mm_mul_pd(a, _mm_sub_pd(cosE, e));
+	__m128d y0 = _mm_mul_pd(_mm_mul_pd(a, _mm_sqrt_pd(_mm_sub_pd(one, _mm_mul_pd(e, e)))), sinE);
+	__m128d sinW, cosW, sinN, cosN, sinI, cosI;
+	_sincos2(omega, &sinW, &cosW);
+	_sincos2(node, &sinN, &cosN);
+	_sincos2(I, &sinI, &cosI);
+	// the orbit's plane rotated by the argument of periapsis, inclination and node
+	__m128d xx = _mm_sub_pd(_mm_mul_pd(cosW, cosN), _mm_mul_pd(_mm_mul_pd(sinW, sinN), cosI));
+	__m128d xy = _mm_sub_pd(_mm_setzero_pd(), _mm_add_pd(_mm_mul_pd(sinW, cosN), _mm_mul_pd(_mm_mul_pd(cosW, sinN), cosI)));
+	__m128d yx = _mm_add_pd(_mm_mul_pd(cosW, sinN), _mm_mul_pd(_mm_mul_pd(sinW, cosN), cosI));
+	__m128d yy = _mm_sub_pd(_mm_mul_pd(_mm_mul_pd(cosW, cosN), cosI), _mm_mul_pd(sinW, sinN));
+	*x = _mm_add_pd(_mm_mul_pd(xx, x0), _mm_mul_pd(xy, y0));
+	*y = _mm_add_pd(_mm_mul_pd(yx, x0), _mm_mul_pd(yy, y0));
+	*z = _mm_mul_pd(sinI, _mm_add_pd(_mm_mul_pd(sinW, x0), _mm_mul_pd(cosW, y0)));
+}
+static void _moon2(__m128d day, __m128d *x, __m128d *y, __m128d *z){
+	__m128d d = _mm_add_pd(day, _mm_set1_pd(MOON_DAYS));
+	__m128d N = LINEAR2(125.1228 * DEGREES, -0.0529538083 * DEGREES, d);
+	__m128d w = LINEAR2(318.0634 * DEGREES, 0.1643573223 * DEGREES, d);
+	__m128d M = LINEAR2(115.3654 * DEGREES, 13.0649929509 * DEGREES, d);
+	__m128d e = _mm_set1_pd(MOON_ECCENTRICITY);
+	__m128d sinM, cosM, sinE, cosE, sinW, cosW, sinN, cosN;
+	_sincos2(M, &sinM, &cosM);
+	__m128d E = _mm_add_pd(M, _mm_mul_pd(_mm_mul_pd(e, sinM), _mm_add_pd(_mm_set1_pd(1.0), _mm_mul_pd(e, cosM))));
+	_sincos2(E, &sinE, &cosE);
+	_sincos2(w, &sinW, &cosW);
+	_sincos2(N, &sinN, &cosN);
+	__m128d xv = _mm_mul_pd(_mm_set1_pd(MOON_AXIS), _mm_sub_pd(cosE, e));
+	__m128d yv = _mm_mul_pd(_mm_set1_pd(MOON_AXIS * sqrt(1.0 - MOON_ECCENTRICITY*MOON_ECCENTRICITY)), sinE);
+	__m128d c = _mm_sub_pd(_mm_mul_pd(xv, cosW), _mm_mul_pd(yv, sinW));
+	__m128d s = _mm_add_pd(_mm_mul_pd(xv, sinW), _mm_mul_pd(yv, cosW));
+	__m128d sc = _mm_mul_pd(s, _mm_set1_pd(cos(MOON_INCLINATION)));
+	*x = _mm_sub_pd(_mm_mul_pd(c, cosN), _mm_mul_pd(sc, sinN));
+	*y = _mm_add_pd(_mm_mul_pd(c, sinN), _mm_mul_pd(sc, cosN));
+	*z = _mm_mul_pd(s, _mm_set1_pd(sin(MOON_INCLINATION)));
+}
+#undef LINEAR2
+#endif
+
+void ephemerisCompute(int body, const double *days, double *x, double *y, double *z, int count){
+	int i = 0;
+#ifdef __SSE2__
+	for(; i + 2 <= count; i += 2){
+		__m128d px, py, pz;
+		if(body == EPHEMERIS_MOON){ _moon2(_mm_loadu_pd(&days[i]), &px, &py, &pz); }
+		else{ _planet2(body, _mm_loadu_pd(&days[i]), &px, &py, &pz); }
+		_mm_storeu_pd(&x[i], px);
+		_mm_storeu_pd(&y[i], py);
+		_mm_storeu_pd(&z[i], pz);
+	}
+#endif
+	for(; i < count; i++){
+		double position[3];
+		ephemerisPoint(body, days[i], position);
+		x[i] = position[0];
+		y[i] = position[1];
+		z[i] = position[2];
+	}
+}
+
+////////// THREADS //////////
+
+typedef struct{
+	void (*body)(void *context, int first, int end);
+	void *context;
+	int first, end;
+} _EphemerisBand;
+#ifndef WORLD_FRAMEWORK
+static void *_ephemeris_band(void *arg){
+	_EphemerisBand *band = (_EphemerisBand*)arg;
+	band->body(band->context, band->first, band->end);
+	return NULL;
+}
+#endif
+// [0, count) split across threads, 0: one per core
+static void _ephemeris_parallel(int count, int threads, void (*body)(void *context, int first, int end), void *context){
+#ifdef WORLD_FRAMEWORK
+	// with world.h the pieces go to its worker pool
+	parallelFor(0, count, (threads > 0) ? (count + threads - 1) / threads : 0, body, context);
+#else
+	if(threads <= 0){ threads = (int)sysconf(_SC_NPROCESSORS_ONLN); }
+	if(threads > count){ threads = count; }
+	if(threads < 1){ threads = 1; }
+	pthread_t thread[threads];
+	_EphemerisBand band[threads];
+	for(int i = 0; i < threads; i++){
+		band[i].body = body;
+		band[i].context = context;
+		band[i].first = (int)((long)count * i / threads);
+		band[i].end = (int)((long)count * (i + 1) / threads);
+	}
+	int started = 1;
+	while(started < threads && pthread_create(&thread[started], NULL, _ephemeris_band, &band[started]) == 0){ started++; }
+	// the bands whose thread couldn't start are done on this one
+	_ephemeris_band(&band[0]);
+	for(int i = started; i < threads; i++){ _ephemeris_band(&band[i]); }
+	for(int i = 1; i < started; i++){ pthread_join(thread[i], NULL); }
+#endif
+}
+
+////////// TABLES //////////
+
+#define COEFFICIENTS EPHEMERIS_COEFFICIENTS
+typedef struct{
+	Ephemeris *ephemeris;
+	int body;
+	double nodes[COEFFICIENTS];  // -1 to 1
+	double cosines[COEFFICIENTS][COEFFICIENTS];  // [coefficient][node], scaled by 2/n
+} _EphemerisFit;
+// sampled at the Chebyshev nodes of each segment, which the fit passes through
+static void _ephemeris_fit(void *context, int first, int end){
+	_EphemerisFit *fit = (_EphemerisFit*)context;
+	Ephemeris *ephemeris = fit->ephemeris;
+	double span = ephemeris->span[fit->body];
+	double days[COEFFICIENTS], samples[3][COEFFICIENTS];
+	for(int s = first; s < end; s++){
+		double start = ephemeris->first + s * span;
+		for(int k = 0; k < COEFFICIENTS; k++){ days[k] = start + (fit->nodes[k] + 1.0) * 0.5 * span; }
+		ephemerisCompute(fit->body, days, samples[0], samples[1], samples[2], COEFFICIENTS);
+		double *c = &ephemeris->table[fit->body][s * 3 * COEFFICIENTS];
+		for(int axis = 0; axis < 3; axis++){
+			for(int j = 0; j < COEFFICIENTS; j++){
+				double sum = 0;
+				for(int k = 0; k < COEFFICIENTS; k++){ sum += samples[axis][k] * fit->cosines[j][k]; }
+				c[axis * COEFFICIENTS + j] = sum;
+			}
+			c[axis * COEFFICIENTS] *= 0.5;
+		}
+	}
+}
+Ephemeris *createEphemeris(double firstDay, double lastDay, int threads){
+	if(!(lastDay > firstDay)){ return NULL; }
+	Ephemeris *ephemeris = (Ephemeris*)calloc(1, sizeof(Ephemeris));
+	ephemeris->first = firstDay;
+	ephemeris->last = lastDay;
+	_EphemerisFit fit;
+	fit.ephemeris = ephemeris;
+	for(int k = 0; k < COEFFICIENTS; k++){
+		fit.nodes[k] = cos(M_PI * (k + 0.5) / COEFFICIENTS);
+		for(int j = 0; j < COEFFICIENTS; j++){ fit.cosines[j][k] = 2.0 / COEFFICIENTS * cos(M_PI * j * (k + 0.5) / COEFFICIENTS); }
+	}
+	for(int b = 0; b < EPHEMERIS_BODIES; b++){
+		// whole segments, close to a quarter period
+		int segments = (int)ceil((lastDay - firstDay) / (PERIODS[b] * 0.25));
+		if(segments < 1){ segments = 1; }
+		ephemeris->segments[b] = segments;
+		ephemeris->span[b] = (lastDay - firstDay) / segments;
+		ephemeris->table[b] = (double*)malloc(sizeof(double) * segments * 3 * COEFFICIENTS);
+		if(ephemeris->table[b] == NULL){
+			freeEphemeris(ephemeris);
+			return NULL;
+		}
+		ephemeris->memoryUsed += sizeof(double) * segments * 3 * COEFFICIENTS;
+		fit.body = b;
+		_ephemeris_parallel(segments, threads, _ephemeris_fit, &fit);
+	}
+	return ephemeris;
+}
+// Clenshaw's recurrence, x from -1 to 1
+static double _chebyshev(const double *c, double x){
+	double b1 = 0, b2 = 0;
+	for(int j = COEFFICIENTS - 1; j > 0; j--){
+		double b = c[j] + 2.0 * x * b1 - b2;
+		b2 = b1;
+		b1 = b;
+	}
+	return c[0] + x * b1 - b2;
+}
+void ephemerisPosition(const Ephemeris *ephemeris, int body, double day, double position[3]){
+	if(ephemeris == NULL || !(day >= ephemeris->first && day <= ephemeris->last)){
+		ephemerisPoint(body, day, position);
+		return;
+	}
+	double u = (day - ephemeris->first) / ephemeris->span[body];
+	int s = (int)u;
+	if(s >= ephemeris->segments[body]){ s = ephemeris->segments[body] - 1; }
+	const double *c = &ephemeris->table[body][s * 3 * COEFFICIENTS];
+	double x = 2.0 * (u - s) - 1.0;
+	for(int axis = 0; axis < 3; axis++){ position[axis] = _chebyshev(&c[axis * COEFFICIENTS], x); }
+}
+void freeEphemeris(Ephemeris *ephemeris){
+	if(ephemeris == NULL){ return; }
+	for(int b = 0; b < EPHEMERIS_BODIES; b++){ free(ephemeris->table[b]); }
+	free(ephemeris);
+}
+#undef COEFFICIENTS
+
+////////// SKY //////////
+
+static double _longitude(double x, double y){
+	double angle = atan2(y, x);
+	return (angle < 0) ? angle + M_PI*2 : angle;
+}
+void ephemerisSky(const Ephemeris *ephemeris, double day, EphemerisSky *sky){
+	for(int i = 0; i < 9; i++){ ephemerisPosition(ephemeris, i, day, sky->planets[i]); }
+	ephemerisPosition(ephemeris, EPHEMERIS_MOON, day, sky->moon);
+	const double *earth = sky->planets[EPHEMERIS_EARTH];
+	for(int i = 0; i < 9; i++){
+		if(i == EPHEMERIS_EARTH){
+			sky->longitude[i] = sky->latitude[i] = sky->distance[i] = 0.0;
+			sky->direction[i][0] = sky->direction[i][1] = sky->direction[i][2] = 0.0;
+			continue;
+		}
+		double d[3] = {sky->planets[i][0] - earth[0], sky->planets[i][1] - earth[1], sky->planets[i][2] - earth[2]};
+		double mag = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+		for(int k = 0; k < 3; k++){ sky->direction[i][k] = d[k] / mag; }
+		sky->longitude[i] = _longitude(d[0], d[1]);
+		sky->latitude[i] = M_PI*0.5 - acos(sky->direction[i][2]);
+		sky->distance[i] = mag;
+	}
+	double mag = sqrt(sky->moon[0]*sky->moon[0] + sky->moon[1]*sky->moon[1] + sky->moon[2]*sky->moon[2]);
+	for(int k = 0; k < 3; k++){ sky->moonDirection[k] = sky->moon[k] / mag; }
+	sky->moonLongitude = _longitude(sky->moon[0], sky->moon[1]);
+	sky->moonLatitude = M_PI*0.5 - acos(sky->moonDirection[2]);
+	sky->moonDistance = mag;
+	sky->sunLongitude = _longitude(-earth[0], -earth[1]);
+	sky->sunDistance = sqrt(earth[0]*earth[0] + earth[1]*earth[1] + earth[2]*earth[2]);
+	sky->zodiac = (int)(sky->sunLongitude * 180 / M_PI / 30) % 12;
+	// for New York, ~40 N
+	sky->daylightHours = 9.25 + 2.92 + 2.92*sin(sky->sunLongitude);
+	sky->moonPhase = sky->moonLongitude - sky->sunLongitude;
+	if(sky->moonPhase < 0){ sky->moonPhase += M_PI*2; }
+}
+
+////////// CALENDAR //////////
+
+// whole days from 2000-01-01, by Howard Hinnant's civil calendar algorithms
+static long _days_from_civil(long y, int m, int d){
+	y -= m <= 2;
+	long era = (y >= 0 ? y : y - 399) / 400;
+	long yoe = y - era * 400;
+	long doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+	long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 730425;
+}
+double ephemerisDay(int year, int month, int day, int hour, int minute, double second){
+	return _days_from_civil(year, month, day) - 0.5 + (hour + minute / 60.0 + second / 3600.0) / 24.0;
+}
+void ephemerisDate(double day, int date[6]){
+	// to the nearest second, from midnight
+	long long seconds = llround(day * 86400.0) + 43200;
+	long long days = (seconds >= 0) ? seconds / 86400 : -((-seconds + 86399) / 86400);
+	long long time = seconds - days * 86400;
+	long z = (long)days + 730425;
+	long era = (z >= 0 ? z : z - 146096) / 146097;
+	long doe = z - era * 146097;
+	long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	long mp = (5 * doy + 2) / 153;
+	date[2] = (int)(doy - (153 * mp + 2) / 5 + 1);
+	date[1] = (int)(mp < 10 ? mp + 3 : mp - 9);
+	date[0] = (int)(yoe + era * 400 + (date[1] <= 2));
+	date[3] = (int)(time / 3600);
+	date[4] = (int)(time / 60 % 60);
+	date[5] = (int)(time % 60);
+}
+
+////////// EXPORT //////////
+
+#define EXPORT_BLOCK 4096  // rows
+#define EXPORT_VALUES 32  // per row, after the time
+#define EXPORT_ROW 768  // bytes, more than a CSV row can take
+static const char *ZODIACS[12] = {"Aries","Taurus","Gemini","Cancer","Leo","Virgo","Libra","Scorpio","Saggitarius","Capricorn","Aquarius","Pisces"};
+static const char *PLANET_NAMES[9] = {"Mercury","Venus","Earth","Mars","Jupiter","Saturn","Uranus","Neptune","Pluto"};
+typedef struct{
+	const Ephemeris *ephemeris;
+	int format;
+	double first, step;
+	long row;  // the block's first
+	int rows;
+	double *columns;  // binary: [1 + EXPORT_VALUES][EXPORT_BLOCK]
+	char *text;  // CSV: EXPORT_ROW bytes per row
+	int *lengths;
+} _EphemerisExport;
+// in the columns' order. degrees, AU and hours
+static void _export_values(const EphemerisSky *sky, double values[EXPORT_VALUES]){
+	int n = 0;
+	values[n++] = sky->sunLongitude * 180 / M_PI;
+	values[n++] = sky->sunDistance;
+	values[n++] = sky->zodiac;
+	values[n++] = sky->daylightHours;
+	for(int i = 0; i < 9; i++){
+		if(i == EPHEMERIS_EARTH){ continue; }
+		values[n++] = sky->longitude[i] * 180 / M_PI;
+		values[n++] = sky->latitude[i] * 180 / M_PI;
+		values[n++] = sky->distance[i];
+	}
+	values[n++] = sky->moonLongitude * 180 / M_PI;
+	values[n++] = sky->moonLatitude * 180 / M_PI;
+	values[n++] = sky->moonDistance;
+	values[n++] = sky->moonPhase * 180 / M_PI;
+}
+static int _export_names(char names[1 + EXPORT_VALUES][32]){
+	int n = 0;
+	strcpy(names[n++], "Day");
+	strcpy(names[n++], "SunLongitude");
+	strcpy(names[n++], "SunDistance");
+	strcpy(names[n++], "Zodiac");
+	strcpy(names[n++], "Daylight");
+	for(int i = 0; i < 9; i++){
+		if(i == EPHEMERIS_EARTH){ continue; }
+		snprintf(names[n++], 32, "%sLongitude", PLANET_NAMES[i]);
+		snprintf(names[n++], 32, "%sLatitude", PLANET_NAMES[i]);
+		snprintf(names[n++], 32, "%sDistance", PLANET_NAMES[i]);
+	}
+	strcpy(names[n++], "MoonLongitude");
+	strcpy(names[n++], "MoonLatitude");
+	strcpy(names[n++], "MoonDistance");
+	strcpy(names[n++], "MoonPhase");
+	return n;
+}
+// like printf's %f, 6 decimals, without the locale and parsing
+static char *_format_fixed(char *out, double value){
+	long long scaled = llround(value * 1000000.0);
+	if(scaled < 0){
+		*out++ = '-';
+		scaled = -scaled;
+	}
+	char digits[24];
+	int n = 0;
+	long long whole = scaled / 1000000;
+	do{
+		digits[n++] = '0' + whole % 10;
+		whole /= 10;
+	} while(whole);
+	while(n){ *out++ = digits[--n]; }
+	*out++ = '.';
+	long long fraction = scaled % 1000000;
+	for(int i = 5; i >= 0; i--){
+		out[i] = '0' + fraction % 10;
+		fraction /= 10;
+	}
+	return out + 6;
+}
+static void _export_rows(void *context, int first, int end){
+	_EphemerisExport *ex = (_EphemerisExport*)context;
+	EphemerisSky sky;
+	double values[EXPORT_VALUES];
+	for(int r = first; r < end; r++){
+		double day = ex->first + (ex->row + r) * ex->step;
+		ephemerisSky(ex->ephemeris, day, &sky);
+		_export_values(&sky, values);
+		if(ex->format == EPHEMERIS_BINARY){
+			ex->columns[r] = day;
+			for(int v = 0; v < EXPORT_VALUES; v++){ ex->columns[(1 + v) * EXPORT_BLOCK + r] = values[v]; }
+			continue;
+		}
+		char *line = &ex->text[(size_t)r * EXPORT_ROW], *out = line;
+		int date[6];
+		ephemerisDate(day, date);
+		for(int i = 0; i < 6; i++){ out += sprintf(out, "%d,", date[i]); }
+		for(int v = 0; v < EXPORT_VALUES; v++){
+			if(v == 2){ out += sprintf(out, "%s", ZODIACS[sky.zodiac]); }
+			else{ out = _format_fixed(out, values[v]); }
+			*out++ = (v == EXPORT_VALUES - 1) ? '\n' : ',';
+		}
+		ex->lengths[r] = (int)(out - line);
+	}
+}
+long exportEphemeris(const char *path, double firstDay, double lastDay, double step, int format, int threads){
+	if(!(step > 0) || lastDay < firstDay){ return 0; }
+	FILE *file = fopen(path, "wb");
+	if(file == NULL){ return -1; }
+	long rows = (long)floor((lastDay - firstDay) / step + 1e-9) + 1;
+	// 12 coefficients per quarter orbit is far cheaper than solving every row
+	Ephemeris *ephemeris = createEphemeris(firstDay, firstDay + (rows - 1) * step + step, threads);
+	_EphemerisExport ex = {ephemeris, format, firstDay, step, 0, 0, NULL, NULL, NULL};
+	char names[1 + EXPORT_VALUES][32];
+	int columns = _export_names(names);
+	if(format == EPHEMERIS_BINARY){
+		uint32_t header[2] = {(uint32_t)columns, EXPORT_BLOCK};
+		uint64_t count = (uint64_t)rows;
+		fwrite("EPHEMRS1", 1, 8, file);
+		fwrite(header, sizeof(uint32_t), 2, file);
+		fwrite(&count, sizeof(uint64_t), 1, file);
+		fwrite(&firstDay, sizeof(double), 1, file);
+		fwrite(&step, sizeof(double), 1, file);
+		fwrite(names, 32, columns, file);
+		ex.columns = (double*)malloc(sizeof(double) * columns * EXPORT_BLOCK);
+	}
+	else{
+		// 07.c's header, the date is in place of the day
+		fprintf(file, "Year,Month,Day,Hour,Minute,Second");
+		for(int i = 1; i < columns; i++){ fprintf(file, ",%s", names[i]); }
+		fprintf(file, "\n");
+		ex.text = (char*)malloc((size_t)EXPORT_ROW * EXPORT_BLOCK);
+		ex.lengths = (int*)malloc(sizeof(int) * EXPORT_BLOCK);
+	}
+	long written = 0;
+	for(ex.row = 0; ex.row < rows && !ferror(file); ex.row += EXPORT_BLOCK){
+		ex.rows = (int)((rows - ex.row < EXPORT_BLOCK) ? rows - ex.row : EXPORT_BLOCK);
+		_ephemeris_parallel(ex.rows, threads, _export_rows, &ex);
+		if(format == EPHEMERIS_BINARY){
+			uint32_t count = (uint32_t)ex.rows;
+			fwrite(&count, sizeof(uint32_t), 1, file);
+			for(int c = 0; c < columns; c++){ fwrite(&ex.columns[c * EXPORT_BLOCK], sizeof(double), ex.rows, file); }
+		}
+		else{
+			for(int r = 0; r < ex.rows; r++){ fwrite(&ex.text[(size_t)r * EXPORT_ROW], 1, ex.lengths[r], file); }
+		}
+		written += ex.rows;
+	}
+	int failed = ferror(file);
+	if(fclose(file) != 0){ failed = 1; }
+	free(ex.columns);
+	free(ex.text);
+	free(ex.lengths);
+	freeEphemeris(ephemeris);
+	return failed ? -1 : written;
+}
+#undef EXPORT_BLOCK
+#undef EXPORT_VALUES
+#undef EXPORT_ROW
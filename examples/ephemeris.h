@@ -0,0 +1,72 @@
+#ifndef Ephemeris_h
+#define Ephemeris_h
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// positions of the planets and the moon from mean orbital elements (JPL's
+// approximate elements for 1800-2050 AD). heliocentric ecliptic coordinates
+// in AU, except the moon, which is around the earth. time is in days since J2000
+enum{
+	EPHEMERIS_MERCURY, EPHEMERIS_VENUS, EPHEMERIS_EARTH, EPHEMERIS_MARS, EPHEMERIS_JUPITER,
+	EPHEMERIS_SATURN, EPHEMERIS_URANUS, EPHEMERIS_NEPTUNE, EPHEMERIS_PLUTO, EPHEMERIS_MOON,
+	EPHEMERIS_BODIES
+};
+
+// count times at once, coordinates in separate arrays. the Kepler equation is
+// solved 2 samples at a time with SSE2 when the compiler targets it
+void ephemerisCompute(int body, const double *days, double *x, double *y, double *z, int count);
+void ephemerisPoint(int body, double day, double position[3]);
+
+// Chebyshev tables over a range of days: every body's orbit is cut into
+// segments a quarter of its period long, each one a polynomial per axis.
+// a lookup is one segment and a few multiply-adds, anywhere in the range,
+// within ~1e-7 of the distance from the computed position. outside of the
+// range, the position is computed directly
+#define EPHEMERIS_COEFFICIENTS 12
+typedef struct{
+	double first, last;  // days covered
+	double span[EPHEMERIS_BODIES];  // days per segment
+	int segments[EPHEMERIS_BODIES];
+	double *table[EPHEMERIS_BODIES];  // [segment][axis][coefficient]
+	size_t memoryUsed;
+} Ephemeris;
+// tables are filled across threads (world.h's worker pool if it was included
+// first), 0 uses one per core
+Ephemeris *createEphemeris(double firstDay, double lastDay, int threads);
+void ephemerisPosition(const Ephemeris *ephemeris, int body, double day, double position[3]);
+void freeEphemeris(Ephemeris *ephemeris);
+
+// what the orrery reads off the sky, from the earth. angles are in radians
+typedef struct{
+	double planets[9][3];  // heliocentric
+	double moon[3];  // around the earth
+	double longitude[9], latitude[9], distance[9];  // ecliptic, the earth's are 0
+	double direction[9][3];  // unit vectors from the earth
+	double moonLongitude, moonLatitude, moonDistance, moonDirection[3];
+	double sunLongitude, sunDistance;
+	double moonPhase;  // 0 new, pi full
+	double daylightHours;  // around 40 N
+	int zodiac;  // 0 Aries to 11 Pisces
+} EphemerisSky;
+void ephemerisSky(const Ephemeris *ephemeris, double day, EphemerisSky *sky);  // ephemeris NULL: computed directly
+
+// rows from firstDay to lastDay, "step" days apart, computed across threads and
+// written a block at a time, so memory doesn't grow with the rows. CSV has
+// example 7's columns. binary is columnar: a header ("EPHEMRS1", uint32 columns,
+// uint32 rows per block, uint64 rows, double first day, double step, a 32 byte
+// name per column), then blocks of a uint32 row count followed by each column's
+// doubles. returns the rows written, -1 if the file can't be
+enum{ EPHEMERIS_CSV, EPHEMERIS_BINARY };
+long exportEphemeris(const char *path, double firstDay, double lastDay, double step, int format, int threads);
+
+// days since J2000 (noon, January 1st 2000), Gregorian calendar, and back
+double ephemerisDay(int year, int month, int day, int hour, int minute, double second);
+void ephemerisDate(double day, int date[6]);  // year, month, day, hour, minute, second
+
+#endif
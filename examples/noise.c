@@ -3,20 +3,30 @@
 
 #include "noise.h"
 
-#define NOISE_B 0x100
 #define NOISE_BM 0xff
 
 #define NOISE_N 0x1000
 #define NOISE_NP 12   /* 2^N */
 #define NOISE_NM 0xfff
 
-static int p[NOISE_B + NOISE_B + 2];
-static float g3[NOISE_B + NOISE_B + 2][3];
-static float g2[NOISE_B + NOISE_B + 2][2];
-static float g1[NOISE_B + NOISE_B + 2];
-static int start = 1;
+/* the tables behind noise1/2/3, built once from random() */
+static NoiseGenerator default_noise;
+static pthread_once_t default_noise_once = PTHREAD_ONCE_INIT;
 
-static void init_noise(void);
+static void init_noise(NoiseGenerator *g, unsigned int *seed);
+
+static void init_default_noise(void)
+{
+	init_noise(&default_noise, NULL);
+}
+
+static const NoiseGenerator *noise_tables(const NoiseGenerator *generator)
+{
+	if (generator != NULL)
+		return generator;
+	pthread_once(&default_noise_once, init_default_noise);
+	return &default_noise;
+}
 
 #define s_curve(t) ( t * t * (3. - 2. * t) )
 
@@ -34,89 +44,90 @@ double peach()
     return 0.5;
 }
 
-double noise1(double arg)
+double generatorNoise1(const NoiseGenerator *generator, double arg)
 {
+	const NoiseGenerator *g = noise_tables(generator);
 	int bx0, bx1;
 	float rx0, rx1, sx, t, u, v, vec[1];
     
 	vec[0] = arg;
-	if (start) {
-		start = 0;
-		init_noise();
-	}
     
 	setup_noise(0, bx0,bx1, rx0,rx1);
     
 	sx = s_curve(rx0);
     
-	u = rx0 * g1[ p[ bx0 ] ];
-	v = rx1 * g1[ p[ bx1 ] ];
+	u = rx0 * g->g1[ g->p[ bx0 ] ];
+	v = rx1 * g->g1[ g->p[ bx1 ] ];
     
 	return lerp(sx, u, v);
 }
 
-float noise2(float vec[2])
+double noise1(double arg)
 {
+	return generatorNoise1(NULL, arg);
+}
+
+float generatorNoise2(const NoiseGenerator *generator, float vec[2])
+{
+	const NoiseGenerator *g = noise_tables(generator);
 	int bx0, bx1, by0, by1, b00, b10, b01, b11;
-	float rx0, rx1, ry0, ry1, *q, sx, sy, a, b, t, u, v;
+	float rx0, rx1, ry0, ry1, sx, sy, a, b, t, u, v;
+	const float *q;
 	int i;
     int j;
     
-	if (start) {
-		start = 0;
-		init_noise();
-	}
-    
 	setup_noise(0, bx0,bx1, rx0,rx1);
 	setup_noise(1, by0,by1, ry0,ry1);
     
-	i = p[ bx0 ];
-	j = p[ bx1 ];
+	i = g->p[ bx0 ];
+	j = g->p[ bx1 ];
     
-	b00 = p[ i + by0 ];
-	b10 = p[ j + by0 ];
-	b01 = p[ i + by1 ];
-	b11 = p[ j + by1 ];
+	b00 = g->p[ i + by0 ];
+	b10 = g->p[ j + by0 ];
+	b01 = g->p[ i + by1 ];
+	b11 = g->p[ j + by1 ];
     
 	sx = s_curve(rx0);
 	sy = s_curve(ry0);
     
 #define at2(rx,ry) ( rx * q[0] + ry * q[1] )
     
-	q = g2[ b00 ] ; u = at2(rx0,ry0);
-	q = g2[ b10 ] ; v = at2(rx1,ry0);
+	q = g->g2[ b00 ] ; u = at2(rx0,ry0);
+	q = g->g2[ b10 ] ; v = at2(rx1,ry0);
 	a = lerp(sx, u, v);
     
-	q = g2[ b01 ] ; u = at2(rx0,ry1);
-	q = g2[ b11 ] ; v = at2(rx1,ry1);
+	q = g->g2[ b01 ] ; u = at2(rx0,ry1);
+	q = g->g2[ b11 ] ; v = at2(rx1,ry1);
 	b = lerp(sx, u, v);
     
 	return lerp(sy, a, b);
 }
 
-float noise3(float vec[3])
+float noise2(float vec[2])
 {
+	return generatorNoise2(NULL, vec);
+}
+
+float generatorNoise3(const NoiseGenerator *generator, float vec[3])
+{
+	const NoiseGenerator *g = noise_tables(generator);
 	int bx0, bx1, by0, by1, bz0, bz1, b00, b10, b01, b11;
-	float rx0, rx1, ry0, ry1, rz0, rz1, *q, sy, sz, a, b, c, d, t, u, v;
+	float rx0, rx1, ry0, ry1, rz0, rz1, sy, sz, a, b, c, d, t, u, v;
+	const float *q;
     int i;
     int j;
     
-	if (start) {
-		start = 0;
-		init_noise();
-	}
-    
 	setup_noise(0, bx0,bx1, rx0,rx1);
 	setup_noise(1, by0,by1, ry0,ry1);
 	setup_noise(2, bz0,bz1, rz0,rz1);
     
-	i = p[ bx0 ];
-	j = p[ bx1 ];
+	i = g->p[ bx0 ];
+	j = g->p[ bx1 ];
     
-	b00 = p[ i + by0 ];
-	b10 = p[ j + by0 ];
-	b01 = p[ i + by1 ];
-	b11 = p[ j + by1 ];
+	b00 = g->p[ i + by0 ];
+	b10 = g->p[ j + by0 ];
+	b01 = g->p[ i + by1 ];
+	b11 = g->p[ j + by1 ];
     
 	t  = s_curve(rx0);
 	sy = s_curve(ry0);
@@ -124,22 +135,22 @@ float noise3(float vec[3])
     
 #define at3(rx,ry,rz) ( rx * q[0] + ry * q[1] + rz * q[2] )
     
-	q = g3[ b00 + bz0 ] ; u = at3(rx0,ry0,rz0);
-	q = g3[ b10 + bz0 ] ; v = at3(rx1,ry0,rz0);
+	q = g->g3[ b00 + bz0 ] ; u = at3(rx0,ry0,rz0);
+	q = g->g3[ b10 + bz0 ] ; v = at3(rx1,ry0,rz0);
 	a = lerp(t, u, v);
     
-	q = g3[ b01 + bz0 ] ; u = at3(rx0,ry1,rz0);
-	q = g3[ b11 + bz0 ] ; v = at3(rx1,ry1,rz0);
+	q = g->g3[ b01 + bz0 ] ; u = at3(rx0,ry1,rz0);
+	q = g->g3[ b11 + bz0 ] ; v = at3(rx1,ry1,rz0);
 	b = lerp(t, u, v);
     
 	c = lerp(sy, a, b);
     
-	q = g3[ b00 + bz1 ] ; u = at3(rx0,ry0,rz1);
-	q = g3[ b10 + bz1 ] ; v = at3(rx1,ry0,rz1);
+	q = g->g3[ b00 + bz1 ] ; u = at3(rx0,ry0,rz1);
+	q = g->g3[ b10 + bz1 ] ; v = at3(rx1,ry0,rz1);
 	a = lerp(t, u, v);
     
-	q = g3[ b01 + bz1 ] ; u = at3(rx0,ry1,rz1);
-	q = g3[ b11 + bz1 ] ; v = at3(rx1,ry1,rz1);
+	q = g->g3[ b01 + bz1 ] ; u = at3(rx0,ry1,rz1);
+	q = g->g3[ b11 + bz1 ] ; v = at3(rx1,ry1,rz1);
 	b = lerp(t, u, v);
     
 	d = lerp(sy, a, b);
@@ -147,6 +158,11 @@ float noise3(float vec[3])
 	return lerp(sz, c, d);
 }
 
+float noise3(float vec[3])
+{
+	return generatorNoise3(NULL, vec);
+}
+
 static void normalize2(float v[2])
 {
 	float s;
@@ -166,36 +182,654 @@ static void normalize3(float v[3])
 	v[2] = v[2] / s;
 }
 
-static void init_noise(void)
+/* random() for the default tables. seeded tables use their own generator
+   (xorshift) so they repeat exactly and can be built from any thread */
+static long noise_random(unsigned int *seed)
+{
+	if (seed == NULL)
+		return random();
+	*seed ^= *seed << 13;
+	*seed ^= *seed >> 17;
+	*seed ^= *seed << 5;
+	return *seed >> 1;
+}
+
+static void init_noise(NoiseGenerator *g, unsigned int *seed)
 {
 	int i, j, k;
     
 	for (i = 0 ; i < NOISE_B ; i++) {
-		p[i] = i;
+		g->p[i] = i;
         
-		g1[i] = (float)((random() % (NOISE_B + NOISE_B)) - NOISE_B) / NOISE_B;
+		g->g1[i] = (float)((noise_random(seed) % (NOISE_B + NOISE_B)) - NOISE_B) / NOISE_B;
         
 		for (j = 0 ; j < 2 ; j++)
-			g2[i][j] = (float)((random() % (NOISE_B + NOISE_B)) - NOISE_B) / NOISE_B;
-		normalize2(g2[i]);
+			g->g2[i][j] = (float)((noise_random(seed) % (NOISE_B + NOISE_B)) - NOISE_B) / NOISE_B;
+		normalize2(g->g2[i]);
         
 		for (j = 0 ; j < 3 ; j++)
-			g3[i][j] = (float)((random() % (NOISE_B + NOISE_B)) - NOISE_B) / NOISE_B;
-		normalize3(g3[i]);
+			g->g3[i][j] = (float)((noise_random(seed) % (NOISE_B + NOISE_B)) - NOISE_B) / NOISE_B;
+		normalize3(g->g3[i]);
 	}
     
 	while (--i) {
-		k = p[i];
-		p[i] = p[j = random() % NOISE_B];
-		p[j] = k;
+		k = g->p[i];
+		g->p[i] = g->p[j = noise_random(seed) % NOISE_B];
+		g->p[j] = k;
 	}
     
 	for (i = 0 ; i < NOISE_B + 2 ; i++) {
-		p[NOISE_B + i] = p[i];
-		g1[NOISE_B + i] = g1[i];
+		g->p[NOISE_B + i] = g->p[i];
+		g->g1[NOISE_B + i] = g->g1[i];
 		for (j = 0 ; j < 2 ; j++)
-			g2[NOISE_B + i][j] = g2[i][j];
+			g->g2[NOISE_B + i][j] = g->g2[i][j];
 		for (j = 0 ; j < 3 ; j++)
-			g3[NOISE_B + i][j] = g3[i][j];
+			g->g3[NOISE_B + i][j] = g->g3[i][j];
+	}
+}
+
+void initNoiseGenerator(NoiseGenerator *generator, unsigned int seed)
+{
+	unsigned int state = seed * 2654435761u + 1;  /* xorshift must not start at 0 */
+
+	if (state == 0)
+		state = 1;
+	init_noise(generator, &state);
+}
+
+/* batches: the same math as noise2/noise3 several points at a time. table
+   lookups use gathers with AVX2, and scalar loads into vectors with SSE2 */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NOISE_LANES 8
+typedef __m256 vfloat;
+typedef __m256i vint;
+#define vf_load(a) _mm256_loadu_ps(a)
+#define vf_store(a, v) _mm256_storeu_ps(a, v)
+#define vf_set(f) _mm256_set1_ps(f)
+#define vf_add(a, b) _mm256_add_ps(a, b)
+#define vf_sub(a, b) _mm256_sub_ps(a, b)
+#define vf_mul(a, b) _mm256_mul_ps(a, b)
+#define vf_truncate(a) _mm256_cvttps_epi32(a)
+#define vi_to_float(a) _mm256_cvtepi32_ps(a)
+#define vi_set(i) _mm256_set1_epi32(i)
+#define vi_add(a, b) _mm256_add_epi32(a, b)
+#define vi_and(a, b) _mm256_and_si256(a, b)
+#define vi_gather(table, index) _mm256_i32gather_epi32(table, index, 4)
+#define vf_gather(table, index) _mm256_i32gather_ps(table, index, 4)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define NOISE_LANES 4
+typedef __m128 vfloat;
+typedef __m128i vint;
+#define vf_load(a) _mm_loadu_ps(a)
+#define vf_store(a, v) _mm_storeu_ps(a, v)
+#define vf_set(f) _mm_set1_ps(f)
+#define vf_add(a, b) _mm_add_ps(a, b)
+#define vf_sub(a, b) _mm_sub_ps(a, b)
+#define vf_mul(a, b) _mm_mul_ps(a, b)
+#define vf_truncate(a) _mm_cvttps_epi32(a)
+#define vi_to_float(a) _mm_cvtepi32_ps(a)
+#define vi_set(i) _mm_set1_epi32(i)
+#define vi_add(a, b) _mm_add_epi32(a, b)
+#define vi_and(a, b) _mm_and_si128(a, b)
+static inline vint vi_gather(const int *table, vint index)
+{
+	int i[4] __attribute__((aligned(16)));
+	_mm_store_si128((vint*)i, index);
+	return _mm_setr_epi32(table[i[0]], table[i[1]], table[i[2]], table[i[3]]);
+}
+static inline vfloat vf_gather(const float *table, vint index)
+{
+	int i[4] __attribute__((aligned(16)));
+	_mm_store_si128((vint*)i, index);
+	return _mm_setr_ps(table[i[0]], table[i[1]], table[i[2]], table[i[3]]);
+}
+#endif
+
+#ifdef NOISE_LANES
+
+#define vf_s_curve(t) vf_mul(vf_mul(t, t), vf_sub(vf_set(3.0f), vf_mul(vf_set(2.0f), t)))
+#define vf_lerp(t, a, b) vf_add(a, vf_mul(t, vf_sub(b, a)))
+
+#define vsetup_noise(in,b0,b1,r0,r1)\
+t = vf_add(vf_load(in), vf_set(NOISE_N));\
+ti = vf_truncate(t);\
+b0 = vi_and(ti, vi_set(NOISE_BM));\
+b1 = vi_and(vi_add(b0, vi_set(1)), vi_set(NOISE_BM));\
+r0 = vf_sub(t, vi_to_float(ti));\
+r1 = vf_sub(r0, vf_set(1.0f));
+
+/* rx * q[0] + ry * q[1] for the gradient at g2[index] */
+static inline vfloat vat2(const NoiseGenerator *g, vint index, vfloat rx, vfloat ry)
+{
+	vint i2 = vi_add(index, index);
+	const float *table = &g->g2[0][0];
+	return vf_add(vf_mul(rx, vf_gather(table, i2)), vf_mul(ry, vf_gather(table, vi_add(i2, vi_set(1)))));
+}
+
+static inline vfloat vat3(const NoiseGenerator *g, vint index, vfloat rx, vfloat ry, vfloat rz)
+{
+	vint i3 = vi_add(vi_add(index, index), index);
+	const float *table = &g->g3[0][0];
+	return vf_add(vf_add(vf_mul(rx, vf_gather(table, i3)),
+	                     vf_mul(ry, vf_gather(table, vi_add(i3, vi_set(1))))),
+	                     vf_mul(rz, vf_gather(table, vi_add(i3, vi_set(2)))));
+}
+
+static vfloat vnoise2(const NoiseGenerator *g, const float *x, const float *y)
+{
+	vint bx0, bx1, by0, by1, b00, b10, b01, b11, i, j, ti;
+	vfloat rx0, rx1, ry0, ry1, sx, sy, a, b, t, u, v;
+
+	vsetup_noise(x, bx0,bx1, rx0,rx1);
+	vsetup_noise(y, by0,by1, ry0,ry1);
+
+	i = vi_gather(g->p, bx0);
+	j = vi_gather(g->p, bx1);
+
+	b00 = vi_gather(g->p, vi_add(i, by0));
+	b10 = vi_gather(g->p, vi_add(j, by0));
+	b01 = vi_gather(g->p, vi_add(i, by1));
+	b11 = vi_gather(g->p, vi_add(j, by1));
+
+	sx = vf_s_curve(rx0);
+	sy = vf_s_curve(ry0);
+
+	u = vat2(g, b00, rx0, ry0);
+	v = vat2(g, b10, rx1, ry0);
+	a = vf_lerp(sx, u, v);
+
+	u = vat2(g, b01, rx0, ry1);
+	v = vat2(g, b11, rx1, ry1);
+	b = vf_lerp(sx, u, v);
+
+	return vf_lerp(sy, a, b);
+}
+
+static vfloat vnoise3(const NoiseGenerator *g, const float *x, const float *y, const float *z)
+{
+	vint bx0, bx1, by0, by1, bz0, bz1, b00, b10, b01, b11, i, j, ti;
+	vfloat rx0, rx1, ry0, ry1, rz0, rz1, sy, sz, a, b, c, d, t, u, v;
+
+	vsetup_noise(x, bx0,bx1, rx0,rx1);
+	vsetup_noise(y, by0,by1, ry0,ry1);
+	vsetup_noise(z, bz0,bz1, rz0,rz1);
+
+	i = vi_gather(g->p, bx0);
+	j = vi_gather(g->p, bx1);
+
+	b00 = vi_gather(g->p, vi_add(i, by0));
+	b10 = vi_gather(g->p, vi_add(j, by0));
+	b01 = vi_gather(g->p, vi_add(i, by1));
+	b11 = vi_gather(g->p, vi_add(j, by1));
+
+	t  = vf_s_curve(rx0);
+	sy = vf_s_curve(ry0);
+	sz = vf_s_curve(rz0);
+
+	u = vat3(g, vi_add(b00, bz0), rx0, ry0, rz0);
+	v = vat3(g, vi_add(b10, bz0), rx1, ry0, rz0);
+	a = vf_lerp(t, u, v);
+
+	u = vat3(g, vi_add(b01, bz0), rx0, ry1, rz0);
+	v = vat3(g, vi_add(b11, bz0), rx1, ry1, rz0);
+	b = vf_lerp(t, u, v);
+
+	c = vf_lerp(sy, a, b);
+
+	u = vat3(g, vi_add(b00, bz1), rx0, ry0, rz1);
+	v = vat3(g, vi_add(b10, bz1), rx1, ry0, rz1);
+	a = vf_lerp(t, u, v);
+
+	u = vat3(g, vi_add(b01, bz1), rx0, ry1, rz1);
+	v = vat3(g, vi_add(b11, bz1), rx1, ry1, rz1);
+	b = vf_lerp(t, u, v);
+
+	d = vf_lerp(sy, a, b);
+
+	return vf_lerp(sz, c, d);
+}
+
+#endif /* NOISE_LANES */
+
+void noise2Batch(const NoiseGenerator *generator, const float *x, const float *y, float *out, int count)
+{
+	const NoiseGenerator *g = noise_tables(generator);
+	int i = 0;
+
+#ifdef NOISE_LANES
+	for ( ; i + NOISE_LANES <= count ; i += NOISE_LANES)
+		vf_store(&out[i], vnoise2(g, &x[i], &y[i]));
+#endif
+	for ( ; i < count ; i++) {
+		float vec[2] = {x[i], y[i]};
+		out[i] = generatorNoise2(g, vec);
+	}
+}
+
+void noise3Batch(const NoiseGenerator *generator, const float *x, const float *y, const float *z, float *out, int count)
+{
+	const NoiseGenerator *g = noise_tables(generator);
+	int i = 0;
+
+#ifdef NOISE_LANES
+	for ( ; i + NOISE_LANES <= count ; i += NOISE_LANES)
+		vf_store(&out[i], vnoise3(g, &x[i], &y[i], &z[i]));
+#endif
+	for ( ; i < count ; i++) {
+		float vec[3] = {x[i], y[i], z[i]};
+		out[i] = generatorNoise3(g, vec);
+	}
+}
+
+/* simplex noise over 2, 3 or 4 dimensions, after Stefan Gustavson's sdnoise.
+   a simplex has N+1 corners where a Perlin cell has 2^N, and the analytic
+   derivative comes at little extra cost. hashes come from the generator's
+   permutation table, gradients from fixed tables. every corner's influence
+   fades out at a squared radius of 0.5, larger radii leave seams between
+   simplices in 3D and 4D. the final factors scale the output to about -1, 1 */
+
+static const float grad2lut[8][2] = {
+	{-1,-1}, {1,0}, {-1,0}, {1,1}, {-1,1}, {0,-1}, {0,1}, {1,-1}
+};
+
+static const float grad3lut[16][3] = {
+	{1,0,1}, {0,1,1}, {-1,0,1}, {0,-1,1},
+	{1,0,-1}, {0,1,-1}, {-1,0,-1}, {0,-1,-1},
+	{1,-1,0}, {1,1,0}, {-1,1,0}, {-1,-1,0},
+	{1,0,1}, {-1,0,1}, {0,1,-1}, {0,-1,-1}
+};
+
+static const float grad4lut[32][4] = {
+	{0,1,1,1}, {0,1,1,-1}, {0,1,-1,1}, {0,1,-1,-1},
+	{0,-1,1,1}, {0,-1,1,-1}, {0,-1,-1,1}, {0,-1,-1,-1},
+	{1,0,1,1}, {1,0,1,-1}, {1,0,-1,1}, {1,0,-1,-1},
+	{-1,0,1,1}, {-1,0,1,-1}, {-1,0,-1,1}, {-1,0,-1,-1},
+	{1,1,0,1}, {1,1,0,-1}, {1,-1,0,1}, {1,-1,0,-1},
+	{-1,1,0,1}, {-1,1,0,-1}, {-1,-1,0,1}, {-1,-1,0,-1},
+	{1,1,1,0}, {1,1,-1,0}, {1,-1,1,0}, {1,-1,-1,0},
+	{-1,1,1,0}, {-1,1,-1,0}, {-1,-1,1,0}, {-1,-1,-1,0}
+};
+
+#define F2 0.366025403f  /* 0.5*(sqrt(3)-1) */
+#define G2 0.211324865f  /* (3-sqrt(3))/6 */
+#define F3 0.333333333f
+#define G3 0.166666667f
+#define F4 0.309016994f  /* (sqrt(5)-1)/4 */
+#define G4 0.138196601f  /* (5-sqrt(5))/20 */
+
+/* without branches: the comparisons are unpredictable on real input */
+static inline int fast_floor(float x)
+{
+	int i = (int)x;
+	return i - (x < i);
+}
+
+float generatorSimplex2(const NoiseGenerator *generator, const float vec[2], float derivative[2])
+{
+	const int *perm = noise_tables(generator)->p;
+	float x = vec[0], y = vec[1];
+	float pos[3][2], t[3], dot[3], n = 0, dx = 0, dy = 0;
+	const float *g[3];
+	int i, j, i1, j1, ii, jj, c;
+
+	/* skew to find the cell, unskew to get the distance to its origin */
+	float s = (x + y) * F2;
+	i = fast_floor(x + s);
+	j = fast_floor(y + s);
+	float u = (i + j) * G2;
+	pos[0][0] = x - (i - u);
+	pos[0][1] = y - (j - u);
+	/* which of the two triangles */
+	i1 = pos[0][0] > pos[0][1];
+	j1 = 1 - i1;
+	pos[1][0] = pos[0][0] - i1 + G2;
+	pos[1][1] = pos[0][1] - j1 + G2;
+	pos[2][0] = pos[0][0] - 1.0f + 2.0f * G2;
+	pos[2][1] = pos[0][1] - 1.0f + 2.0f * G2;
+
+	ii = i & NOISE_BM;
+	jj = j & NOISE_BM;
+	g[0] = grad2lut[ perm[ii + perm[jj]] & 7 ];
+	g[1] = grad2lut[ perm[ii + i1 + perm[jj + j1]] & 7 ];
+	g[2] = grad2lut[ perm[ii + 1 + perm[jj + 1]] & 7 ];
+
+	for (c = 0 ; c < 3 ; c++) {
+		t[c] = 0.5f - pos[c][0] * pos[c][0] - pos[c][1] * pos[c][1];
+		t[c] = (t[c] < 0) ? 0 : t[c];
+		dot[c] = g[c][0] * pos[c][0] + g[c][1] * pos[c][1];
+		n += t[c] * t[c] * t[c] * t[c] * dot[c];
+	}
+	if (derivative != NULL) {
+		for (c = 0 ; c < 3 ; c++) {
+			float t2 = t[c] * t[c];
+			float falloff = -8.0f * t2 * t[c] * dot[c];
+			dx += falloff * pos[c][0] + t2 * t2 * g[c][0];
+			dy += falloff * pos[c][1] + t2 * t2 * g[c][1];
+		}
+		derivative[0] = 70.0f * dx;
+		derivative[1] = 70.0f * dy;
+	}
+	return 70.0f * n;  /* about -1 to 1 */
+}
+
+float generatorSimplex3(const NoiseGenerator *generator, const float vec[3], float derivative[3])
+{
+	const int *perm = noise_tables(generator)->p;
+	float x = vec[0], y = vec[1], z = vec[2];
+	float pos[4][3], t[4], dot[4], n = 0, d[3] = {0, 0, 0};
+	const float *g[4];
+	int i, j, k, i1, j1, k1, i2, j2, k2, ii, jj, kk, c, a;
+
+	float s = (x + y + z) * F3;
+	i = fast_floor(x + s);
+	j = fast_floor(y + s);
+	k = fast_floor(z + s);
+	float u = (i + j + k) * G3;
+	pos[0][0] = x - (i - u);
+	pos[0][1] = y - (j - u);
+	pos[0][2] = z - (k - u);
+	/* which of the six tetrahedra: rank the offsets, the corners step along
+	   the largest first */
+	float x0 = pos[0][0], y0 = pos[0][1], z0 = pos[0][2];
+	int rx = (x0 >= y0) + (x0 >= z0);
+	int ry = (y0 > x0) + (y0 >= z0);
+	int rz = (z0 > x0) + (z0 > y0);
+	i1 = rx >= 2; j1 = ry >= 2; k1 = rz >= 2;
+	i2 = rx >= 1; j2 = ry >= 1; k2 = rz >= 1;
+	pos[1][0] = x0 - i1 + G3;  pos[1][1] = y0 - j1 + G3;  pos[1][2] = z0 - k1 + G3;
+	pos[2][0] = x0 - i2 + 2.0f * G3;  pos[2][1] = y0 - j2 + 2.0f * G3;  pos[2][2] = z0 - k2 + 2.0f * G3;
+	pos[3][0] = x0 - 1.0f + 3.0f * G3;  pos[3][1] = y0 - 1.0f + 3.0f * G3;  pos[3][2] = z0 - 1.0f + 3.0f * G3;
+
+	ii = i & NOISE_BM;
+	jj = j & NOISE_BM;
+	kk = k & NOISE_BM;
+	g[0] = grad3lut[ perm[ii + perm[jj + perm[kk]]] & 15 ];
+	g[1] = grad3lut[ perm[ii + i1 + perm[jj + j1 + perm[kk + k1]]] & 15 ];
+	g[2] = grad3lut[ perm[ii + i2 + perm[jj + j2 + perm[kk + k2]]] & 15 ];
+	g[3] = grad3lut[ perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]] & 15 ];
+
+	for (c = 0 ; c < 4 ; c++) {
+		t[c] = 0.5f - pos[c][0] * pos[c][0] - pos[c][1] * pos[c][1] - pos[c][2] * pos[c][2];
+		t[c] = (t[c] < 0) ? 0 : t[c];
+		dot[c] = g[c][0] * pos[c][0] + g[c][1] * pos[c][1] + g[c][2] * pos[c][2];
+		n += t[c] * t[c] * t[c] * t[c] * dot[c];
+	}
+	if (derivative != NULL) {
+		for (c = 0 ; c < 4 ; c++) {
+			float t2 = t[c] * t[c];
+			float falloff = -8.0f * t2 * t[c] * dot[c];
+			for (a = 0 ; a < 3 ; a++)
+				d[a] += falloff * pos[c][a] + t2 * t2 * g[c][a];
+		}
+		for (a = 0 ; a < 3 ; a++)
+			derivative[a] = 76.0f * d[a];
+	}
+	return 76.0f * n;
+}
+
+float generatorSimplex4(const NoiseGenerator *generator, const float vec[4], float derivative[4])
+{
+	const int *perm = noise_tables(generator)->p;
+	float pos[5][4], t[5], dot[5], n = 0, d[4] = {0, 0, 0, 0};
+	int cell[4], rank[4] = {0, 0, 0, 0}, offset[5][4], hash[4];
+	const float *g[5];
+	int a, b, c;
+
+	float s = (vec[0] + vec[1] + vec[2] + vec[3]) * F4;
+	for (a = 0 ; a < 4 ; a++)
+		cell[a] = fast_floor(vec[a] + s);
+	float u = (cell[0] + cell[1] + cell[2] + cell[3]) * G4;
+	for (a = 0 ; a < 4 ; a++)
+		pos[0][a] = vec[a] - (cell[a] - u);
+	/* rank the offsets by size, the corners are visited from largest to smallest */
+	for (a = 0 ; a < 4 ; a++)
+		for (b = a + 1 ; b < 4 ; b++) {
+			rank[a] += pos[0][a] > pos[0][b];
+			rank[b] += pos[0][a] <= pos[0][b];
+		}
+	for (a = 0 ; a < 4 ; a++) {
+		offset[0][a] = 0;
+		offset[1][a] = rank[a] >= 3;
+		offset[2][a] = rank[a] >= 2;
+		offset[3][a] = rank[a] >= 1;
+		offset[4][a] = 1;
+		hash[a] = cell[a] & NOISE_BM;
+	}
+	for (c = 0 ; c < 5 ; c++) {
+		for (a = 0 ; a < 4 ; a++)
+			pos[c][a] = pos[0][a] - offset[c][a] + c * G4;
+		int h = perm[hash[0] + offset[c][0] + perm[hash[1] + offset[c][1] + perm[hash[2] + offset[c][2] + perm[hash[3] + offset[c][3]]]]];
+		g[c] = grad4lut[ h & 31 ];
+	}
+
+	for (c = 0 ; c < 5 ; c++) {
+		t[c] = 0.5f;
+		for (a = 0 ; a < 4 ; a++)
+			t[c] -= pos[c][a] * pos[c][a];
+		t[c] = (t[c] < 0) ? 0 : t[c];
+		dot[c] = g[c][0] * pos[c][0] + g[c][1] * pos[c][1] + g[c][2] * pos[c][2] + g[c][3] * pos[c][3];
+		n += t[c] * t[c] * t[c] * t[c] * dot[c];
+	}
+	if (derivative != NULL) {
+		for (c = 0 ; c < 5 ; c++) {
+			float t2 = t[c] * t[c];
+			float falloff = -8.0f * t2 * t[c] * dot[c];
+			for (a = 0 ; a < 4 ; a++)
+				d[a] += falloff * pos[c][a] + t2 * t2 * g[c][a];
+		}
+		for (a = 0 ; a < 4 ; a++)
+			derivative[a] = 62.0f * d[a];
+	}
+	return 62.0f * n;
+}
+
+float simplex2(float vec[2])
+{
+	return generatorSimplex2(NULL, vec, NULL);
+}
+
+float simplex3(float vec[3])
+{
+	return generatorSimplex3(NULL, vec, NULL);
+}
+
+float simplex4(float vec[4])
+{
+	return generatorSimplex4(NULL, vec, NULL);
+}
+
+/* pick the backend per call. Perlin derivatives are taken by central differences */
+float sampleNoise(const NoiseGenerator *generator, int type, int dimensions, const float *vec, float *derivative)
+{
+	float v[4], h = 1.0f / 256, a, b;
+	int i;
+
+	if (type == NOISE_SIMPLEX) {
+		switch (dimensions) {
+			case 2: return generatorSimplex2(generator, vec, derivative);
+			case 3: return generatorSimplex3(generator, vec, derivative);
+			case 4: return generatorSimplex4(generator, vec, derivative);
+		}
+		return 0;
+	}
+	if (dimensions < 1 || dimensions > 3)
+		return 0;
+	if (derivative != NULL) {
+		for (i = 0 ; i < dimensions ; i++) {
+			memcpy(v, vec, sizeof(float) * dimensions);
+			v[i] = vec[i] + h;
+			a = sampleNoise(generator, type, dimensions, v, NULL);
+			v[i] = vec[i] - h;
+			b = sampleNoise(generator, type, dimensions, v, NULL);
+			derivative[i] = (a - b) / (2 * h);
+		}
+	}
+	memcpy(v, vec, sizeof(float) * dimensions);
+	switch (dimensions) {
+		case 1: return generatorNoise1(generator, v[0]);
+		case 2: return generatorNoise2(generator, v);
+	}
+	return generatorNoise3(generator, v);
+}
+
+/* fractal noise */
+
+#define FBM_MAX_OCTAVES 32
+
+/* integer hash, turns (seed, octave) into a repeatable offset */
+static unsigned int fbm_hash(unsigned int x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352d;
+	x ^= x >> 15;
+	x *= 0x846ca68b;
+	x ^= x >> 16;
+	return x;
+}
+
+static void fbm_offsets(const FractalNoise *fractal, float offsets[][2])
+{
+	int o;
+
+	for (o = 0 ; o < fractal->octaves && o < FBM_MAX_OCTAVES ; o++) {
+		offsets[o][0] = (fbm_hash(fractal->seed * 2 * FBM_MAX_OCTAVES + o * 2 + 0) & 0xffff) / 256.0f;
+		offsets[o][1] = (fbm_hash(fractal->seed * 2 * FBM_MAX_OCTAVES + o * 2 + 1) & 0xffff) / 256.0f;
+	}
+}
+
+static float fbm_sample(const FractalNoise *fractal, float offsets[][2], float x, float y)
+{
+	float freq = fractal->frequency;
+	float amp = fractal->amplitude;
+	float sum = 0;
+	float vec[2];
+	int o;
+
+	for (o = 0 ; o < fractal->octaves && o < FBM_MAX_OCTAVES ; o++) {
+		vec[0] = x * freq + offsets[o][0];
+		vec[1] = y * freq + offsets[o][1];
+		sum += (fractal->type == NOISE_SIMPLEX) ? generatorSimplex2(fractal->generator, vec, NULL) * amp
+		                                       : generatorNoise2(fractal->generator, vec) * amp;
+		freq *= fractal->lacunarity;
+		amp *= fractal->gain;
+	}
+	return sum;
+}
+
+float fbm2(const FractalNoise *fractal, float x, float y)
+{
+	float offsets[FBM_MAX_OCTAVES][2];
+
+	fbm_offsets(fractal, offsets);
+	return fbm_sample(fractal, offsets, x, y);
+}
+
+typedef struct {
+	const FractalNoise *fractal;
+	float (*offsets)[2];
+	float *out;
+	int columns, first, end, stride;
+	float x, y, step;
+} FbmRows;
+
+/* a row at a time: each octave is one batch over the row, added in place */
+static void *fbm_rows(void *arg)
+{
+	FbmRows *rows = (FbmRows*)arg;
+	const FractalNoise *fractal = rows->fractal;
+	float *x = (float*)malloc(sizeof(float) * rows->columns * 4);
+	float *y = &x[rows->columns];
+	float *value = &x[rows->columns * 2];
+	float *sum = &x[rows->columns * 3];
+	int r, c, o;
+
+	for (r = rows->first ; r < rows->end ; r++) {
+		float freq = fractal->frequency;
+		float amp = fractal->amplitude;
+		for (c = 0 ; c < rows->columns ; c++)
+			sum[c] = 0;
+		for (o = 0 ; o < fractal->octaves && o < FBM_MAX_OCTAVES ; o++) {
+			for (c = 0 ; c < rows->columns ; c++) {
+				x[c] = (rows->x + c * rows->step) * freq + rows->offsets[o][0];
+				y[c] = (rows->y + r * rows->step) * freq + rows->offsets[o][1];
+			}
+			if (fractal->type == NOISE_SIMPLEX) {
+				for (c = 0 ; c < rows->columns ; c++) {
+					float vec[2] = {x[c], y[c]};
+					value[c] = generatorSimplex2(fractal->generator, vec, NULL);
+				}
+			}
+			else
+				noise2Batch(fractal->generator, x, y, value, rows->columns);
+			for (c = 0 ; c < rows->columns ; c++)
+				sum[c] += value[c] * amp;
+			freq *= fractal->lacunarity;
+			amp *= fractal->gain;
+		}
+		float *out = &rows->out[(size_t)r * rows->columns * rows->stride];
+		for (c = 0 ; c < rows->columns ; c++)
+			out[c * rows->stride] = sum[c];
 	}
-}
\ No newline at end of file
+	free(x);
+	return NULL;
+}
+
+#ifdef WORLD_FRAMEWORK
+/* with world.h the rows go to its worker pool */
+static void fbm_band(void *context, int first, int end)
+{
+	FbmRows band = *(FbmRows*)context;
+	band.first = first;
+	band.end = end;
+	fbm_rows(&band);
+}
+#endif
+
+void fbmGrid(const FractalNoise *fractal, float *out, int columns, int rows, float x, float y, float step, int stride, int threads)
+{
+	float offsets[FBM_MAX_OCTAVES][2];
+
+	fbm_offsets(fractal, offsets);
+#ifdef WORLD_FRAMEWORK
+	FbmRows all = {fractal, offsets, out, columns, 0, rows, (stride < 1) ? 1 : stride, x, y, step};
+	if (threads == 1)
+		fbm_rows(&all);
+	else
+		parallelFor(0, rows, (threads > 0) ? (rows + threads - 1) / threads : 0, fbm_band, &all);
+#else
+	int i, started;
+	if (threads <= 0)
+		threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads > rows)
+		threads = rows;
+	if (threads < 1)
+		threads = 1;
+
+	pthread_t thread[threads];
+	FbmRows band[threads];
+	for (i = 0 ; i < threads ; i++) {
+		band[i].fractal = fractal;
+		band[i].offsets = offsets;
+		band[i].out = out;
+		band[i].columns = columns;
+		band[i].stride = (stride < 1) ? 1 : stride;
+		band[i].first = rows * i / threads;
+		band[i].end = rows * (i + 1) / threads;
+		band[i].x = x;
+		band[i].y = y;
+		band[i].step = step;
+	}
+	/* the bands whose thread couldn't start are done here, after the first */
+	for (started = 1 ; started < threads ; started++)
+		if (pthread_create(&thread[started], NULL, fbm_rows, &band[started]) != 0)
+			break;
+	fbm_rows(&band[0]);
+	for (i = started ; i < threads ; i++)
+		fbm_rows(&band[i]);
+	for (i = 1 ; i < started ; i++)
+		pthread_join(thread[i], NULL);
+#endif
+}
@@ -4,9 +4,65 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define NOISE_B 0x100
+
+// the gradient and permutation tables. noise1/2/3 use a shared default set,
+// any number of seeded generators can exist alongside it
+typedef struct{
+	int p[NOISE_B + NOISE_B + 2];
+	float g1[NOISE_B + NOISE_B + 2];
+	float g2[NOISE_B + NOISE_B + 2][2];
+	float g3[NOISE_B + NOISE_B + 2][3];
+} NoiseGenerator;
 
 double noise1(double arg);
 float noise2(float vec[2]);
 float noise3(float vec[3]);
 
+// safe to call from any thread. the same seed always builds the same tables
+void initNoiseGenerator(NoiseGenerator *generator, unsigned int seed);
+// generator can be NULL for the default tables
+double generatorNoise1(const NoiseGenerator *generator, double arg);
+float generatorNoise2(const NoiseGenerator *generator, float vec[2]);
+float generatorNoise3(const NoiseGenerator *generator, float vec[3]);
+// count points at once, coordinates in separate arrays. uses AVX2 or SSE2
+// when the compiler targets them, matches the scalar versions to ~1e-6
+void noise2Batch(const NoiseGenerator *generator, const float *x, const float *y, float *out, int count);
+void noise3Batch(const NoiseGenerator *generator, const float *x, const float *y, const float *z, float *out, int count);
+
+// simplex noise: N+1 corners per sample instead of Perlin's 2^N, cheaper in
+// 3D and 4D. about -1 to 1. derivative (d/dx, d/dy...) is filled if not NULL
+float simplex2(float vec[2]);
+float simplex3(float vec[3]);
+float simplex4(float vec[4]);
+float generatorSimplex2(const NoiseGenerator *generator, const float vec[2], float derivative[2]);
+float generatorSimplex3(const NoiseGenerator *generator, const float vec[3], float derivative[3]);
+float generatorSimplex4(const NoiseGenerator *generator, const float vec[4], float derivative[4]);
+
+// either backend chosen per call. Perlin has 1 to 3 dimensions, simplex 2 to 4
+enum{ NOISE_PERLIN, NOISE_SIMPLEX };
+float sampleNoise(const NoiseGenerator *generator, int type, int dimensions, const float *vec, float *derivative);
+
+// fractal noise (fBm): every octave of 2D noise summed per sample
+typedef struct{
+	int octaves;
+	float frequency;  // of the first octave, in noise units per sample
+	float amplitude;  // of the first octave
+	float lacunarity;  // frequency multiplier per octave, usually 2
+	float gain;  // amplitude multiplier per octave, usually 0.5
+	unsigned int seed;  // each octave is shifted by an offset derived from the seed
+	const NoiseGenerator *generator;  // NULL for the default tables
+	int type;  // NOISE_PERLIN or NOISE_SIMPLEX
+} FractalNoise;
+float fbm2(const FractalNoise *fractal, float x, float y);
+// columns * rows samples starting at (x, y), "step" apart. results are written
+// "stride" floats apart (1 for a plain array). rows are split across threads
+// (world.h's worker pool if it was included first), 0 uses one per core. the
+// output only depends on the parameters and seed
+void fbmGrid(const FractalNoise *fractal, float *out, int columns, int rows, float x, float y, float step, int stride, int threads);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+// terrain colored by height and lit by a sun, from what heightmap.vert derived
+
+uniform float u_zscale;  // the height range, ocean to snow
+
+varying vec3 v_normal;
+varying float v_height;
+
+vec3 ramp(float scale){
+	if(scale < 0.3) return vec3(0.0, 0.24, 0.666) + vec3(1.0, 0.76, 0.334) * scale;
+	if(scale < 0.333) return vec3(0.8, 0.5, 0.0);
+	if(scale < 0.8333) return vec3(0.0, 0.5 - 0.2 * (scale - 0.3333) / 0.5, 0.0);
+	float white = min((scale - 0.8333) / 0.1667, 1.0);
+	return vec3(white, 0.3 + 0.7 * white, white);
+}
+
+void main() {
+	float scale = clamp((0.5 * u_zscale + v_height) / u_zscale, 0.0, 1.0);
+	vec3 sun = normalize(vec3(0.3, 0.2, 1.0));
+	float light = 0.35 + 0.65 * max(dot(normalize(v_normal), sun), 0.0);
+	gl_FragColor = vec4(ramp(scale) * light, 1.0);
+}
@@ -0,0 +1,27 @@
+// a flat patch of the terrain, displaced by the height texture (see drawHeightmap)
+
+uniform sampler2D u_heightmap;
+uniform vec2 u_size;      // texels, one per vertex
+uniform vec2 u_patch;     // the patch's first texel
+uniform float u_spacing;  // world units between vertices
+
+varying vec3 v_normal;
+varying float v_height;
+
+float height(vec2 texel){
+	texel = clamp(texel, vec2(0.0), u_size - 1.0);
+	return texture2DLod(u_heightmap, (texel + 0.5) / u_size, 0.0).r;
+}
+
+void main() {
+	// patches hanging past the edge collapse onto the last row and column
+	vec2 texel = min(u_patch + gl_Vertex.xy, u_size - 1.0);
+	float h = height(texel);
+	// central differences, like the grids built on the CPU
+	float dx = height(texel + vec2(1.0, 0.0)) - height(texel - vec2(1.0, 0.0));
+	float dy = height(texel + vec2(0.0, 1.0)) - height(texel - vec2(0.0, 1.0));
+	v_normal = normalize(vec3(-dx, -dy, 2.0 * u_spacing));
+	v_height = h;
+	vec4 position = vec4((texel - u_size * 0.5) * u_spacing, h, 1.0);
+	gl_Position = gl_ModelViewProjectionMatrix * position;
+}
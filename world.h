@@ -6,15 +6,27 @@
 #  include <OpenGL/glu.h>
 #  include <GLUT/glut.h>
 #else
+#  define GL_GLEXT_PROTOTYPES  // buffer objects and shaders are declared in glext.h
 #  include <GL/gl.h>
 #  include <GL/glu.h>
 #  include <GL/glut.h>
 #endif
+#include <stdint.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////////////
 //      WORLD is a hyper minimalist framework for graphics (OpenGL) 
@@ -44,6 +56,13 @@ void worldDelegate(unsigned int code);
 enum { LEFT, RIGHT };
 unsigned char HANDED = LEFT; // 0:left, 1:right. flip coordinate axes orientation.
 #define CONTINUOUS_REFRESH 1  // set 0 for maximum battery efficiency, only redraws screen upon input
+static unsigned char PIPELINE = 0;  // 1: update() runs on its own thread, while the last frame draws. see pipelineState()
+static unsigned char DYNAMIC_RESOLUTION = 0;  // 1: draw3D() renders smaller when it runs over FRAME_BUDGET and is stretched over the window, draw2D() stays sharp
+static float FRAME_BUDGET = 12.0;  // milliseconds of GPU time for the 3D pass, with DYNAMIC_RESOLUTION
+static float RESOLUTION_SCALE = 1.0;  // (readonly) of the 3D pass, from MIN_RESOLUTION_SCALE to 1
+static float MIN_RESOLUTION_SCALE = 0.5;
+static unsigned char STATE_CACHE = 1;  // 1: GL calls that wouldn't change anything are skipped. 0 if something draws wrong after raw GL. see stateCounts()
+static unsigned char SHOW_FRAME_STATS = 0;  // 1: headsUpDisplay() adds a line of frameStats()
 static unsigned char SETTINGS = 0b11111111; // flip bits to turn on and off features. see documentation.
 static unsigned char SIMPLE_SETTINGS = 255;  // simple mode (default) hooks helpful keyboard and visual feedback
 static unsigned char ADVANCED_SETTINGS = 0;
@@ -143,6 +162,307 @@ void setShaderUniformVec3f(GLuint shader, char *uniform, float *array);
 void setShaderUniformVec4f(GLuint shader, char *uniform, float *array);
 void simpleLights();
 void updateTime();
+// COMMAND LISTS: record static draw calls once, replay them every frame
+typedef struct{
+	GLuint list;
+	unsigned long key;  // the inputs this recording was made from, see hashInputs()
+	unsigned char valid;
+} CommandList;
+unsigned char recordCommandList(CommandList *commands, unsigned long key);  // 1: start drawing, then call endCommandList()
+void endCommandList();
+void drawCommandList(CommandList *commands);
+void invalidateCommandList(CommandList *commands);
+void freeCommandList(CommandList *commands);
+unsigned long hashInputs(const void *data, size_t size);
+// MESHES: user geometry kept in static buffers on the GPU (requires OpenGL 1.5)
+enum{ MESH_POSITION, MESH_NORMAL, MESH_COLOR, MESH_TEXCOORD, MESH_INDEX, MESH_ATTRIBUTES };
+typedef struct{
+	GLenum mode;  // GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_POINTS...
+	unsigned int numVertices;
+	unsigned int numIndices;  // 0: draw the vertices in order
+	GLuint buffers[MESH_ATTRIBUTES];  // 0 if the attribute is unused
+	int components[MESH_ATTRIBUTES];  // floats per vertex. indices are 1 uint32_t
+	const void *data[MESH_ATTRIBUTES];  // arrays owned by the caller, re-read by meshDirty()
+	unsigned int dirtyFirst[MESH_ATTRIBUTES], dirtyEnd[MESH_ATTRIBUTES];  // element range to upload before the next draw
+	unsigned char primitiveRestart;  // index 0xFFFFFFFF starts a new strip
+} Mesh;
+Mesh *createMesh(GLenum mode, unsigned int numVertices, unsigned int numIndices);
+void setMeshAttribute(Mesh *mesh, int attribute, int components, const void *data);
+void meshDirty(Mesh *mesh, int attribute, unsigned int first, unsigned int count);
+void updateMesh(Mesh *mesh, int attribute, unsigned int first, unsigned int count, const void *data);
+void drawMesh(Mesh *mesh);
+void freeMesh(Mesh *mesh);
+static unsigned char _primitive_restart = 0;  // GL 3.1, checked by initPrimitives(). without it strips are joined by degenerate triangles
+// GRIDS: heightfield positions, smooth normals and indices built in one pass
+typedef struct{
+	int columns, rows;  // vertices along X and Y
+	float spacing;  // distance between neighboring vertices, the grid is centered on the origin
+	const float *heights;  // columns * rows heights, row by row. or NULL to sample heightFunction
+	float (*heightFunction)(int column, int row, void *context);
+	void *context;
+	const float *offsets;  // optional, 2 floats per vertex added to X and Y
+	unsigned char strips;  // 1: triangle strips split by primitive restart, 0: triangle list
+	int threads;  // rows are split into this many pieces on the worker pool, 0: automatic
+	// output, allocated by buildGrid() and reused when rebuilt at the same size
+	float *positions;
+	float *normals;
+	uint32_t *indices;
+	unsigned int numVertices, numIndices;
+} Grid;
+void buildGrid(Grid *grid);
+Mesh *gridMesh(Grid *grid);  // a mesh drawing the grid's arrays. call meshDirty() after rebuilding
+void freeGrid(Grid *grid);
+// STATIC BATCHES: many unmoving primitives baked into one mesh per material
+enum{ BATCH_TETRAHEDRON, BATCH_OCTAHEDRON, BATCH_HEXAHEDRON, BATCH_ICOSAHEDRON, BATCH_DODECAHEDRON, BATCH_SQUARE, BATCH_SPHERE, BATCH_PRIMITIVES };
+typedef struct{
+	int primitive;  // BATCH_ enum
+	float transform[16];  // column-major, like glMultMatrixf()
+	float color[4];  // alpha 0: no color, the current color / material is used
+	GLuint texture;  // the material. objects sharing a texture share a draw call
+} BatchObject;
+typedef struct{
+	GLuint texture;
+	unsigned char colored;
+	Mesh *mesh;
+	float *positions, *normals, *colors, *texcoords;
+	uint32_t *indices;
+	unsigned int numVertices, numIndices;
+} BatchBucket;
+typedef struct{
+	int bucket;  // -1 once removed
+	int primitive;
+	unsigned int firstVertex, firstIndex;
+} BatchRange;
+typedef struct{
+	int numBuckets;
+	BatchBucket *buckets;
+	int numObjects;
+	BatchRange *ranges;  // one per object, in the order they were given
+} StaticBatch;
+StaticBatch *buildStaticBatch(const BatchObject *objects, int count);
+void setStaticBatchTransform(StaticBatch *batch, int object, const float transform[16]);  // re-bake one object in place
+void removeFromStaticBatch(StaticBatch *batch, int object);
+void drawStaticBatch(StaticBatch *batch);
+void freeStaticBatch(StaticBatch *batch);
+// RENDER QUEUE: draws collected during draw3D() and run sorted by state
+enum{ RENDER_OPAQUE, RENDER_BLENDED };  // opaque run front to back, then blended back to front
+typedef struct{
+	unsigned int draws;
+	int stateChanges;  // shader, texture and pass switches issued by the last flush
+	int stateChangesAvoided;  // compared to running the draws in the order submitted
+} RenderQueueStats;
+void submitDraw(int pass, GLuint shader, GLuint texture, void (*draw)(void *data), void *data);  // captures the current modelview
+void flushRenderQueue();  // called automatically after draw3D()
+RenderQueueStats renderQueueStats();
+// TERRAIN: an endless heightfield streamed in tiles around the camera. tiles
+// are generated on background threads and uploaded a few per frame
+typedef struct{
+	// settings, fill in before the first updateTerrain()
+	int resolution;  // vertices along a tile's edge, neighbors share their edge vertices
+	float tileSize;  // world units
+	int radius;  // tiles kept around the camera in every direction
+	size_t memoryBudget;  // bytes for all tiles, never less than the ring needs. 0: the ring only
+	int uploadsPerFrame;  // 0: 1
+	int threads;  // background workers, 0: one per core less the main thread
+	float (*height)(float x, float y, void *context);  // called from worker threads
+	void (*color)(float x, float y, float height, float rgb[3], void *context);  // optional
+	void *context;
+	// read only
+	unsigned int tilesDrawn, tilesPending;
+	size_t memoryUsed;
+	struct _TerrainStreamer *streamer;
+} Terrain;
+void updateTerrain(Terrain *terrain, float x, float y);  // each frame: request, upload and evict tiles
+void drawTerrain(Terrain *terrain);
+float terrainHeight(Terrain *terrain, float x, float y);
+void freeTerrain(Terrain *terrain);
+// GRID LOD: a grid split into patches, each drawn with only the detail its distance needs
+#define GRID_LOD_MAX_LEVELS 12
+typedef struct{
+	float bounds[6];  // min XYZ, max XYZ
+	float errors[GRID_LOD_MAX_LEVELS];  // per level, the largest height difference to the full grid
+	unsigned int first[GRID_LOD_MAX_LEVELS], count[GRID_LOD_MAX_LEVELS];  // per level, in the index buffer
+} GridPatch;
+typedef struct{
+	int patchSize;  // quads along a patch's edge, a power of 2
+	int levels;  // level l uses every 2^l vertex, the last is 2 triangles per patch
+	int numPatches;
+	GridPatch *patches;
+	Mesh *mesh;  // the grid's vertices, then the skirts hiding cracks between levels
+	float pixelError;  // largest error allowed on screen, in pixels. 1 by default
+	unsigned int patchesDrawn, trianglesDrawn;  // the last frame
+	GLsizei *drawCounts;  // scratch for drawGridLOD()
+	const void **drawOffsets;
+} GridLOD;
+GridLOD *buildGridLOD(const Grid *grid, const float *colors, int patchSize);  // after buildGrid(). colors are optional, 3 per vertex
+void drawGridLOD(GridLOD *lod);
+void freeGridLOD(GridLOD *lod);
+// HEIGHTMAPS: a terrain kept on the GPU as one float per vertex, displaced in a vertex shader
+typedef struct{
+	int columns, rows;  // texels, one per vertex
+	float spacing;  // distance between vertices, centered on the origin like a Grid
+	GLuint texture;  // the heights, a single channel
+	int patchSize;  // quads along the edge of the flat patch every part of the map is drawn with
+	Mesh *patch;
+	size_t memoryUsed;  // bytes on the GPU
+} Heightmap;
+Heightmap *createHeightmap(int columns, int rows, float spacing, const float *heights);
+void updateHeightmap(Heightmap *map, int x, int y, int width, int height, const float *heights);  // heights: the whole columns * rows array
+void drawHeightmap(Heightmap *map, GLuint shader);  // the shader reads u_heightmap, u_size, u_patch, u_spacing
+void freeHeightmap(Heightmap *map);
+// PARTICLES: one array per component, integrated 4 at a time and drawn as point sprites from one buffer
+typedef struct{
+	int count, capacity;
+	float *position[3], *velocity[3];  // X, Y and Z arrays
+	float *life;  // seconds left. particles reaching 0 are removed
+	unsigned char *color;  // RGBA, 4 per particle
+	float acceleration[3];  // added to every velocity, like gravity
+	float boundsMin[3], boundsMax[3];  // positions wrap around on the axes where max > min
+	float size;  // world units, sprites shrink with distance
+	GLuint buffer;
+} Particles;
+Particles *createParticles(int capacity);
+int emitParticle(Particles *particles, const float position[3], const float velocity[3], float life, const float color[4]);  // life 0: forever, color NULL: white. -1 if full
+void killParticle(Particles *particles, int index);  // removed by the next update, indices shift down
+void updateParticles(Particles *particles, float dt);
+void drawParticles(Particles *particles);  // bind a texture first to draw it on every sprite
+void freeParticles(Particles *particles);
+// JOBS: a pool of worker threads, one per core, started before setup()
+#define TASK_MAX_DEPENDENCIES 8
+typedef struct _Task Task;
+int workerCount();  // the workers plus the main thread
+void parallelFor(int first, int end, int grain, void (*body)(void *context, int first, int end), void *context);  // returns when all of [first, end) is done. grain 0: automatic
+Task *submitTask(void (*task)(void *context), void *context, Task **dependencies, int numDependencies);  // runs once its dependencies are done
+void waitTask(Task *task);
+void waitTasks();  // every task submitted. called before draw3D(), after which tasks are recycled
+// PIPELINE: with PIPELINE set, update() for the next frame runs on a simulation thread while
+// this frame draws. update() makes no GL calls and leaves the camera alone. draw code reads
+// user state through drawState() only, and input callbacks run alongside update()
+void pipelineState(void *state, size_t size);  // the state update() writes, copied for draw code before every update()
+const void *drawState();  // the copy of the last update(), or the state itself when not pipelined
+// STARS: a binary catalog, mapped from disk and uploaded once, brightest first. stars are
+// points sized by magnitude (bind a texture to draw it on each), the dimmest are cut off by
+// drawing fewer of them
+#define STAR_MAGNITUDE_STEPS 256  // tenths of a magnitude, from -2
+typedef struct{
+	float position[3];
+	unsigned char color[4];  // from the color index and magnitude
+	float magnitude;  // apparent
+	float colorIndex;  // B-V
+} StarRecord;  // the file: "WORLDSTR", uint32 count, uint32 sizeof(StarRecord), then the records
+typedef struct{
+	int count;
+	float brightest, dimmest;  // magnitudes
+	float limitingMagnitude;  // stars dimmer than this are not drawn
+	float size;  // pixels across at magnitude 0, halving every 1.5 magnitudes. at least 1
+	int brighter[STAR_MAGNITUDE_STEPS];  // how many stars are brighter than -2 + (i+1)/10
+	float *magnitudes;  // brightest first, to cut off exactly at the limit
+	GLuint buffer;
+} StarCatalog;
+int saveStarCatalog(const char *filename, const float *positions, const float *magnitudes, const float *colorIndices, int count);  // positions are XYZ triples. colorIndices can be NULL. 0 on failure
+StarCatalog *loadStarCatalog(const char *filename);  // NULL if it's missing or not a catalog
+void drawStarCatalog(const StarCatalog *catalog);
+void freeStarCatalog(StarCatalog *catalog);
+// CELESTIAL: whole arrays of sky coordinates from one frame to another, 4 at a time and spread
+// across the worker pool. angles are degrees: right ascension and declination, ecliptic longitude
+// and latitude, or azimuth (from north through east) and altitude. longitudes come out in [0, 360).
+// unit vectors are XYZ triples: equatorial X to the vernal equinox and Z to the north celestial
+// pole, ecliptic X to the equinox and Z to the ecliptic's pole, horizontal X north, Y east, Z up
+enum{ CELESTIAL_EQUATORIAL, CELESTIAL_ECLIPTIC, CELESTIAL_HORIZONTAL };
+typedef struct{
+	float siderealTime;  // local, in degrees (hours * 15)
+	float latitude;  // degrees north
+	float obliquity;  // of the ecliptic, degrees. 0: J2000's
+} Observer;  // NULL where an observer is asked for: sidereal time 0 at the equator
+float localSiderealTime(double days, float longitude);  // days since J2000 (UT), longitude in degrees east
+void celestialMatrix(int from, int to, const Observer *observer, float m[16]);  // for glMultMatrixf
+void convertCelestial(int from, int to, const Observer *observer, const float *longitude, const float *latitude, float *outLongitude, float *outLatitude, int count);  // outputs can be the inputs
+void convertCartesian(int from, int to, const Observer *observer, const float *xyz, float *out, int count);
+void celestialToCartesian(const float *longitude, const float *latitude, float *xyz, int count);
+void cartesianToCelestial(const float *xyz, float *longitude, float *latitude, int count);  // the vectors need not be unit length
+// SKYBOX: distant background (stars, sky grids, gradients) drawn into a cubemap once, and again
+// only when its key changes, then drawn every frame as one cube around the camera, behind everything
+typedef struct{
+	GLuint texture;  // GL_TEXTURE_CUBE_MAP
+	GLuint framebuffer, depth;  // 0 without framebuffer objects: faces are copied from the back buffer
+	int size;  // pixels per face edge
+	unsigned long key;  // the inputs this was drawn from, see hashInputs()
+	unsigned char valid;
+	float clear[4];  // behind what's drawn into it, black by default
+	size_t memoryUsed;  // bytes on the GPU
+} Skybox;
+Skybox *createSkybox(int size);
+unsigned char bakeSkybox(Skybox *sky, unsigned long key, void (*draw)(void *context), void *context);  // 1 if draw() ran, once per face, looking out from the origin
+void drawSkybox(const Skybox *sky);  // first thing in draw3D(). nothing in orthographic perspective
+void freeSkybox(Skybox *sky);
+// CAPTURE: record the window to disk while it runs. frames are read back through a ring of pixel
+// buffers, a few frames late so nothing waits on the GPU, and written by a thread of their own
+enum{ CAPTURE_IMAGES, CAPTURE_RAW };  // numbered .ppm files, or one file of raw RGB frames, top row first
+enum{ CAPTURE_DROP, CAPTURE_BLOCK };  // when the writer falls behind: skip frames, or wait for it
+typedef struct{
+	int width, height;  // of every frame, the window's when capture started
+	unsigned long captured;  // frames read back
+	unsigned long written;
+	unsigned long dropped;  // writer behind, or the window a different size
+} CaptureStats;
+int startCapture(const char *path, int format, int policy);  // images: a pattern like "frames/%05d.ppm". 0 on failure
+void stopCapture();  // waits for what's read back to be written
+unsigned char isCapturing();
+CaptureStats captureStats();
+// RENDER TARGETS: draw into textures instead of the window (requires OpenGL 3.0)
+typedef struct{
+	GLuint framebuffer;
+	GLuint color;  // GL_TEXTURE_2D, RGBA
+	GLuint depth;  // renderbuffer
+	GLuint multisample, multisampleColor;  // with samples: drawn into, resolved into color
+	int width, height, samples;
+	size_t memoryUsed;  // bytes on the GPU
+} RenderTarget;
+RenderTarget *createRenderTarget(int width, int height, int samples);  // samples 0: no multisampling. NULL if the driver can't
+void resizeRenderTarget(RenderTarget *target, int width, int height);
+void bindRenderTarget(RenderTarget *target);  // and its viewport. NULL: the window
+void resolveRenderTarget(RenderTarget *target);  // multisampled pixels into color, before it's used as a texture
+void presentRenderTarget(RenderTarget *target, float x, float y, float width, float height);  // color, stretched over a rectangle of the window in pixels
+void freeRenderTarget(RenderTarget *target);
+// VIEWPORTS: split the window into views with cameras of their own. update() and input run once
+// a frame, draw3D() once for each view. clicking in a view hands it the camera globals to steer
+#define MAX_VIEWPORTS 8
+typedef struct{
+	float x, y, width, height;  // fractions of the window, from its lower left
+	unsigned char perspective;  // FPP, POLAR or ORTHO
+	unsigned char settings;  // SETTINGS while it draws
+	float origin[3], horizon[3], window[4], fov;
+} Viewport;
+Viewport *addViewport(float x, float y, float width, float height);  // looking through the current camera. NULL past MAX_VIEWPORTS
+void removeViewport(Viewport *viewport);  // with none left, draw3D() fills the window again
+void focusViewport(Viewport *viewport);  // its camera into PERSPECTIVE, ORIGIN, HORIZON, WINDOW, FOV and SETTINGS
+Viewport *focusedViewport();
+Viewport *currentViewport();  // the view draw3D() is drawing, NULL without views
+// STATE: the GL state the toolbox touches is shadowed, and calls that wouldn't change it are skipped.
+// glColor, glMaterialfv, glBindTexture, glEnable, client arrays and the rest below are routed
+// through it in the sketch too. GL calls made out of its sight (another library) need invalidateState()
+typedef struct{
+	unsigned long issued;  // reached the driver
+	unsigned long skipped;  // were already current
+} StateCounts;
+StateCounts stateCounts();  // over the last frame
+void invalidateState();
+// FRAME STATISTICS: what a frame asked of GL. the toolbox counts itself, and the sketch's glDrawArrays(),
+// glDrawElements(), glBindTexture() and glUseProgram() go through the same path. define COUNT_RAW_GL
+// before including world.h to count glBegin() and glVertex() too, at a little cost per vertex
+typedef struct{
+	unsigned long drawCalls;  // a replayed command list is one
+	unsigned long vertices;  // submitted, indices for indexed draws
+	unsigned long stateChanges, stateSkipped;  // see stateCounts()
+	unsigned long textureBinds;
+	unsigned long programSwitches;
+} FrameStats;
+FrameStats frameStats();  // over the last frame
+// CORE PROFILE (experimental): define CORE_PROFILE before including world.h (OpenGL 3.0) and the toolbox's
+// unlit draws go through the framework's shaders: matrices are kept on the CPU and reach them as a uniform,
+// vertices come from buffer objects through a vertex array object. sketches don't change. what the shaders
+// don't cover (lighting, points, fog, display lists, the sketch's own shaders, ...) draws the old way. it
+// costs more CPU a draw than fixed function on the drivers tried so far, see the readme
 // preload for geometry primitives
 void initPrimitives();
 GLint _sphere_stacks = 20; //7;
@@ -184,6 +504,1298 @@ enum { BIT_MOUSE_LOOK, BIT_KEYBOARD_MOVE, BIT_KEYBOARD_ZOOM, BIT_KEYBOARD_FUNCTI
 #define RIGHT_KEY GLUT_KEY_RIGHT+128//230
 #define LEFT_KEY GLUT_KEY_LEFT+128//228
 
+//////////  STATE   //////////
+// shadows of the GL state the toolbox touches, each known or not. a known value isn't set
+// again, and anything that can change state out of sight (glPopAttrib, display lists) forgets
+#if defined(CORE_PROFILE) && (defined(__glew_h__) || defined(GL_VERSION_3_0))
+#  define _CORE_PROFILE
+#endif
+enum{ _STATE_VERTEX = 1 << 0, _STATE_NORMAL = 1 << 1, _STATE_COLOR = 1 << 2, _STATE_TEXCOORD = 1 << 3 };
+enum{ _KNOWN_COLOR = 1 << 0, _KNOWN_LINE_WIDTH = 1 << 1, _KNOWN_POINT_SIZE = 1 << 2, _KNOWN_TEXTURE_2D = 1 << 3, _KNOWN_TEXTURE_CUBE_MAP = 1 << 4, _KNOWN_PROGRAM = 1 << 5 };
+static const GLenum _state_array_names[4] = { GL_VERTEX_ARRAY, GL_NORMAL_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY };
+static const GLenum _state_material_names[5] = { GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_EMISSION, GL_SHININESS };
+static const GLenum _state_caps[16] = { GL_LIGHTING, GL_TEXTURE_2D, GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_COLOR_MATERIAL, GL_SCISSOR_TEST, GL_NORMALIZE,
+	GL_LIGHT0, GL_LIGHT1, GL_LIGHT2, GL_LIGHT3, GL_LIGHT4, GL_LIGHT5, GL_LIGHT6, GL_LIGHT7 };
+static struct{
+	unsigned int known;
+	float color[4];
+	float material[2][5][4];  // front and back, in the order of _state_material_names
+	unsigned short materialKnown;
+	float lineWidth, pointSize;
+	GLuint textures[2];  // GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP
+	unsigned short caps, capsKnown;
+	unsigned char arrays, arraysKnown;
+	unsigned char userArrays;  // enabled by the sketch's own glEnableClientState()
+	unsigned char drawArrays;  // what the next draw needs: the toolbox's, or the sketch's
+	GLenum compiling;  // inside glNewList(): calls are recorded, maybe not run
+	GLuint program;  // known with _KNOWN_PROGRAM
+	unsigned long requested, issued;
+	FrameStats counting;  // this frame's draws, binds and program switches
+	StateCounts frame;
+	FrameStats stats;
+} _state;
+#ifdef _CORE_PROFILE
+static void _core_forget();
+static void _core_forget_client();
+static void _core_invalidate();
+static void _core_cap_changed(GLenum cap);
+static void _core_release();
+static void _core_unbind_arrays();
+static GLuint _core_unbind();
+static int _core_draw(GLenum mode, GLint first, GLsizei count, GLenum type, const void *indices);
+#endif
+static void _state_restore_arrays();
+static void _state_forget(){
+	_state.known = 0;
+	_state.materialKnown = 0;
+	_state.capsKnown = 0;
+#ifdef _CORE_PROFILE
+	_core_forget();
+#endif
+}
+void invalidateState(){
+	_state_forget();
+	_state.arraysKnown = 0;
+#ifdef _CORE_PROFILE
+	_core_invalidate();
+#endif
+	_state_restore_arrays();  // GL drawn out of sight reads the sketch's arrays, not the toolbox's last
+}
+StateCounts stateCounts(){ return _state.frame; }
+FrameStats frameStats(){ return _state.stats; }
+static void _state_frame(){
+	_state.frame.issued = _state.issued;
+	_state.frame.skipped = (_state.requested > _state.issued) ? _state.requested - _state.issued : 0;
+	_state.requested = _state.issued = 0;
+	_state.stats = _state.counting;
+	_state.stats.stateChanges = _state.frame.issued;
+	_state.stats.stateSkipped = _state.frame.skipped;
+	memset(&_state.counting, 0, sizeof(_state.counting));
+}
+static void _state_count_draw(unsigned long vertices){
+	_state.counting.drawCalls++;
+	_state.counting.vertices += vertices;
+}
+// 1: already current, the call can go
+static int _state_current(unsigned int known, unsigned int bit, int equal){
+	_state.requested++;
+	if(_state.compiling){ return 0; }
+	return STATE_CACHE && (known & bit) && equal;
+}
+static int _state_cap(GLenum cap){
+	for(int i = 0; i < 16; i++){
+		if(_state_caps[i] == cap){ return i; }
+	}
+	return -1;
+}
+// with GL_COLOR_MATERIAL, changing the color changes the material
+static void _state_color_changed(){
+	int i = _state_cap(GL_COLOR_MATERIAL);
+	if(!(_state.capsKnown & (1 << i)) || (_state.caps & (1 << i))){ _state.materialKnown = 0; }
+}
+static void _state_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a){
+	int equal = _state.color[0] == r && _state.color[1] == g && _state.color[2] == b && _state.color[3] == a;
+	if(_state_current(_state.known, _KNOWN_COLOR, equal)){ return; }
+	if(!_state.compiling){
+		_state.color[0] = r;
+		_state.color[1] = g;
+		_state.color[2] = b;
+		_state.color[3] = a;
+		_state.known |= _KNOWN_COLOR;
+		_state_color_changed();
+	}
+	_state.issued++;
+	glColor4f(r, g, b, a);
+}
+static void _state_materialfv(GLenum face, GLenum pname, const GLfloat *params){
+	int first = (face == GL_BACK), last = (face == GL_FRONT) ? 0 : 1;
+	int names[2], count = 0;
+	for(int n = 0; n < 5; n++){
+		if(_state_material_names[n] == pname || (pname == GL_AMBIENT_AND_DIFFUSE && n < 2)){ names[count++] = n; }
+	}
+	int components = (pname == GL_SHININESS) ? 1 : 4;
+	unsigned short bits = 0;
+	int equal = count > 0 && (face == GL_FRONT || face == GL_BACK || face == GL_FRONT_AND_BACK);
+	for(int f = first; equal && f <= last; f++){
+		for(int n = 0; n < count; n++){
+			bits |= 1 << (f * 5 + names[n]);
+			equal = equal && !memcmp(_state.material[f][names[n]], params, sizeof(GLfloat) * components);
+		}
+	}
+	if(_state_current(_state.materialKnown, bits, equal && (_state.materialKnown & bits) == bits)){ return; }
+	if(!_state.compiling && bits){
+		for(int f = first; f <= last; f++){
+			for(int n = 0; n < count; n++){ memcpy(_state.material[f][names[n]], params, sizeof(GLfloat) * components); }
+		}
+		_state.materialKnown |= bits;
+	}
+	_state.issued++;
+	glMaterialfv(face, pname, params);
+}
+static void _state_line_width(GLfloat width){
+	if(_state_current(_state.known, _KNOWN_LINE_WIDTH, _state.lineWidth == width)){ return; }
+	if(!_state.compiling){
+		_state.lineWidth = width;
+		_state.known |= _KNOWN_LINE_WIDTH;
+	}
+	_state.issued++;
+	glLineWidth(width);
+}
+static void _state_point_size(GLfloat size){
+	if(_state_current(_state.known, _KNOWN_POINT_SIZE, _state.pointSize == size)){ return; }
+	if(!_state.compiling){
+		_state.pointSize = size;
+		_state.known |= _KNOWN_POINT_SIZE;
+	}
+	_state.issued++;
+	glPointSize(size);
+}
+// of the active texture unit
+static void _state_bind_texture(GLenum target, GLuint texture){
+	int slot = (target == GL_TEXTURE_2D) ? 0 : -1;
+#ifdef GL_TEXTURE_CUBE_MAP
+	if(target == GL_TEXTURE_CUBE_MAP){ slot = 1; }
+#endif
+	if(slot < 0){
+		_state.requested++;
+		_state.issued++;
+		_state.counting.textureBinds++;
+		glBindTexture(target, texture);
+		return;
+	}
+	unsigned int bit = _KNOWN_TEXTURE_2D << slot;
+	if(_state_current(_state.known, bit, _state.textures[slot] == texture)){ return; }
+	if(!_state.compiling){
+		_state.textures[slot] = texture;
+		_state.known |= bit;
+	}
+	_state.issued++;
+	_state.counting.textureBinds++;
+	glBindTexture(target, texture);
+}
+static void _state_delete_textures(GLsizei n, const GLuint *textures){
+	// a bound texture that's deleted leaves 0 bound, and its name can come back from glGenTextures()
+	for(GLsizei i = 0; i < n; i++){
+		for(int slot = 0; slot < 2; slot++){
+			if(_state.textures[slot] == textures[i]){ _state.textures[slot] = 0; }
+		}
+	}
+	glDeleteTextures(n, textures);
+}
+#if defined(__glew_h__) || defined(GL_VERSION_1_3)
+// bindings and the texture switches belong to a unit, so the shadows of the last one don't hold for the next
+static void _state_active_texture(GLenum unit){
+	_state.requested++;
+	_state.issued++;
+	glActiveTexture(unit);
+	if(_state.compiling == GL_COMPILE){ return; }
+	_state.known &= ~(_KNOWN_TEXTURE_2D | _KNOWN_TEXTURE_CUBE_MAP);
+	_state.capsKnown &= ~(1 << _state_cap(GL_TEXTURE_2D));
+#ifdef _CORE_PROFILE
+	_core_forget();  // the texture environment is the unit's too
+#endif
+}
+#endif
+static void _state_enable(GLenum cap, unsigned char on){
+	int i = _state_cap(cap);
+	if(i < 0){
+		_state.requested++;
+		_state.issued++;
+		if(on){ glEnable(cap); }
+		else  { glDisable(cap); }
+#ifdef _CORE_PROFILE
+		_core_cap_changed(cap);
+#endif
+		return;
+	}
+	if(_state_current(_state.capsKnown, 1 << i, !(_state.caps & (1 << i)) == !on)){ return; }
+	if(!_state.compiling){
+		_state.caps = on ? (_state.caps | (1 << i)) : (_state.caps & ~(1 << i));
+		_state.capsKnown |= 1 << i;
+		if(cap == GL_COLOR_MATERIAL && on){ _state.materialKnown = 0; }  // takes the current color right away
+	}
+	_state.issued++;
+	if(on){ glEnable(cap); }
+	else  { glDisable(cap); }
+#ifdef _CORE_PROFILE
+	_core_cap_changed(cap);
+#endif
+}
+// client arrays aren't compiled into display lists, these always run
+static void _state_apply_arrays(unsigned char arrays){
+	if(STATE_CACHE && _state.arraysKnown == 0x0F && _state.arrays == arrays){ return; }
+#ifdef _CORE_PROFILE
+	_core_unbind_arrays();  // client arrays are the bound vertex array's
+#endif
+	for(int i = 0; i < 4; i++){
+		unsigned char bit = 1 << i;
+		if(STATE_CACHE && (_state.arraysKnown & bit) && (_state.arrays & bit) == (arrays & bit)){ continue; }
+		_state.issued++;
+		if(arrays & bit){ glEnableClientState(_state_array_names[i]); }
+		else            { glDisableClientState(_state_array_names[i]); }
+	}
+	_state.arrays = arrays;
+	_state.arraysKnown = 0x0F;
+	// drawing with a color array leaves the current color undefined
+	if(arrays & _STATE_COLOR){
+		_state.known &= ~_KNOWN_COLOR;
+		_state_color_changed();
+	}
+}
+static int _state_popcount(unsigned char bits){
+	int count = 0;
+	for(; bits; bits >>= 1){ count += bits & 1; }
+	return count;
+}
+// a toolbox draw's arrays, in place of its enable and disable pairs. left enabled after,
+// and only switched when the next draw needs something else
+static void _state_arrays(unsigned char arrays){
+	_state.requested += _state_popcount(arrays) * 2;
+	_state.drawArrays = arrays;
+	_state_apply_arrays(arrays);
+}
+static void _state_arrays_done(){
+	_state.drawArrays = _state.userArrays;
+	if(!STATE_CACHE){ _state_apply_arrays(_state.userArrays); }  // without the cache, nothing is left enabled
+}
+// before control goes back to the sketch, whose own GL calls expect only its arrays enabled
+static void _state_restore_arrays(){
+	if(!_state.compiling){ _state_apply_arrays(_state.userArrays); }
+}
+// the sketch's glEnableClientState() takes effect at its next draw
+static inline void _state_client(GLenum array, unsigned char on){
+	for(int i = 0; i < 4; i++){
+		if(_state_array_names[i] != array){ continue; }
+		_state.requested++;
+		_state.userArrays = on ? (_state.userArrays | (1 << i)) : (_state.userArrays & ~(1 << i));
+		_state.drawArrays = _state.userArrays;
+		return;
+	}
+	_state.requested++;
+	_state.issued++;
+	if(on){ glEnableClientState(array); }
+	else  { glDisableClientState(array); }
+}
+static void _state_draw_arrays(GLenum mode, GLint first, GLsizei count){
+	_state_count_draw(count);
+#ifdef _CORE_PROFILE
+	if(_core_draw(mode, first, count, 0, NULL)){ return; }
+	_core_release();
+#endif
+	_state_apply_arrays(_state.drawArrays);
+	glDrawArrays(mode, first, count);
+}
+static void _state_draw_elements(GLenum mode, GLsizei count, GLenum type, const void *indices){
+	_state_count_draw(count);
+#ifdef _CORE_PROFILE
+	if(_core_draw(mode, 0, count, type, indices)){ return; }
+	_core_release();
+#endif
+	_state_apply_arrays(_state.drawArrays);
+	glDrawElements(mode, count, type, indices);
+}
+#if defined(__glew_h__) || defined(GL_VERSION_2_0)
+static void _state_use_program(GLuint program){
+#ifdef _CORE_PROFILE
+	if(_state.compiling != GL_COMPILE && _core_unbind()){ _state.known &= ~_KNOWN_PROGRAM; }  // the framework's was bound in place of the sketch's
+#endif
+	if(_state_current(_state.known, _KNOWN_PROGRAM, _state.program == program)){ return; }
+	if(!_state.compiling){
+		_state.program = program;
+		_state.known |= _KNOWN_PROGRAM;
+	}
+	_state.issued++;
+	_state.counting.programSwitches++;
+	glUseProgram(program);
+}
+#endif
+static void _state_pop_attrib(){
+	glPopAttrib();
+	_state_forget();
+}
+static void _state_pop_client_attrib(){
+#ifdef _CORE_PROFILE
+	_core_unbind_arrays();
+#endif
+	glPopClientAttrib();
+	_state.arraysKnown = 0;
+#ifdef _CORE_PROFILE
+	_core_forget_client();
+#endif
+}
+static void _state_new_list(GLuint list, GLenum mode){
+#ifdef _CORE_PROFILE
+	_core_release();  // or the list would record putting it back
+#endif
+	_state.compiling = mode;
+	glNewList(list, mode);
+}
+static void _state_end_list(){
+	glEndList();
+	if(_state.compiling == GL_COMPILE_AND_EXECUTE){ _state_forget(); }
+	_state.compiling = 0;
+}
+static void _state_call_list(GLuint list){
+	_state_count_draw(0);
+#ifdef _CORE_PROFILE
+	_core_release();
+#endif
+	glCallList(list);
+	if(!_state.compiling){ _state_forget(); }
+}
+static inline void _state_call_lists(GLsizei n, GLenum type, const void *lists){
+	_state.counting.drawCalls += n;
+#ifdef _CORE_PROFILE
+	_core_release();
+#endif
+	glCallLists(n, type, lists);
+	if(!_state.compiling){ _state_forget(); }
+}
+#ifdef _CORE_PROFILE
+//////////  CORE PROFILE   //////////
+// the toolbox's unlit draws, through the framework's own shaders. matrix calls still reach GL, so whatever
+// draws the old way sees them, and a copy of the two stacks is kept here for the shaders' uniforms.
+// arrays are read from buffer objects: the toolbox's fixed shapes are uploaded once, the rest is
+// streamed each draw. state the shaders can't mimic sends the draw the old way
+#define _CORE_STACK_DEPTH 32
+#define _CORE_STREAM_BYTES (4 << 20)
+#define _CORE_STATIC_ARRAYS 64
+enum{ _CORE_TEXTURE_2D = 1 << 0, _CORE_TEXTURE_CUBE_MAP = 1 << 1 };
+// attribute of each of _state_array_names, where the drivers that alias them keep the fixed-function ones
+static const GLuint _core_locations[4] = { 0, 2, 3, 8 };
+static const char *_core_attributes[4] = { "a_position", "a_normal", "a_color", "a_texcoord" };
+static const GLenum _core_array_queries[4][5] = {  // size, type, stride, buffer, pointer
+	{ GL_VERTEX_ARRAY_SIZE, GL_VERTEX_ARRAY_TYPE, GL_VERTEX_ARRAY_STRIDE, GL_VERTEX_ARRAY_BUFFER_BINDING, GL_VERTEX_ARRAY_POINTER },
+	{ 0, GL_NORMAL_ARRAY_TYPE, GL_NORMAL_ARRAY_STRIDE, GL_NORMAL_ARRAY_BUFFER_BINDING, GL_NORMAL_ARRAY_POINTER },
+	{ GL_COLOR_ARRAY_SIZE, GL_COLOR_ARRAY_TYPE, GL_COLOR_ARRAY_STRIDE, GL_COLOR_ARRAY_BUFFER_BINDING, GL_COLOR_ARRAY_POINTER },
+	{ GL_TEXTURE_COORD_ARRAY_SIZE, GL_TEXTURE_COORD_ARRAY_TYPE, GL_TEXTURE_COORD_ARRAY_STRIDE, GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING, GL_TEXTURE_COORD_ARRAY_POINTER } };
+// with any of these on, the draw goes the old way
+static const GLenum _core_fallback_caps[18] = { GL_FOG, GL_ALPHA_TEST, GL_TEXTURE_GEN_S, GL_TEXTURE_GEN_T, GL_TEXTURE_GEN_R, GL_TEXTURE_GEN_Q,
+	GL_CLIP_PLANE0, GL_CLIP_PLANE1, GL_CLIP_PLANE2, GL_CLIP_PLANE3, GL_CLIP_PLANE4, GL_CLIP_PLANE5,
+	GL_LINE_STIPPLE, GL_POLYGON_STIPPLE, GL_TEXTURE_1D, GL_TEXTURE_3D, GL_COLOR_SUM, GL_RESCALE_NORMAL };
+static const float _core_identity[16] = {1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1};
+static const char *_core_vertex_source =
+	"in vec4 a_position;\n"
+	"in vec4 a_color;\n"
+	"in vec4 a_texcoord;\n"
+	"uniform vec4 u_matrix[4];  // projection * modelview\n"
+	"out vec4 v_color;\n"
+	"out vec4 v_texcoord;\n"
+	"void main(){\n"
+	"	gl_Position = mat4(u_matrix[0], u_matrix[1], u_matrix[2], u_matrix[3]) * a_position;\n"
+	"	v_texcoord = a_texcoord;\n"
+	"	v_color = clamp(a_color, 0.0, 1.0);\n"
+	"}\n";
+static const char *_core_fragment_source =
+	"in vec4 v_color;\n"
+	"in vec4 v_texcoord;\n"
+	"#ifdef TEXTURE_2D\n"
+	"uniform sampler2D u_texture;\n"
+	"#endif\n"
+	"#ifdef TEXTURE_CUBE_MAP\n"
+	"uniform samplerCube u_texture;\n"
+	"#endif\n"
+	"void main(){\n"
+	"	vec4 color = v_color;\n"
+	"#ifdef TEXTURE_2D\n"
+	"	color *= textureProj(u_texture, v_texcoord);\n"
+	"#endif\n"
+	"#ifdef TEXTURE_CUBE_MAP\n"
+	"	color *= texture(u_texture, v_texcoord.xyz);\n"
+	"#endif\n"
+	"	gl_FragColor = color;\n"
+	"}\n";
+typedef struct{
+	GLint size;
+	GLenum type;
+	GLsizei stride;
+	const void *pointer;  // an offset, with a buffer
+	GLuint buffer;
+} _CoreArray;
+typedef struct{
+	GLuint program;
+	unsigned char failed;
+	GLint matrix;
+	unsigned long matrixVersion;  // the version last given to it
+} _CoreProgram;
+static struct{
+	float stacks[2][_CORE_STACK_DEPTH][16];  // modelview, projection
+	int depth[2];
+	int floor[2];  // the levels below were never read back from GL
+	int mode;  // 0: modelview, 1: projection, -1: another, its calls only reach GL
+	unsigned char modeKnown, matricesKnown;
+	unsigned char otherMatrix;  // the texture matrix was touched: textured draws go the old way
+	unsigned long version;  // of the matrices
+	float matrix[16];  // u_matrix: projection * modelview
+	unsigned long computed;  // the version matrix was made from
+	_CoreArray arrays[4];  // the gl*Pointer() of each of _state_array_names
+	unsigned char arraysKnown;
+	unsigned char pointersPending;  // set here but not yet in GL, which only drawing the old way needs
+	GLuint arrayBuffer, elementBuffer, vertexArray;  // the sketch's bindings
+	GLuint arrayBound;  // to GL_ARRAY_BUFFER right now
+	unsigned char bindingsKnown;
+	int ready;  // 1: buffers and vertex array made, -1: OpenGL is older than 3.0
+	GLuint vao, stream, statics;
+	unsigned char vaoBound;  // left bound between the framework's draws, like its program
+	GLuint programBound;  // the framework's, left bound between its draws until anything else draws
+	size_t streamUsed;
+	struct{ const void *data; size_t bytes, offset; } staticArrays[_CORE_STATIC_ARRAYS];
+	int staticCount;
+	size_t staticBytes;
+	unsigned char staticDirty;
+	_CoreArray attributes[4];  // as set on vao
+	unsigned char enabled;
+	GLuint elementsBound;  // on vao
+	float constants[4][4];  // generic attribute values, for arrays that aren't enabled
+	unsigned char constantsKnown;
+	_CoreProgram programs[4];  // by shader key
+	unsigned char fixedKnown, fallback, modulate, cubeMap;
+	GLuint checkedTexture;
+	unsigned char alphaTexture;
+} _core;
+static void _core_forget(){
+	_core.modeKnown = 0;  // glPopAttrib() restores the matrix mode
+	_core.fixedKnown = 0;
+	_core.checkedTexture = 0;
+	if(_core.programBound){ _state.known |= _KNOWN_PROGRAM; }  // the sketch's is 0 while the framework's is bound
+}
+static void _core_forget_client(){
+	_core.arraysKnown = 0;
+	_core.bindingsKnown = 0;
+}
+// the sketch's vertex array and array buffer go back, and its pointers reach GL, before anything else sets or reads array state
+static void _core_unbind_arrays(){
+	if(_core.vaoBound){
+		glBindVertexArray(0);
+		_core.vaoBound = 0;
+	}
+	for(int i = 0; _core.pointersPending && i < 4; i++){
+		if(!(_core.pointersPending & (1 << i))){ continue; }
+		_CoreArray *a = &_core.arrays[i];
+		if(_core.arrayBound != a->buffer){
+			glBindBuffer(GL_ARRAY_BUFFER, a->buffer);
+			_core.arrayBound = a->buffer;
+		}
+		switch(i){
+			case 0: glVertexPointer(a->size, a->type, a->stride, a->pointer); break;
+			case 1: glNormalPointer(a->type, a->stride, a->pointer); break;
+			case 2: glColorPointer(a->size, a->type, a->stride, a->pointer); break;
+			case 3: glTexCoordPointer(a->size, a->type, a->stride, a->pointer); break;
+		}
+		_core.pointersPending &= ~(1 << i);
+	}
+	if(_core.bindingsKnown && _core.arrayBound != _core.arrayBuffer){
+		glBindBuffer(GL_ARRAY_BUFFER, _core.arrayBuffer);
+		_core.arrayBound = _core.arrayBuffer;
+	}
+}
+static void _core_invalidate(){
+	_core_unbind_arrays();
+	_core_forget();
+	_core_forget_client();
+	_core.matricesKnown = 0;
+	_core.constantsKnown = 0;
+	if(_core.programBound){
+		// unless the calls out of sight bound another, the sketch's 0 goes back
+		GLint current;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+		if((GLuint)current == _core.programBound){ glUseProgram(0); }
+		_core.programBound = 0;
+		_state.known &= ~_KNOWN_PROGRAM;
+	}
+}
+// the sketch's program goes back before something draws without the framework's shaders
+static void _core_release(){
+	_core_unbind_arrays();
+	if(!_core.programBound){ return; }
+	glUseProgram(_state.program);
+	_core.programBound = 0;
+}
+static GLuint _core_unbind(){
+	_core_unbind_arrays();
+	GLuint program = _core.programBound;
+	_core.programBound = 0;
+	return program;
+}
+static void _core_cap_changed(GLenum cap){
+	if(cap == GL_TEXTURE_CUBE_MAP){ _core.fixedKnown = 0; return; }
+	for(int i = 0; i < 18; i++){
+		if(_core_fallback_caps[i] == cap){ _core.fixedKnown = 0; }
+	}
+}
+// arrays that never change after this, to upload once. initPrimitives() hands over the toolbox's
+static void _core_static(const void *data, size_t bytes){
+	for(int i = 0; i < _core.staticCount; i++){
+		if(_core.staticArrays[i].data == data){ return; }
+	}
+	if(_core.staticCount >= _CORE_STATIC_ARRAYS){ return; }
+	_core.staticArrays[_core.staticCount].data = data;
+	_core.staticArrays[_core.staticCount].bytes = bytes;
+	_core.staticArrays[_core.staticCount].offset = _core.staticBytes;
+	_core.staticBytes += (bytes + 15) & ~(size_t)15;
+	_core.staticCount++;
+	_core.staticDirty = 1;
+}
+// offset in the static buffer of bytes at data, -1 if they weren't handed over
+static long _core_static_find(const void *data, size_t bytes){
+	const char *p = (const char*)data;
+	for(int i = 0; i < _core.staticCount; i++){
+		const char *start = (const char*)_core.staticArrays[i].data;
+		if(p >= start && p + bytes <= start + _core.staticArrays[i].bytes){ return _core.staticArrays[i].offset + (p - start); }
+	}
+	return -1;
+}
+//////// MATRICES
+static int _core_mode(){
+	if(!_core.modeKnown){
+		GLint mode;
+		glGetIntegerv(GL_MATRIX_MODE, &mode);
+		_core.mode = (mode == GL_MODELVIEW) ? 0 : (mode == GL_PROJECTION) ? 1 : -1;
+		_core.modeKnown = 1;
+	}
+	if(!_core.matricesKnown){
+		GLint depth;
+		glGetIntegerv(GL_MODELVIEW_STACK_DEPTH, &depth);
+		_core.depth[0] = (depth < 1) ? 0 : (depth > _CORE_STACK_DEPTH) ? _CORE_STACK_DEPTH - 1 : depth - 1;
+		glGetIntegerv(GL_PROJECTION_STACK_DEPTH, &depth);
+		_core.depth[1] = (depth < 1) ? 0 : (depth > _CORE_STACK_DEPTH) ? _CORE_STACK_DEPTH - 1 : depth - 1;
+		glGetFloatv(GL_MODELVIEW_MATRIX, _core.stacks[0][_core.depth[0]]);
+		glGetFloatv(GL_PROJECTION_MATRIX, _core.stacks[1][_core.depth[1]]);
+		_core.floor[0] = _core.depth[0];
+		_core.floor[1] = _core.depth[1];
+		_core.matricesKnown = 1;
+		_core.version++;
+	}
+	return _core.mode;
+}
+// the copy a matrix call changes too, NULL when the call only reaches GL
+static float *_core_matrix(){
+	if(_state.compiling == GL_COMPILE){ return NULL; }
+	int mode = _core_mode();
+	if(mode < 0){
+		_core.otherMatrix = 1;
+		return NULL;
+	}
+	_core.version++;
+	return _core.stacks[mode][_core.depth[mode]];
+}
+// m = m * n, column-major like GL
+static void _core_multiply(float *m, const float n[16]){
+	float r[16];
+	for(int c = 0; c < 4; c++){
+		for(int i = 0; i < 4; i++){
+			r[c*4+i] = m[i] * n[c*4+0] + m[4+i] * n[c*4+1] + m[8+i] * n[c*4+2] + m[12+i] * n[c*4+3];
+		}
+	}
+	memcpy(m, r, sizeof(r));
+}
+static void _core_translate(float *m, float x, float y, float z){
+	for(int i = 0; i < 4; i++){ m[12+i] += m[i] * x + m[4+i] * y + m[8+i] * z; }
+}
+static void _core_scale(float *m, float x, float y, float z){
+	for(int i = 0; i < 4; i++){
+		m[i] *= x;
+		m[4+i] *= y;
+		m[8+i] *= z;
+	}
+}
+static void _core_rotate(float *m, float angle, float x, float y, float z){
+	float length = sqrtf(x*x + y*y + z*z);
+	if(length == 0){ return; }
+	x /= length; y /= length; z /= length;
+	float c = cosf(angle * M_PI / 180.0), s = sinf(angle * M_PI / 180.0), t = 1 - c;
+	float r[16] = { x*x*t + c,   y*x*t + z*s, x*z*t - y*s, 0,
+	                x*y*t - z*s, y*y*t + c,   y*z*t + x*s, 0,
+	                x*z*t + y*s, y*z*t - x*s, z*z*t + c,   0,
+	                0, 0, 0, 1 };
+	_core_multiply(m, r);
+}
+static void _core_ortho(float *m, double l, double r, double b, double t, double n, double f){
+	float o[16] = { 2/(r-l), 0, 0, 0,   0, 2/(t-b), 0, 0,   0, 0, -2/(f-n), 0,
+	                -(r+l)/(r-l), -(t+b)/(t-b), -(f+n)/(f-n), 1 };
+	_core_multiply(m, o);
+}
+static void _core_frustum(float *m, double l, double r, double b, double t, double n, double f){
+	float o[16] = { 2*n/(r-l), 0, 0, 0,   0, 2*n/(t-b), 0, 0,
+	                (r+l)/(r-l), (t+b)/(t-b), -(f+n)/(f-n), -1,   0, 0, -2*f*n/(f-n), 0 };
+	_core_multiply(m, o);
+}
+static void _core_matrix_mode(GLenum mode){
+	glMatrixMode(mode);
+	if(_state.compiling == GL_COMPILE){ return; }
+	_core_mode();
+	_core.mode = (mode == GL_MODELVIEW) ? 0 : (mode == GL_PROJECTION) ? 1 : -1;
+}
+static void _core_load_identity(){
+	glLoadIdentity();
+	float *m = _core_matrix();
+	if(m){ memcpy(m, _core_identity, sizeof(_core_identity)); }
+}
+// the copy is synced before GL's stack moves, or reading it back would count the push or pop twice
+static void _core_push_matrix(){
+	float *m = _core_matrix();
+	glPushMatrix();
+	if(m && _core.depth[_core.mode] < _CORE_STACK_DEPTH - 1){
+		memcpy(m + 16, m, sizeof(float) * 16);
+		_core.depth[_core.mode]++;
+	}
+}
+static void _core_pop_matrix(){
+	float *m = _core_matrix();
+	glPopMatrix();
+	if(!m){ return; }
+	if(_core.depth[_core.mode] > _core.floor[_core.mode]){ _core.depth[_core.mode]--; }
+	else{ _core.matricesKnown = 0; }  // the level below was never read back, it is at the next call
+}
+static void _core_translatef(GLfloat x, GLfloat y, GLfloat z){
+	glTranslatef(x, y, z);
+	float *m = _core_matrix();
+	if(m){ _core_translate(m, x, y, z); }
+}
+static inline void _core_translated(GLdouble x, GLdouble y, GLdouble z){
+	glTranslated(x, y, z);
+	float *m = _core_matrix();
+	if(m){ _core_translate(m, x, y, z); }
+}
+static void _core_rotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z){
+	glRotatef(angle, x, y, z);
+	float *m = _core_matrix();
+	if(m){ _core_rotate(m, angle, x, y, z); }
+}
+static inline void _core_rotated(GLdouble angle, GLdouble x, GLdouble y, GLdouble z){
+	glRotated(angle, x, y, z);
+	float *m = _core_matrix();
+	if(m){ _core_rotate(m, angle, x, y, z); }
+}
+static void _core_scalef(GLfloat x, GLfloat y, GLfloat z){
+	glScalef(x, y, z);
+	float *m = _core_matrix();
+	if(m){ _core_scale(m, x, y, z); }
+}
+static inline void _core_scaled(GLdouble x, GLdouble y, GLdouble z){
+	glScaled(x, y, z);
+	float *m = _core_matrix();
+	if(m){ _core_scale(m, x, y, z); }
+}
+static void _core_mult_matrixf(const GLfloat *n){
+	glMultMatrixf(n);
+	float *m = _core_matrix();
+	if(m){ _core_multiply(m, n); }
+}
+static inline void _core_mult_matrixd(const GLdouble *n){
+	glMultMatrixd(n);
+	float *m = _core_matrix(), f[16];
+	if(m){
+		for(int i = 0; i < 16; i++){ f[i] = n[i]; }
+		_core_multiply(m, f);
+	}
+}
+static void _core_load_matrixf(const GLfloat *n){
+	glLoadMatrixf(n);
+	float *m = _core_matrix();
+	if(m){ memcpy(m, n, sizeof(float) * 16); }
+}
+static inline void _core_load_matrixd(const GLdouble *n){
+	glLoadMatrixd(n);
+	float *m = _core_matrix();
+	if(m){
+		for(int i = 0; i < 16; i++){ m[i] = n[i]; }
+	}
+}
+static void _core_gl_ortho(GLdouble l, GLdouble r, GLdouble b, GLdouble t, GLdouble n, GLdouble f){
+	glOrtho(l, r, b, t, n, f);
+	float *m = _core_matrix();
+	if(m){ _core_ortho(m, l, r, b, t, n, f); }
+}
+static void _core_gl_frustum(GLdouble l, GLdouble r, GLdouble b, GLdouble t, GLdouble n, GLdouble f){
+	glFrustum(l, r, b, t, n, f);
+	float *m = _core_matrix();
+	if(m){ _core_frustum(m, l, r, b, t, n, f); }
+}
+static void _core_glu_perspective(GLdouble fovy, GLdouble aspect, GLdouble n, GLdouble f){
+	gluPerspective(fovy, aspect, n, f);
+	float *m = _core_matrix();
+	if(m){
+		double t = n * tan(fovy * M_PI / 360.0);
+		_core_frustum(m, -t * aspect, t * aspect, -t, t, n, f);
+	}
+}
+static inline void _core_glu_ortho_2d(GLdouble l, GLdouble r, GLdouble b, GLdouble t){
+	gluOrtho2D(l, r, b, t);
+	float *m = _core_matrix();
+	if(m){ _core_ortho(m, l, r, b, t, -1, 1); }
+}
+static void _core_glu_look_at(GLdouble eyeX, GLdouble eyeY, GLdouble eyeZ, GLdouble centerX, GLdouble centerY, GLdouble centerZ, GLdouble upX, GLdouble upY, GLdouble upZ){
+	gluLookAt(eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ);
+	float *m = _core_matrix();
+	if(!m){ return; }
+	float f[3] = { centerX - eyeX, centerY - eyeY, centerZ - eyeZ };
+	float length = sqrtf(f[0]*f[0] + f[1]*f[1] + f[2]*f[2]);
+	if(length == 0){ return; }
+	f[0] /= length; f[1] /= length; f[2] /= length;
+	float s[3] = { f[1]*upZ - f[2]*upY, f[2]*upX - f[0]*upZ, f[0]*upY - f[1]*upX };
+	length = sqrtf(s[0]*s[0] + s[1]*s[1] + s[2]*s[2]);
+	if(length != 0){ s[0] /= length; s[1] /= length; s[2] /= length; }
+	float u[3] = { s[1]*f[2] - s[2]*f[1], s[2]*f[0] - s[0]*f[2], s[0]*f[1] - s[1]*f[0] };
+	float r[16] = { s[0], u[0], -f[0], 0,   s[1], u[1], -f[1], 0,   s[2], u[2], -f[2], 0,   0, 0, 0, 1 };
+	_core_multiply(m, r);
+	_core_translate(m, -eyeX, -eyeY, -eyeZ);
+}
+static void _core_get_floatv(GLenum pname, GLfloat *params){
+	int stack = (pname == GL_MODELVIEW_MATRIX) ? 0 : (pname == GL_PROJECTION_MATRIX) ? 1 : -1;
+	if(stack < 0){
+		glGetFloatv(pname, params);
+		return;
+	}
+	_core_mode();
+	memcpy(params, _core.stacks[stack][_core.depth[stack]], sizeof(float) * 16);
+}
+//////// ARRAYS AND BUFFERS
+static void _core_bindings(){
+	if(_core.bindingsKnown){ return; }
+	GLint value;
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+	if(_core.vao && (GLuint)value == _core.vao){
+		// glPopClientAttrib() can put back the framework's own
+		glBindVertexArray(0);
+		value = 0;
+	}
+	_core.vaoBound = 0;
+	_core.vertexArray = value;
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &value);
+	if(value && ((GLuint)value == _core.stream || (GLuint)value == _core.statics)){
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		value = 0;
+	}
+	_core.arrayBuffer = _core.arrayBound = value;
+	glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &value);
+	if(!_core.vertexArray){ _core.elementBuffer = value; }
+	_core.bindingsKnown = 1;
+}
+static void _core_bind_array(GLuint buffer){
+	if(_core.arrayBound == buffer){ return; }
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	_core.arrayBound = buffer;
+}
+static void _core_bind_buffer(GLenum target, GLuint buffer){
+	_core_bindings();
+	_core_unbind_arrays();
+	if(target == GL_ARRAY_BUFFER){ _core.arrayBuffer = _core.arrayBound = buffer; }
+	if(target == GL_ELEMENT_ARRAY_BUFFER && !_core.vertexArray){ _core.elementBuffer = buffer; }
+	glBindBuffer(target, buffer);
+}
+static void _core_delete_buffers(GLsizei n, const GLuint *buffers){
+	// a bound buffer that's deleted leaves 0 bound
+	for(GLsizei i = 0; i < n; i++){
+		if(!buffers[i]){ continue; }
+		if(_core.arrayBuffer == buffers[i]){ _core.arrayBuffer = 0; }
+		if(_core.arrayBound == buffers[i]){ _core.arrayBound = 0; }
+		if(_core.elementBuffer == buffers[i]){ _core.elementBuffer = 0; }
+	}
+	glDeleteBuffers(n, buffers);
+}
+static inline void _core_bind_vertex_array(GLuint array){
+	_core_bindings();
+	_core_unbind_arrays();
+	glBindVertexArray(array);
+	_core.vertexArray = array;
+	if(!array){
+		GLint value;
+		glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &value);
+		_core.elementBuffer = value;
+	}
+}
+// the GL call waits for _core_unbind_arrays(), the framework's vertex array can stay bound till then
+static void _core_pointer(int array, GLint size, GLenum type, GLsizei stride, const void *pointer){
+	_core_bindings();
+	_core.arrays[array].size = size;
+	_core.arrays[array].type = type;
+	_core.arrays[array].stride = stride;
+	_core.arrays[array].pointer = pointer;
+	_core.arrays[array].buffer = _core.arrayBuffer;
+	_core.arraysKnown |= 1 << array;
+	_core.pointersPending |= 1 << array;
+}
+static void _core_vertex_pointer(GLint size, GLenum type, GLsizei stride, const void *pointer){
+	_core_pointer(0, size, type, stride, pointer);
+}
+static void _core_normal_pointer(GLenum type, GLsizei stride, const void *pointer){
+	_core_pointer(1, 3, type, stride, pointer);
+}
+static void _core_color_pointer(GLint size, GLenum type, GLsizei stride, const void *pointer){
+	_core_pointer(2, size, type, stride, pointer);
+}
+static void _core_tex_coord_pointer(GLint size, GLenum type, GLsizei stride, const void *pointer){
+	_core_pointer(3, size, type, stride, pointer);
+}
+static void _core_array_query(int array){
+	GLint value;
+	GLvoid *pointer;
+	_core_unbind_arrays();
+	_core.arrays[array].size = 3;
+	if(_core_array_queries[array][0]){
+		glGetIntegerv(_core_array_queries[array][0], &value);
+		_core.arrays[array].size = value;
+	}
+	glGetIntegerv(_core_array_queries[array][1], &value);
+	_core.arrays[array].type = value;
+	glGetIntegerv(_core_array_queries[array][2], &value);
+	_core.arrays[array].stride = value;
+	glGetIntegerv(_core_array_queries[array][3], &value);
+	_core.arrays[array].buffer = value;
+	glGetPointerv(_core_array_queries[array][4], &pointer);
+	_core.arrays[array].pointer = pointer;
+	_core.arraysKnown |= 1 << array;
+}
+static size_t _core_type_size(GLenum type){
+	switch(type){
+		case GL_BYTE: case GL_UNSIGNED_BYTE: return 1;
+		case GL_SHORT: case GL_UNSIGNED_SHORT: return 2;
+		case GL_DOUBLE: return 8;
+		default: return 4;
+	}
+}
+static void _core_color_unknown(){
+	_state.known &= ~_KNOWN_COLOR;
+	_state_color_changed();
+}
+//////// STATE THE SHADERS MIMIC
+static int _core_enabled(GLenum cap){
+	int i = _state_cap(cap);
+	if(!(_state.capsKnown & (1 << i))){
+		if(glIsEnabled(cap)){ _state.caps |= 1 << i; }
+		else                { _state.caps &= ~(1 << i); }
+		_state.capsKnown |= 1 << i;
+	}
+	return (_state.caps & (1 << i)) != 0;
+}
+static GLuint _core_texture(int slot){
+	unsigned int bit = _KNOWN_TEXTURE_2D << slot;
+	if(!(_state.known & bit)){
+		GLint texture;
+		glGetIntegerv(slot ? GL_TEXTURE_BINDING_CUBE_MAP : GL_TEXTURE_BINDING_2D, &texture);
+		_state.textures[slot] = texture;
+		_state.known |= bit;
+	}
+	return _state.textures[slot];
+}
+// a texture of alpha alone modulates differently than a shader multiplying
+static int _core_alpha_texture(GLuint texture){
+	if(_core.checkedTexture != texture){
+		GLint format;
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+		_core.alphaTexture = (format == GL_ALPHA || format == GL_ALPHA4 || format == GL_ALPHA8 || format == GL_ALPHA12 || format == GL_ALPHA16);
+		_core.checkedTexture = texture;
+	}
+	return _core.alphaTexture;
+}
+static GLuint _core_program_in_use(){
+	if(!(_state.known & _KNOWN_PROGRAM)){
+		GLint program;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+		_state.program = program;
+		_state.known |= _KNOWN_PROGRAM;
+	}
+	return _state.program;
+}
+static void _core_fixed(){
+	if(_core.fixedKnown){ return; }
+	GLint value;
+	_core.fallback = 0;
+	for(int i = 0; i < 18; i++){
+		if(glIsEnabled(_core_fallback_caps[i])){ _core.fallback = 1; }
+	}
+	glGetIntegerv(GL_SHADE_MODEL, &value);
+	if(value == GL_FLAT){ _core.fallback = 1; }
+	glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+	if(value != GL_TEXTURE0){ _core.fallback = 1; }  // the queries below, and the shaders' sampler, are unit 0's
+	glGetTexEnviv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, &value);
+	_core.modulate = (value == GL_MODULATE);
+	_core.cubeMap = glIsEnabled(GL_TEXTURE_CUBE_MAP);
+	_core.fixedKnown = 1;
+}
+//////// SHADERS
+static GLuint _core_shader(GLenum type, const char *defines, const char *source){
+	const char *sources[3] = { "#version 130\n", defines, source };
+	GLuint shader = glCreateShader(type);
+	GLint result = GL_FALSE, logLength;
+	glShaderSource(shader, 3, sources, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &result);
+	if(result != GL_TRUE){
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+		char errorLog[logLength + 1]; errorLog[0] = 0;
+		glGetShaderInfoLog(shader, logLength, NULL, errorLog);
+		printf("CORE PROFILE SHADER COMPILE %s", errorLog);
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+static _CoreProgram *_core_program(unsigned int key){
+	_CoreProgram *p = &_core.programs[key];
+	if(p->program){ return p; }
+	if(p->failed){ return NULL; }
+	char defines[128] = "";
+	if(key & _CORE_TEXTURE_2D){ strcat(defines, "#define TEXTURE_2D\n"); }
+	if(key & _CORE_TEXTURE_CUBE_MAP){ strcat(defines, "#define TEXTURE_CUBE_MAP\n"); }
+	GLuint vertex = _core_shader(GL_VERTEX_SHADER, defines, _core_vertex_source);
+	GLuint fragment = _core_shader(GL_FRAGMENT_SHADER, defines, _core_fragment_source);
+	GLint result = GL_FALSE;
+	if(vertex && fragment){
+		p->program = glCreateProgram();
+		glAttachShader(p->program, vertex);
+		glAttachShader(p->program, fragment);
+		for(int i = 0; i < 4; i++){ glBindAttribLocation(p->program, _core_locations[i], _core_attributes[i]); }
+		glLinkProgram(p->program);
+		glGetProgramiv(p->program, GL_LINK_STATUS, &result);
+	}
+	if(vertex){ glDeleteShader(vertex); }
+	if(fragment){ glDeleteShader(fragment); }
+	if(result != GL_TRUE){
+		if(p->program){ glDeleteProgram(p->program); }
+		p->program = 0;
+		p->failed = 1;
+		return NULL;
+	}
+	p->matrix = glGetUniformLocation(p->program, "u_matrix");
+	glUseProgram(p->program);
+	glUniform1i(glGetUniformLocation(p->program, "u_texture"), 0);
+	_core.programBound = p->program;
+	return p;
+}
+static void _core_uniforms(_CoreProgram *p){
+	if(_core.computed != _core.version){
+		memcpy(_core.matrix, _core.stacks[1][_core.depth[1]], sizeof(float) * 16);
+		_core_multiply(_core.matrix, _core.stacks[0][_core.depth[0]]);
+		_core.computed = _core.version;
+	}
+	if(p->matrixVersion != _core.version){
+		glUniform4fv(p->matrix, 4, _core.matrix);
+		p->matrixVersion = _core.version;
+	}
+}
+//////// DRAWING
+static int _core_ready(){
+	if(!_core.ready){
+		const char *version = (const char*)glGetString(GL_VERSION);
+		_core.ready = (version && atoi(version) >= 3) ? 1 : -1;
+		if(_core.ready < 0){ return 0; }
+		_core_bindings();
+		glGenVertexArrays(1, &_core.vao);
+		glGenBuffers(1, &_core.stream);
+		_core_bind_array(_core.stream);
+		glBufferData(GL_ARRAY_BUFFER, _CORE_STREAM_BYTES, NULL, GL_STREAM_DRAW);
+		_core.streamUsed = 0;
+		_core.version++;
+	}
+	if(_core.ready < 0){ return 0; }
+	if(_core.staticDirty){
+		if(!_core.statics){ glGenBuffers(1, &_core.statics); }
+		_core_bind_array(_core.statics);
+		glBufferData(GL_ARRAY_BUFFER, _core.staticBytes, NULL, GL_STATIC_DRAW);
+		for(int i = 0; i < _core.staticCount; i++){
+			glBufferSubData(GL_ARRAY_BUFFER, _core.staticArrays[i].offset, _core.staticArrays[i].bytes, _core.staticArrays[i].data);
+		}
+		memset(_core.attributes, 0, sizeof(_core.attributes));  // the buffer's storage changed under them
+		_core.elementsBound = 0;
+		_core.staticDirty = 0;
+		_core_bind_array(_core.arrayBuffer);
+	}
+	return 1;
+}
+// room for bytes in the stream buffer, which is bound. a full buffer is orphaned and started over
+static size_t _core_stream(size_t bytes){
+	if(_core.streamUsed + bytes > _CORE_STREAM_BYTES){
+		glBufferData(GL_ARRAY_BUFFER, _CORE_STREAM_BYTES, NULL, GL_STREAM_DRAW);
+		_core.streamUsed = 0;
+	}
+	size_t offset = _core.streamUsed;
+	_core.streamUsed += (bytes + 15) & ~(size_t)15;
+	return offset;
+}
+static void _core_constant(int array, const float value[4]){
+	unsigned char bit = 1 << array;
+	if((_core.constantsKnown & bit) && !memcmp(_core.constants[array], value, sizeof(float) * 4)){ return; }
+	glVertexAttrib4fv(_core_locations[array], value);
+	memcpy(_core.constants[array], value, sizeof(float) * 4);
+	_core.constantsKnown |= bit;
+}
+// 1: drawn with the framework's shaders, 0: it has to go the old way. type is 0 for glDrawArrays()
+static int _core_draw(GLenum mode, GLint first, GLsizei count, GLenum type, const void *indices){
+	if(_state.compiling || mode == GL_POINTS || count <= 0 || !_core_ready()){ return 0; }
+	_core_bindings();
+	if(_core.vertexArray || _core_program_in_use()){ return 0; }
+	unsigned char arrays = _state.drawArrays;
+	if(!(arrays & _STATE_VERTEX)){ return 0; }
+	_core_fixed();
+	if(_core.fallback){ return 0; }
+	// which shader
+	if(_core_enabled(GL_LIGHTING)){ return 0; }
+	unsigned int key = 0;
+	if(_core.cubeMap && _core_texture(1)){ key |= _CORE_TEXTURE_CUBE_MAP; }
+	else if(_core_enabled(GL_TEXTURE_2D) && _core_texture(0)){
+		if(_core_alpha_texture(_state.textures[0])){ return 0; }
+		key |= _CORE_TEXTURE_2D;
+	}
+	if((key & (_CORE_TEXTURE_2D | _CORE_TEXTURE_CUBE_MAP)) && (!_core.modulate || _core.otherMatrix)){ return 0; }
+	unsigned char used = _STATE_VERTEX | _STATE_COLOR;
+	if(key & (_CORE_TEXTURE_2D | _CORE_TEXTURE_CUBE_MAP)){ used |= _STATE_TEXCOORD; }
+	arrays &= used;
+	// where each array is read from: the sketch's buffer, the static buffer, or streamed
+	_CoreArray source[4];
+	size_t elements[4];
+	unsigned char streamed = 0;
+	for(int i = 0; i < 4; i++){
+		if(!(arrays & (1 << i))){ continue; }
+		if(!(_core.arraysKnown & (1 << i))){ _core_array_query(i); }
+		source[i] = _core.arrays[i];
+		elements[i] = source[i].size * _core_type_size(source[i].type);
+		if(!source[i].stride){ source[i].stride = elements[i]; }
+		// glDrawArrays() is drawn from 0, after the first vertex
+		const char *start = (const char*)source[i].pointer + (type ? 0 : (size_t)first * source[i].stride);
+		source[i].pointer = start;
+		if(source[i].buffer){ continue; }
+		long offset = _core_static_find(start, type ? elements[i] : (size_t)(count - 1) * source[i].stride + elements[i]);
+		if(offset >= 0){
+			source[i].buffer = _core.statics;
+			source[i].pointer = (const void*)(uintptr_t)offset;
+			continue;
+		}
+		if(type && _core.elementBuffer){ return 0; }  // how many vertices isn't known without reading the buffer back
+		streamed |= 1 << i;
+	}
+	GLuint indexBuffer = 0;
+	uintptr_t indexOffset = 0;
+	size_t indexBytes = type ? count * _core_type_size(type) : 0;
+	int streamIndices = 0;
+	if(type){
+		if(_core.elementBuffer){
+			indexBuffer = _core.elementBuffer;
+			indexOffset = (uintptr_t)indices;
+		}
+		else{
+			long offset = _core_static_find(indices, indexBytes);
+			if(offset >= 0){
+				indexBuffer = _core.statics;
+				indexOffset = offset;
+			}
+			else{ streamIndices = 1; }
+		}
+	}
+	// streamed arrays are read up to the highest index
+	size_t vertices = count;
+	if(type && streamed){
+		unsigned int highest = 0;
+		for(GLsizei i = 0; i < count; i++){
+			unsigned int index = (type == GL_UNSIGNED_BYTE) ? ((const GLubyte*)indices)[i] :
+			                     (type == GL_UNSIGNED_SHORT) ? ((const GLushort*)indices)[i] : ((const GLuint*)indices)[i];
+			if(index > highest){ highest = index; }
+		}
+		vertices = (size_t)highest + 1;
+	}
+	size_t bytes[4], total = streamIndices ? (indexBytes + 15) & ~(size_t)15 : 0;
+	for(int i = 0; i < 4; i++){
+		if(!(streamed & (1 << i))){ continue; }
+		bytes[i] = (vertices - 1) * source[i].stride + elements[i];
+		total += (bytes[i] + 15) & ~(size_t)15;
+	}
+	if(total > _CORE_STREAM_BYTES / 4){ return 0; }
+	_CoreProgram *p = _core_program(key);
+	if(!p){ return 0; }
+	if(total){
+		_core_bind_array(_core.stream);
+		size_t offset = _core_stream(total);
+		for(int i = 0; i < 4; i++){
+			if(!(streamed & (1 << i))){ continue; }
+			glBufferSubData(GL_ARRAY_BUFFER, offset, bytes[i], source[i].pointer);
+			source[i].buffer = _core.stream;
+			source[i].pointer = (const void*)(uintptr_t)offset;
+			offset += (bytes[i] + 15) & ~(size_t)15;
+		}
+		if(streamIndices){
+			glBufferSubData(GL_ARRAY_BUFFER, offset, indexBytes, indices);
+			indexBuffer = _core.stream;
+			indexOffset = offset;
+		}
+	}
+	if(!_core.vaoBound){
+		glBindVertexArray(_core.vao);
+		_core.vaoBound = 1;
+	}
+	if(_core.programBound != p->program){
+		glUseProgram(p->program);
+		_core.programBound = p->program;
+	}
+	_core_uniforms(p);
+	for(int i = 0; i < 4; i++){
+		unsigned char bit = 1 << i;
+		GLuint location = _core_locations[i];
+		if(arrays & bit){
+			_CoreArray *a = &_core.attributes[i];
+			if(memcmp(a, &source[i], sizeof(_CoreArray))){
+				GLboolean normalized = (i == 1 || i == 2) && source[i].type != GL_FLOAT && source[i].type != GL_DOUBLE;
+				_core_bind_array(source[i].buffer);
+				glVertexAttribPointer(location, source[i].size, source[i].type, normalized, source[i].stride, source[i].pointer);
+				*a = source[i];
+			}
+			if(!(_core.enabled & bit)){
+				glEnableVertexAttribArray(location);
+				_core.enabled |= bit;
+			}
+			_core.constantsKnown &= ~bit;  // undefined after drawing with an array
+			continue;
+		}
+		if(_core.enabled & bit){
+			glDisableVertexAttribArray(location);
+			_core.enabled &= ~bit;
+		}
+		if(!(used & bit)){ continue; }
+		float value[4] = { 0, 0, 0, 1 };
+		switch(i){
+			case 2:
+				if(!(_state.known & _KNOWN_COLOR)){
+					glGetFloatv(GL_CURRENT_COLOR, _state.color);
+					_state.known |= _KNOWN_COLOR;
+				}
+				memcpy(value, _state.color, sizeof(value));
+				break;
+			case 3: glGetFloatv(GL_CURRENT_TEXTURE_COORDS, value); break;
+		}
+		_core_constant(i, value);
+	}
+	if(type){
+		if(_core.elementsBound != indexBuffer){
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+			_core.elementsBound = indexBuffer;
+		}
+		glDrawElements(mode, count, type, (const void*)indexOffset);
+	}
+	else{ glDrawArrays(mode, 0, count); }
+	if(_core.arrayBuffer){ _core_bind_array(_core.arrayBuffer); }  // so the sketch's own buffer calls find it
+	if(arrays & _STATE_COLOR){ _core_color_unknown(); }
+	return 1;
+}
+#endif
+#define glColor3f(r, g, b) _state_color(r, g, b, 1.0)
+#define glColor4f(r, g, b, a) _state_color(r, g, b, a)
+#define glMaterialfv(face, pname, params) _state_materialfv(face, pname, params)
+#define glLineWidth(width) _state_line_width(width)
+#define glPointSize(size) _state_point_size(size)
+#define glBindTexture(target, texture) _state_bind_texture(target, texture)
+#define glDeleteTextures(n, textures) _state_delete_textures(n, textures)
+#define glEnable(cap) _state_enable(cap, 1)
+#define glDisable(cap) _state_enable(cap, 0)
+#define glEnableClientState(array) _state_client(array, 1)
+#define glDisableClientState(array) _state_client(array, 0)
+#define glDrawArrays(mode, first, count) _state_draw_arrays(mode, first, count)
+#define glDrawElements(mode, count, type, indices) _state_draw_elements(mode, count, type, indices)
+#define glPopAttrib() _state_pop_attrib()
+#define glPopClientAttrib() _state_pop_client_attrib()
+#define glNewList(list, mode) _state_new_list(list, mode)
+#define glEndList() _state_end_list()
+#define glCallList(list) _state_call_list(list)
+#define glCallLists(n, type, lists) _state_call_lists(n, type, lists)
+#if defined(__glew_h__) || defined(GL_VERSION_2_0)
+#  undef glUseProgram  // a function pointer with glew
+#  define glUseProgram(program) _state_use_program(program)
+#endif
+#if defined(__glew_h__) || defined(GL_VERSION_1_3)
+#  undef glActiveTexture
+#  define glActiveTexture(texture) _state_active_texture(texture)
+#endif
+#ifdef _CORE_PROFILE
+// matrices reach GL and the copy the shaders read
+#  define glMatrixMode(mode) _core_matrix_mode(mode)
+#  define glLoadIdentity() _core_load_identity()
+#  define glPushMatrix() _core_push_matrix()
+#  define glPopMatrix() _core_pop_matrix()
+#  define glTranslatef(x, y, z) _core_translatef(x, y, z)
+#  define glTranslated(x, y, z) _core_translated(x, y, z)
+#  define glRotatef(angle, x, y, z) _core_rotatef(angle, x, y, z)
+#  define glRotated(angle, x, y, z) _core_rotated(angle, x, y, z)
+#  define glScalef(x, y, z) _core_scalef(x, y, z)
+#  define glScaled(x, y, z) _core_scaled(x, y, z)
+#  define glMultMatrixf(m) _core_mult_matrixf(m)
+#  define glMultMatrixd(m) _core_mult_matrixd(m)
+#  define glLoadMatrixf(m) _core_load_matrixf(m)
+#  define glLoadMatrixd(m) _core_load_matrixd(m)
+#  define glOrtho(left, right, bottom, top, near, far) _core_gl_ortho(left, right, bottom, top, near, far)
+#  define glFrustum(left, right, bottom, top, near, far) _core_gl_frustum(left, right, bottom, top, near, far)
+#  define gluPerspective(fovy, aspect, near, far) _core_glu_perspective(fovy, aspect, near, far)
+#  define gluOrtho2D(left, right, bottom, top) _core_glu_ortho_2d(left, right, bottom, top)
+#  define gluLookAt(eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ) _core_glu_look_at(eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ)
+#  define glGetFloatv(pname, params) _core_get_floatv(pname, params)
+// where the arrays are
+#  define glVertexPointer(size, type, stride, pointer) _core_vertex_pointer(size, type, stride, pointer)
+#  define glNormalPointer(type, stride, pointer) _core_normal_pointer(type, stride, pointer)
+#  define glColorPointer(size, type, stride, pointer) _core_color_pointer(size, type, stride, pointer)
+#  define glTexCoordPointer(size, type, stride, pointer) _core_tex_coord_pointer(size, type, stride, pointer)
+#  undef glBindBuffer  // function pointers with glew
+#  undef glDeleteBuffers
+#  undef glBindVertexArray
+#  define glBindBuffer(target, buffer) _core_bind_buffer(target, buffer)
+#  define glDeleteBuffers(n, buffers) _core_delete_buffers(n, buffers)
+#  define glBindVertexArray(array) _core_bind_vertex_array(array)
+// state the shaders read back when it changes
+#  define glShadeModel(mode) (_core.fixedKnown = 0, glShadeModel(mode))
+#  define glTexEnvf(target, pname, param) (_core.fixedKnown = 0, glTexEnvf(target, pname, param))
+#  define glTexEnvi(target, pname, param) (_core.fixedKnown = 0, glTexEnvi(target, pname, param))
+#  define glTexEnvfv(target, pname, params) (_core.fixedKnown = 0, glTexEnvfv(target, pname, params))
+#  define glTexEnviv(target, pname, params) (_core.fixedKnown = 0, glTexEnviv(target, pname, params))
+#  define glColor3ub(r, g, b) (_core_color_unknown(), glColor3ub(r, g, b))
+#  define glColor4ub(r, g, b, a) (_core_color_unknown(), glColor4ub(r, g, b, a))
+#  define glColor3d(r, g, b) (_core_color_unknown(), glColor3d(r, g, b))
+#  define glColor4d(r, g, b, a) (_core_color_unknown(), glColor4d(r, g, b, a))
+#  define glColor3fv(v) (_core_color_unknown(), glColor3fv(v))
+#  define glColor4fv(v) (_core_color_unknown(), glColor4fv(v))
+// what draws without the framework's shaders puts the sketch's program back first
+#  ifndef COUNT_RAW_GL
+#    define glBegin(mode) (_core_release(), glBegin(mode))
+#  endif
+#  define glRasterPos2f(x, y) (_core_release(), glRasterPos2f(x, y))
+#  define glRasterPos2i(x, y) (_core_release(), glRasterPos2i(x, y))
+#  define glRasterPos2d(x, y) (_core_release(), glRasterPos2d(x, y))
+#  define glRasterPos3f(x, y, z) (_core_release(), glRasterPos3f(x, y, z))
+#  define glRasterPos3i(x, y, z) (_core_release(), glRasterPos3i(x, y, z))
+#  define glRasterPos3d(x, y, z) (_core_release(), glRasterPos3d(x, y, z))
+#  define glBitmap(width, height, x, y, moveX, moveY, bitmap) (_core_release(), glBitmap(width, height, x, y, moveX, moveY, bitmap))
+#  define glDrawPixels(width, height, format, type, pixels) (_core_release(), glDrawPixels(width, height, format, type, pixels))
+#  define glRectf(x1, y1, x2, y2) (_core_release(), glRectf(x1, y1, x2, y2))
+#  define glRecti(x1, y1, x2, y2) (_core_release(), glRecti(x1, y1, x2, y2))
+#  define gluSphere(quad, radius, slices, stacks) (_core_release(), gluSphere(quad, radius, slices, stacks))
+#  define gluCylinder(quad, base, top, height, slices, stacks) (_core_release(), gluCylinder(quad, base, top, height, slices, stacks))
+#  define gluDisk(quad, inner, outer, slices, loops) (_core_release(), gluDisk(quad, inner, outer, slices, loops))
+#  define glutBitmapCharacter(font, character) (_core_release(), glutBitmapCharacter(font, character))
+#  define glutStrokeCharacter(font, character) (_core_release(), glutStrokeCharacter(font, character))
+#  define glutSolidSphere(radius, slices, stacks) (_core_release(), glutSolidSphere(radius, slices, stacks))
+#  define glutWireSphere(radius, slices, stacks) (_core_release(), glutWireSphere(radius, slices, stacks))
+#  define glutSolidCube(size) (_core_release(), glutSolidCube(size))
+#  define glutWireCube(size) (_core_release(), glutWireCube(size))
+#  define glutSolidTeapot(size) (_core_release(), glutSolidTeapot(size))
+#  define glutWireTeapot(size) (_core_release(), glutWireTeapot(size))
+#  define glutSwapBuffers() (_core_release(), glutSwapBuffers())
+#endif
+#ifdef COUNT_RAW_GL
+// immediate mode: a glBegin() is a draw, and every glVertex() a vertex
+static void _state_begin(GLenum mode){
+	_state_count_draw(0);
+#ifdef _CORE_PROFILE
+	_core_release();
+#endif
+	glBegin(mode);
+}
+#  define glBegin(mode) _state_begin(mode)
+#  define glVertex2f(x, y) (_state.counting.vertices++, glVertex2f(x, y))
+#  define glVertex3f(x, y, z) (_state.counting.vertices++, glVertex3f(x, y, z))
+#  define glVertex2d(x, y) (_state.counting.vertices++, glVertex2d(x, y))
+#  define glVertex3d(x, y, z) (_state.counting.vertices++, glVertex3d(x, y, z))
+#  define glVertex2i(x, y) (_state.counting.vertices++, glVertex2i(x, y))
+#  define glVertex3i(x, y, z) (_state.counting.vertices++, glVertex3i(x, y, z))
+#  define glVertex2fv(v) (_state.counting.vertices++, glVertex2fv(v))
+#  define glVertex3fv(v) (_state.counting.vertices++, glVertex3fv(v))
+#endif
+
 int main(int argc, char **argv){
 	// initialize glut
 	glutInit(&argc, argv);
@@ -191,6 +1803,9 @@ int main(int argc, char **argv){
 	glutInitWindowPosition(10,10);
 	glutInitWindowSize(WIDTH,HEIGHT);
 	glutCreateWindow(argv[0]);
+#ifdef __glew_h__
+	glewInit();  // buffer and shader entry points need a context to load
+#endif
 	// tie this program's functions to glut
 	glutDisplayFunc(display);
 	glutReshapeFunc(reshapeWindow);
@@ -212,6 +1827,7 @@ int main(int argc, char **argv){
 	clock_gettime(CLOCK_MONOTONIC, &START);
 	FRAME = 0;
 	initPrimitives();
+	workerCount();  // starts the worker threads
 	time_t t;
 	srand((unsigned) time(&t));
 	typicalOpenGLSettings();
@@ -264,13 +1880,17 @@ void toggleFullscreen(){
 	}
 	FULLSCREEN = !FULLSCREEN;
 }
+// the lens both perspectives share, the camera is multiplied on after it
+static void _view_frustum(){
+	float a = (float)min(WIDTH, HEIGHT) / max(WIDTH, HEIGHT);
+	if(WIDTH < HEIGHT){ glFrustum(-FOV, FOV, -FOV/a, FOV/a, NEAR_CLIP, FAR_CLIP); }
+	else              { glFrustum(-FOV/a, FOV/a, -FOV, FOV, NEAR_CLIP, FAR_CLIP); }
+}
 void firstPersonPerspective(){
 	PERSPECTIVE = FPP;
-	float a = (float)min(WIDTH, HEIGHT) / max(WIDTH, HEIGHT);
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
-	if(WIDTH < HEIGHT){ glFrustum(-FOV, FOV, -FOV/a, FOV/a, NEAR_CLIP, FAR_CLIP); }
-	else              { glFrustum(-FOV/a, FOV/a, -FOV, FOV, NEAR_CLIP, FAR_CLIP); }
+	_view_frustum();
 	// change POV
 	glRotatef(-90-HORIZON[1], 1, 0, 0);
 	glRotatef(90+HORIZON[0], 0, 0, 1);
@@ -282,11 +1902,9 @@ void firstPersonPerspective(){
 }
 void polarPerspective(){
 	PERSPECTIVE = POLAR;
-	float a = (float)min(WIDTH, HEIGHT) / max(WIDTH, HEIGHT);
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
-	if(WIDTH < HEIGHT){ glFrustum(-FOV, FOV, -FOV/a, FOV/a, NEAR_CLIP, FAR_CLIP); }
-	else              { glFrustum(-FOV/a, FOV/a, -FOV, FOV, NEAR_CLIP, FAR_CLIP); }
+	_view_frustum();
 	// change POV
 	glTranslatef(0, 0, -HORIZON[2]);
 	glRotatef(-90+HORIZON[1], 1, 0, 0);
@@ -309,14 +1927,22 @@ void orthoPerspective(float x, float y, float width, float height){
 	}
 	glMatrixMode(GL_MODELVIEW);
 }
-void display(){
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
+static int _pipeline_running();
+static void _pipeline_wait();
+static int _pipeline_update();
+static void _capture_frame();
+static unsigned char _resolution_begin();
+static void _resolution_end();
+static void _viewports_display();
+static void _viewports_focus(int x, int y);
+// the 3D pass, through one camera
+static void _display_3d(){
 	glPushMatrix();
 		glPushMatrix();
 			glColor4f(1.0, 1.0, 1.0, 1.0);
 			if(SETTINGS & (1 << BIT_KEYBOARD_MOVE)){ glTranslatef(-ORIGIN[0], -ORIGIN[1], -ORIGIN[2]); }
 			draw3D();
+			flushRenderQueue();
 		glPopMatrix();
 		// 3D REPEATED STRUCTURE
 		if(SETTINGS & (1 << BIT_SHOW_GRID)){
@@ -338,6 +1964,14 @@ void display(){
 			glPopMatrix();
 		}
 	glPopMatrix();
+}
+void display(){
+	_state_frame();
+	unsigned char scaled = _resolution_begin();  // with DYNAMIC_RESOLUTION, the 3D pass goes into a smaller target
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	if(!_pipeline_running()){ waitTasks(); }  // work started in update() is finished before anything draws
+	_viewports_display();  // once for each view, or once for the window without any
+	if(scaled){ _resolution_end(); }  // stretched over the window
 	
 	// TO ORTHOGRAPHIC
 	glMatrixMode(GL_PROJECTION);
@@ -349,15 +1983,19 @@ void display(){
 	glMatrixMode(GL_MODELVIEW);
 	glPushMatrix();
 		glColor4f(1.0, 1.0, 1.0, 1.0);
+		_state_restore_arrays();  // the 3D pass's toolbox draws left theirs on
 		draw2D();
+		_state_restore_arrays();
 	glPopMatrix();
 	rebuildProjection();
 
+	_capture_frame();  // while recording, starts reading this frame back
 	// bring back buffer to the front on vertical refresh, auto-calls glFlush
 	glutSwapBuffers();
 	// glFlush();
 }
 void updateWorld(){
+	_pipeline_wait();  // time and the camera only change between updates
 	FRAME += 1;
 	updateTime();
 	clock_gettime(CLOCK_MONOTONIC, &CURRENT);
@@ -405,7 +2043,7 @@ void updateWorld(){
 			rebuildProjection();
 		}
 	}
-	update();
+	if(!_pipeline_update()){ update(); }
 	glutPostRedisplay();
 }
 ////////////////////////////////////////
@@ -624,6 +2262,7 @@ void mouseUpdatePerspective(int dx, int dy){
 }
 // when mouse button state changes
 void mouseButtons(int button, int state, int x, int y){
+	if(!state){ _viewports_focus(x, y); }  // input steers the view clicked in
 	if(button == GLUT_LEFT_BUTTON){
 		if(!state){  // button down
 			mouseX = x;
@@ -774,17 +2413,17 @@ void text(const char *text, float x, float y, float z){
 } 
 void drawPoint(float x, float y, float z){
 	GLfloat _point_vertex[] = { x, y, z };
-	glEnableClientState(GL_VERTEX_ARRAY);
+	_state_arrays(_STATE_VERTEX);
 	glVertexPointer(3, GL_FLOAT, 0, _point_vertex);
 	glDrawArrays(GL_POINTS, 0, 1);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawLine(float x1, float y1, float z1, float x2, float y2, float z2){
 	GLfloat _lines_vertices[6] = {x1, y1, z1, x2, y2, z2};
-	glEnableClientState(GL_VERTEX_ARRAY);
+	_state_arrays(_STATE_VERTEX);
 	glVertexPointer(3, GL_FLOAT, 0, _lines_vertices);
 	glDrawArrays(GL_LINES, 0, 2);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitOriginSquareFill(){
 	static const GLfloat _unit_square_vertex[] = {
@@ -792,16 +2431,12 @@ void drawUnitOriginSquareFill(){
 	static const GLfloat _unit_square_normals[] = {
 		0.0f, 0.0f, 1.0f,     0.0f, 0.0f, 1.0f,    0.0f, 0.0f, 1.0f,    0.0f, 0.0f, 1.0f };
 	static const GLfloat _texture_coordinates[] = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_NORMAL_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);  
+	_state_arrays(_STATE_VERTEX | _STATE_NORMAL | _STATE_TEXCOORD);
 	glVertexPointer(3, GL_FLOAT, 0, _unit_square_vertex);
 	glNormalPointer(GL_FLOAT, 0, _unit_square_normals);
 	glTexCoordPointer(2, GL_FLOAT, 0, _texture_coordinates);
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitOriginSquareWireframe(){
 	static const GLfloat _unit_square_wireframe_vertex[] = {
@@ -809,10 +2444,10 @@ void drawUnitOriginSquareWireframe(){
 		0.0f, 1.0f, 0.0f,    1.0f, 1.0f, 0.0f,
 		1.0f, 1.0f, 0.0f,    1.0f, 0.0f, 0.0f,
 		1.0f, 0.0f, 0.0f,    0.0f, 0.0f, 0.0f };
-	glEnableClientState(GL_VERTEX_ARRAY);
+	_state_arrays(_STATE_VERTEX);
 	glVertexPointer(3, GL_FLOAT, 0, _unit_square_wireframe_vertex);
 	glDrawArrays(GL_LINES, 0, 4);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitSquare(float x, float y, float z){
 	glPushMatrix();
@@ -841,10 +2476,10 @@ void drawUnitPlaneWireframe(int subdivisions){
 		_plane_vertices[ i * 12 + 0] = _plane_vertices[ i * 12 + 3] = _plane_vertices[ i * 12 + 7] = _plane_vertices[ i * 12 + 10] = step;
 		_plane_vertices[ i * 12 + 4] = _plane_vertices[ i * 12 + 9] = 1.0;
 	}
-	glEnableClientState(GL_VERTEX_ARRAY);
+	_state_arrays(_STATE_VERTEX);
 	glVertexPointer(3, GL_FLOAT, 0, _plane_vertices);
 	glDrawArrays(GL_LINES, 0, (subdivisions+1)*4);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitOriginPlane(int subdivisions){
 	switch(SHAPE_FILL){
@@ -863,17 +2498,13 @@ void drawPlane(float x, float y, float z, float width, float height, int subdivi
 	glPopMatrix();
 }
 void drawUnitOriginSphereFill(){
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_NORMAL_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);  
+	_state_arrays(_STATE_VERTEX | _STATE_NORMAL | _STATE_TEXCOORD);
 	glVertexPointer(3, GL_FLOAT, 0, _unit_sphere_vertices);
 	glNormalPointer(GL_FLOAT, 0, _unit_sphere_normals);
 	glTexCoordPointer(2, GL_FLOAT, 0, _unit_sphere_texture);
 	// glDrawArrays(GL_LINE_LOOP, 0, _sphere_slices * _sphere_stacks * 2 );//(_sphere_slices+1) * 2 * (_sphere_stacks-1)+2  );
 	glDrawArrays(GL_TRIANGLE_STRIP, 0,  _sphere_slices * _sphere_stacks * 2 );// (_sphere_slices+1) * 2 * (_sphere_stacks-1)+2  );
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitOriginSphereWireframe(int subdivisions){
 	glPushMatrix();
@@ -916,22 +2547,18 @@ void drawSphere(float x, float y, float z, float radius){
 	glPopMatrix();
 }
 void drawUnitOriginCircleFill(){
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_NORMAL_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);  
+	_state_arrays(_STATE_VERTEX | _STATE_NORMAL | _STATE_TEXCOORD);
 	glVertexPointer(3, GL_FLOAT, 0, _unit_circle_fill_vertices);
 	glNormalPointer(GL_FLOAT, 0, _unit_circle_fill_normals);
 	glTexCoordPointer(2, GL_FLOAT, 0, _unit_circle_fill_texCoord);
 	glDrawArrays(GL_TRIANGLE_FAN, 0, 66);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitOriginCircleWireframe(){
-	glEnableClientState(GL_VERTEX_ARRAY);
+	_state_arrays(_STATE_VERTEX);
 	glVertexPointer(3, GL_FLOAT, 0, _unit_circle_outline_vertices);
 	glDrawArrays(GL_LINE_LOOP, 0, 64);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawUnitOriginCircle(){
 	switch(SHAPE_FILL){
@@ -960,10 +2587,10 @@ void draw3DAxesLines(float x, float y, float z, float scale){
 	glPushMatrix();
 	glTranslatef(x, y, z);
 	glScalef(scale, scale, scale);
-	glEnableClientState(GL_VERTEX_ARRAY);
+	_state_arrays(_STATE_VERTEX);
 	glVertexPointer(3, GL_FLOAT, 0, _axis_lines_vertices);
 	glDrawArrays(GL_LINES, 0, 6);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 	glPopMatrix();
 }
 const float _tetrahedron_points[12] = {1.0,0.0,0.0,-0.3333,-0.9428,0.0,-0.3333,0.4714,0.81649,-0.3333,0.4714,-0.8164};
@@ -993,31 +2620,25 @@ const unsigned short* _platonic_line_array[6] = {_tetrahedron_lines,_octahedron_
 const unsigned short* _platonic_face_array[6] = {_tetrahedron_faces,_octahedron_faces,_hexahedron_triangle_faces,_icosahedron_faces,_dodecahedron_triangle_faces,_tetrahedron_dual_faces};
 const int _platonic_dual_index[6] = { 5,2,1,4,3,0 };
 void drawPlatonicSolidFaces(char solidType){
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_NORMAL_ARRAY);
+	_state_arrays(_STATE_VERTEX | _STATE_NORMAL);
 	glVertexPointer(3, GL_FLOAT, 0, _platonic_point_arrays[solidType]);
 	glNormalPointer(GL_FLOAT, 0, _platonic_point_arrays[ solidType ]);
 	glDrawElements(GL_TRIANGLES, 3*_platonic_num_faces[solidType], GL_UNSIGNED_SHORT, _platonic_face_array[solidType]);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawPlatonicSolidLines(char solidType){
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_NORMAL_ARRAY);
+	_state_arrays(_STATE_VERTEX | _STATE_NORMAL);
 	glVertexPointer(3, GL_FLOAT, 0, _platonic_point_arrays[solidType]);
 	glNormalPointer(GL_FLOAT, 0, _platonic_point_arrays[ solidType ]);
 	glDrawElements(GL_LINES, 2*_platonic_num_lines[solidType], GL_UNSIGNED_SHORT, _platonic_line_array[solidType]);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawPlatonicSolidPoints(char solidType){
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_NORMAL_ARRAY);
+	_state_arrays(_STATE_VERTEX | _STATE_NORMAL);
 	glVertexPointer(3, GL_FLOAT, 0, _platonic_point_arrays[solidType]);
 	glNormalPointer(GL_FLOAT, 0, _platonic_point_arrays[ solidType ]);
 	glDrawArrays(GL_POINTS, 0, _platonic_num_vertices[solidType]);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	_state_arrays_done();
 }
 void drawTetrahedron(float scale){
 	glPushMatrix();
@@ -1133,6 +2754,13 @@ GLuint loadTextureSmooth(const char * filename, int width, int height){
 void initPrimitives(){
 	static unsigned char _geometry_initialized = 0;
 	if (!_geometry_initialized) {
+#ifdef GL_PRIMITIVE_RESTART
+		// the header can know it while the driver doesn't
+		const char *version = (const char*)glGetString(GL_VERSION);
+		int major = 0, minor = 0;
+		if(version != NULL){ sscanf(version, "%d.%d", &major, &minor); }
+		_primitive_restart = (major > 3 || (major == 3 && minor >= 1));
+#endif
 		// CIRCLE
 		for(int i = 0; i < 64; i++){
 			_unit_circle_outline_vertices[i*3+0] = -sinf(M_PI*2/64.0f*i);
@@ -1200,6 +2828,22 @@ void initPrimitives(){
 				tPtr += 2*2;
 			}
 		}
+#ifdef _CORE_PROFILE
+		// these never change, they're uploaded once
+		size_t sphere = (_sphere_slices*2+2) * (_sphere_stacks);
+		_core_static(_unit_circle_outline_vertices, sizeof(_unit_circle_outline_vertices));
+		_core_static(_unit_circle_fill_vertices, sizeof(_unit_circle_fill_vertices));
+		_core_static(_unit_circle_fill_normals, sizeof(_unit_circle_fill_normals));
+		_core_static(_unit_circle_fill_texCoord, sizeof(_unit_circle_fill_texCoord));
+		_core_static(_unit_sphere_vertices, sizeof(GLfloat) * 3 * sphere);
+		_core_static(_unit_sphere_normals, sizeof(GLfloat) * 3 * sphere);
+		_core_static(_unit_sphere_texture, sizeof(GLfloat) * 2 * sphere);
+		for(int i = 0; i < 6; i++){
+			_core_static(_platonic_point_arrays[i], sizeof(float) * 3 * _platonic_num_vertices[i]);
+			_core_static(_platonic_line_array[i], sizeof(unsigned short) * 2 * _platonic_num_lines[i]);
+			_core_static(_platonic_face_array[i], sizeof(unsigned short) * 3 * _platonic_num_faces[i]);
+		}
+#endif
 		_geometry_initialized = 1;
 	}
 }
@@ -1273,6 +2917,13 @@ void headsUpDisplay(int x, int y, int z){
 	text(line2String, x, y+13*2, z);
 	text(line3String, x, y+13*3, z);
 	text(line4String, x, y+13*4, z);
+	if(SHOW_FRAME_STATS){
+		FrameStats stats = frameStats();
+		char line5String[100];
+		sprintf(line5String, "DRAWS %lu  VERTICES %lu  STATE %lu (%lu SKIPPED)  TEXTURES %lu  PROGRAMS %lu",
+			stats.drawCalls, stats.vertices, stats.stateChanges, stats.stateSkipped, stats.textureBinds, stats.programSwitches);
+		text(line5String, x, y+13*5, z);
+	}
 }
 void drawAxesLabels(float scale){
 	text("+X", scale, 0, 0);  text("-X", -scale, 0, 0);
@@ -1297,15 +2948,17 @@ void drawCheckerboard(float walkX, float walkY, int numSquares){
 	int evenOdd = (numSquares%2);
 	if(evenOdd) 
 		numSquares--;
-	for(int i = -numSquares*.5; i < numSquares*.5; i++){
-		for(int j = -numSquares*.5; j < numSquares*.5; j++){
-			int b = abs(((i+j+XOffset+YOffset)%2));
-			if(b) { glColor3f(1.0, 1.0, 1.0); glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_white); }
-			else { glColor3f(0.0, 0.0, 0.0); glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_black); }
-			drawUnitSquare(i-XOffset - evenOdd, j-YOffset - evenOdd, 0);
+	// black squares, then white, so the color changes twice instead of every square
+	for(int b = 0; b < 2; b++){
+		if(b) { glColor3f(1.0, 1.0, 1.0); glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_white); }
+		else { glColor3f(0.0, 0.0, 0.0); glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_black); }
+		for(int i = -numSquares*.5; i < numSquares*.5; i++){
+			for(int j = -numSquares*.5; j < numSquares*.5; j++){
+				if(abs(((i+j+XOffset+YOffset)%2)) != b){ continue; }
+				drawUnitSquare(i-XOffset - evenOdd, j-YOffset - evenOdd, 0);
+			}
 		}
 	}
-	glMaterialfv(GL_FRONT, GL_DIFFUSE, mat_white);
 }
 // span: how many units to skip inbetween each axis
 // repeats: how many rows/cols/stacks on either side of center
@@ -1487,6 +3140,13 @@ void setMat4Identity(float *m){
 	m[8] = 0; m[9] = 0; m[10] = 1; m[11] = 0;
 	m[12] = 0; m[13] = 0; m[14] = 0; m[15] = 1;
 }
+// column-major, same as glTranslatef() followed by glScalef()
+void makeMat4TranslateScale(float *m, float x, float y, float z, float scaleX, float scaleY, float scaleZ){
+	m[0] = scaleX; m[1] = 0; m[2] = 0; m[3] = 0;
+	m[4] = 0; m[5] = scaleY; m[6] = 0; m[7] = 0;
+	m[8] = 0; m[9] = 0; m[10] = scaleZ; m[11] = 0;
+	m[12] = x; m[13] = y; m[14] = z; m[15] = 1;
+}
 // MATRICES & VECTORS
 void mat4Vec4Mult(const float m[16], const float v[4], float result[4]){
 	result[0] = m[0] * v[0] + m[1] * v[1] + m[2] * v[2] + m[3] * v[3];
@@ -1511,4 +3171,2910 @@ void vec3Normalize(float vec[3]){
 	vec[1] /= m;
 	vec[2] /= m;
 }
+///////////////////////////////////////
+//////////   COMMAND LISTS   //////////
+///////////////////////////////////////
+// everything drawn between recordCommandList() and endCommandList() is compiled
+// by the driver: geometry is copied into its own buffers and the transforms
+// are pre-multiplied, so replaying a list costs one call regardless of its contents.
+//   if(recordCommandList(&grid, hashInputs(&size, sizeof(size)))){
+//       ... draw calls ...
+//       endCommandList();
+//   }
+//   drawCommandList(&grid);
+// GL lists don't nest: a recording started during another one draws into that one,
+// and is only made into its own list the next time it's asked for outside
+static CommandList *_recording_command_list = NULL;
+static int _nested_command_lists = 0;
+unsigned char recordCommandList(CommandList *commands, unsigned long key){
+	if(commands->valid && commands->key == key){ return 0; }
+	if(_recording_command_list != NULL){
+		_nested_command_lists++;
+		return 1;
+	}
+	if(!commands->list){ commands->list = glGenLists(1); }
+	commands->key = key;
+	commands->valid = 0;
+	_recording_command_list = commands;
+	glNewList(commands->list, GL_COMPILE);
+	return 1;
+}
+void endCommandList(){
+	if(_recording_command_list == NULL){ return; }
+	if(_nested_command_lists){
+		_nested_command_lists--;
+		return;
+	}
+	glEndList();
+	_recording_command_list->valid = 1;
+	_recording_command_list = NULL;
+}
+void drawCommandList(CommandList *commands){
+	if(commands->valid){ glCallList(commands->list); }
+}
+// the next recordCommandList() will re-record, even if the key is unchanged
+void invalidateCommandList(CommandList *commands){ commands->valid = 0; }
+void freeCommandList(CommandList *commands){
+	if(commands->list){ glDeleteLists(commands->list, 1); }
+	commands->list = 0;
+	commands->valid = 0;
+}
+// FNV-1a, to turn the inputs of a recording into a key
+unsigned long hashInputs(const void *data, size_t size){
+	const unsigned char *bytes = (const unsigned char*)data;
+	unsigned long hash = 2166136261u;
+	for(size_t i = 0; i < size; i++){
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+///////////////////////////////////////
+//////////       MESHES      //////////
+///////////////////////////////////////
+// attribute arrays are uploaded once into static vertex buffers. the caller
+// keeps ownership of the arrays: after editing one, call meshDirty() with the
+// range that changed and only that range is re-uploaded on the next drawMesh().
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+static unsigned int _mesh_element_size(Mesh *mesh, int attribute){
+	if(attribute == MESH_INDEX){ return sizeof(uint32_t); }
+	return sizeof(float) * mesh->components[attribute];
+}
+static unsigned int _mesh_element_count(Mesh *mesh, int attribute){
+	return (attribute == MESH_INDEX) ? mesh->numIndices : mesh->numVertices;
+}
+static GLenum _mesh_buffer_target(int attribute){
+	return (attribute == MESH_INDEX) ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+}
+Mesh *createMesh(GLenum mode, unsigned int numVertices, unsigned int numIndices){
+	Mesh *mesh = (Mesh*)calloc(1, sizeof(Mesh));
+	mesh->mode = mode;
+	mesh->numVertices = numVertices;
+	mesh->numIndices = numIndices;
+	return mesh;
+}
+// data can be NULL to only allocate the buffer, fill it later with updateMesh()
+void setMeshAttribute(Mesh *mesh, int attribute, int components, const void *data){
+	GLenum target = _mesh_buffer_target(attribute);
+	mesh->components[attribute] = (attribute == MESH_INDEX) ? 1 : components;
+	mesh->data[attribute] = data;
+	mesh->dirtyFirst[attribute] = mesh->dirtyEnd[attribute] = 0;
+	if(!mesh->buffers[attribute]){ glGenBuffers(1, &mesh->buffers[attribute]); }
+	glBindBuffer(target, mesh->buffers[attribute]);
+	glBufferData(target, _mesh_element_size(mesh, attribute) * _mesh_element_count(mesh, attribute), data, GL_STATIC_DRAW);
+	glBindBuffer(target, 0);
+}
+// first and count are in vertices (or indices). ranges grow until the next draw
+void meshDirty(Mesh *mesh, int attribute, unsigned int first, unsigned int count){
+	unsigned int end = first + count;
+	if(end > _mesh_element_count(mesh, attribute)){ end = _mesh_element_count(mesh, attribute); }
+	if(first >= end){ return; }
+	if(mesh->dirtyEnd[attribute] == mesh->dirtyFirst[attribute]){
+		mesh->dirtyFirst[attribute] = first;
+		mesh->dirtyEnd[attribute] = end;
+		return;
+	}
+	if(first < mesh->dirtyFirst[attribute]){ mesh->dirtyFirst[attribute] = first; }
+	if(end > mesh->dirtyEnd[attribute]){ mesh->dirtyEnd[attribute] = end; }
+}
+// upload immediately. data points at the first element being replaced
+void updateMesh(Mesh *mesh, int attribute, unsigned int first, unsigned int count, const void *data){
+	GLenum target = _mesh_buffer_target(attribute);
+	unsigned int size = _mesh_element_size(mesh, attribute);
+	if(!mesh->buffers[attribute] || first + count > _mesh_element_count(mesh, attribute)){ return; }
+	glBindBuffer(target, mesh->buffers[attribute]);
+	glBufferSubData(target, first * size, count * size, data);
+	glBindBuffer(target, 0);
+}
+static void _mesh_upload_dirty(Mesh *mesh){
+	for(int i = 0; i < MESH_ATTRIBUTES; i++){
+		if(mesh->dirtyEnd[i] > mesh->dirtyFirst[i] && mesh->data[i] != NULL){
+			unsigned int size = _mesh_element_size(mesh, i);
+			const char *data = (const char*)mesh->data[i];
+			updateMesh(mesh, i, mesh->dirtyFirst[i], mesh->dirtyEnd[i] - mesh->dirtyFirst[i], &data[mesh->dirtyFirst[i] * size]);
+		}
+		mesh->dirtyFirst[i] = mesh->dirtyEnd[i] = 0;
+	}
+}
+// point the fixed-function arrays at the mesh's buffers
+static void _mesh_bind(Mesh *mesh){
+	_mesh_upload_dirty(mesh);
+	if(!SHAPE_FILL){ glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); }
+	unsigned char arrays = _STATE_VERTEX;
+	glBindBuffer(GL_ARRAY_BUFFER, mesh->buffers[MESH_POSITION]);
+	glVertexPointer(mesh->components[MESH_POSITION], GL_FLOAT, 0, 0);
+	if(mesh->buffers[MESH_NORMAL]){
+		arrays |= _STATE_NORMAL;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->buffers[MESH_NORMAL]);
+		glNormalPointer(GL_FLOAT, 0, 0);
+	}
+	if(mesh->buffers[MESH_COLOR]){
+		arrays |= _STATE_COLOR;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->buffers[MESH_COLOR]);
+		glColorPointer(mesh->components[MESH_COLOR], GL_FLOAT, 0, 0);
+	}
+	if(mesh->buffers[MESH_TEXCOORD]){
+		arrays |= _STATE_TEXCOORD;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->buffers[MESH_TEXCOORD]);
+		glTexCoordPointer(mesh->components[MESH_TEXCOORD], GL_FLOAT, 0, 0);
+	}
+	_state_arrays(arrays);
+}
+static void _mesh_unbind(){
+	// client-side arrays elsewhere in the toolbox expect no buffer bound
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	_state_arrays_done();
+	if(!SHAPE_FILL){ glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); }
+}
+void drawMesh(Mesh *mesh){
+	if(mesh == NULL || !mesh->buffers[MESH_POSITION]){ return; }
+	_mesh_bind(mesh);
+	if(mesh->buffers[MESH_INDEX] && mesh->numIndices){
+#ifdef GL_PRIMITIVE_RESTART
+		if(mesh->primitiveRestart && _primitive_restart){
+			glEnable(GL_PRIMITIVE_RESTART);
+			glPrimitiveRestartIndex(0xFFFFFFFF);
+		}
+#endif
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->buffers[MESH_INDEX]);
+		glDrawElements(mesh->mode, mesh->numIndices, GL_UNSIGNED_INT, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#ifdef GL_PRIMITIVE_RESTART
+		if(mesh->primitiveRestart && _primitive_restart){ glDisable(GL_PRIMITIVE_RESTART); }
+#endif
+	}
+	else{
+		glDrawArrays(mesh->mode, 0, mesh->numVertices);
+	}
+	_mesh_unbind();
+}
+void freeMesh(Mesh *mesh){
+	if(mesh == NULL){ return; }
+	for(int i = 0; i < MESH_ATTRIBUTES; i++){
+		if(mesh->buffers[i]){ glDeleteBuffers(1, &mesh->buffers[i]); }
+	}
+	free(mesh);
+}
+#endif
+///////////////////////////////////////
+//////////       GRIDS       //////////
+///////////////////////////////////////
+static int _cpu_count(){
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count < 1) ? 1 : (int)count;
+}
+// rows [0, rows) on the worker pool, threads caps how many pieces. 0: automatic
+static void _parallelRows(int rows, int threads, void (*body)(void *context, int first, int end), void *context){
+	if(threads == 1){ body(context, 0, rows); return; }
+	parallelFor(0, rows, (threads > 0) ? (rows + threads - 1) / threads : 0, body, context);
+}
+#define GRID_RESTART_INDEX 0xFFFFFFFF
+// a strip per row pair is 2 indices per column, plus a restart or 2 degenerate indices between rows
+static unsigned int _grid_strip_row_indices(Grid *grid){
+	return grid->columns * 2 + (_primitive_restart ? 1 : 2);
+}
+// heights come from the user's array, or from positions already sampled by heightFunction
+static void _grid_vertex(Grid *grid, int w, int h, float v[3]){
+	int i = h * grid->columns + w;
+	v[0] = (w - grid->columns*0.5f) * grid->spacing;
+	v[1] = (h - grid->rows*0.5f) * grid->spacing;
+	v[2] = (grid->heights != NULL) ? grid->heights[i] : grid->positions[i*3+2];
+	if(grid->offsets != NULL){
+		v[0] += grid->offsets[i*2+0];
+		v[1] += grid->offsets[i*2+1];
+	}
+}
+static void _grid_sample_rows(void *context, int first, int end){
+	Grid *grid = (Grid*)context;
+	for(int h = first; h < end; h++){
+		for(int w = 0; w < grid->columns; w++){
+			grid->positions[(h*grid->columns+w)*3+2] = grid->heightFunction(w, h, grid->context);
+		}
+	}
+}
+// positions, normals and the indices starting on this row are written together,
+// reading only the row above and below, so a band of rows stays in cache
+static void _grid_build_rows(void *context, int first, int end){
+	Grid *grid = (Grid*)context;
+	int columns = grid->columns;
+	int rows = grid->rows;
+	float left[3], right[3], down[3], up[3], dx[3], dy[3];
+	for(int h = first; h < end; h++){
+		for(int w = 0; w < columns; w++){
+			int i = h*columns + w;
+			float *n = &grid->normals[i*3];
+			float v[3];
+			_grid_vertex(grid, w, h, v);
+			// smooth normal from central differences, one-sided on the border
+			_grid_vertex(grid, (w > 0) ? w-1 : w, h, left);
+			_grid_vertex(grid, (w < columns-1) ? w+1 : w, h, right);
+			_grid_vertex(grid, w, (h > 0) ? h-1 : h, down);
+			_grid_vertex(grid, w, (h < rows-1) ? h+1 : h, up);
+			for(int j = 0; j < 3; j++){
+				dx[j] = right[j] - left[j];
+				dy[j] = up[j] - down[j];
+			}
+			vec3Cross(dx, dy, n);
+			float m = sqrtf(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+			if(m > 0){ n[0] /= m;  n[1] /= m;  n[2] /= m; }
+			else { n[0] = 0;  n[1] = 0;  n[2] = 1; }
+			// sampled heights are already in place, neighboring bands are reading them
+			grid->positions[i*3+0] = v[0];
+			grid->positions[i*3+1] = v[1];
+			if(grid->heights != NULL){ grid->positions[i*3+2] = v[2]; }
+		}
+		if(h == rows-1){ continue; }
+		if(grid->strips){
+			uint32_t *index = &grid->indices[h * _grid_strip_row_indices(grid)];
+			for(int w = 0; w < columns; w++){
+				*index++ = h*columns + w;
+				*index++ = (h+1)*columns + w;
+			}
+			if(_primitive_restart){ *index = GRID_RESTART_INDEX; }
+			else{
+				// repeat the last and next vertex, an even count keeps the winding
+				index[0] = (h+1)*columns + columns-1;
+				index[1] = (h+1)*columns;
+			}
+		}
+		else{
+			uint32_t *index = &grid->indices[h * (columns-1) * 6];
+			for(int w = 0; w < columns-1; w++){
+				index[w*6+0] = h*columns + w;
+				index[w*6+1] = (h+1)*columns + w;
+				index[w*6+2] = h*columns + w+1;
+				index[w*6+3] = (h+1)*columns + w;
+				index[w*6+4] = (h+1)*columns + w+1;
+				index[w*6+5] = h*columns + w+1;
+			}
+		}
+	}
+}
+void buildGrid(Grid *grid){
+	if(grid->columns < 2 || grid->rows < 2){ return; }
+	unsigned int numVertices = grid->columns * grid->rows;
+	unsigned int numIndices = (grid->strips)
+		? (grid->rows-1) * _grid_strip_row_indices(grid) - (_grid_strip_row_indices(grid) - grid->columns*2)  // nothing after the last row
+		: (grid->rows-1) * (grid->columns-1) * 6;
+	// keep the same arrays when the size is unchanged, meshes may be pointing at them
+	if(grid->positions == NULL || grid->numVertices != numVertices){
+		free(grid->positions);
+		free(grid->normals);
+		grid->positions = (float*)malloc(sizeof(float) * numVertices * 3);
+		grid->normals = (float*)malloc(sizeof(float) * numVertices * 3);
+	}
+	if(grid->indices == NULL || grid->numIndices != numIndices){
+		free(grid->indices);
+		// the last row's trailing restart is written then ignored, leave room for it
+		grid->indices = (uint32_t*)malloc(sizeof(uint32_t) * (numIndices + 2));
+	}
+	grid->numVertices = numVertices;
+	grid->numIndices = numIndices;
+	if(grid->heights == NULL && grid->heightFunction != NULL){
+		_parallelRows(grid->rows, grid->threads, _grid_sample_rows, grid);
+	}
+	else if(grid->heights == NULL){
+		for(unsigned int i = 0; i < numVertices; i++){ grid->positions[i*3+2] = 0.0f; }
+	}
+	_parallelRows(grid->rows, grid->threads, _grid_build_rows, grid);
+}
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+Mesh *gridMesh(Grid *grid){
+	Mesh *mesh = createMesh((grid->strips) ? GL_TRIANGLE_STRIP : GL_TRIANGLES, grid->numVertices, grid->numIndices);
+	mesh->primitiveRestart = grid->strips && _primitive_restart;
+	setMeshAttribute(mesh, MESH_POSITION, 3, grid->positions);
+	setMeshAttribute(mesh, MESH_NORMAL, 3, grid->normals);
+	setMeshAttribute(mesh, MESH_INDEX, 1, grid->indices);
+	return mesh;
+}
+#endif
+void freeGrid(Grid *grid){
+	free(grid->positions);
+	free(grid->normals);
+	free(grid->indices);
+	grid->positions = grid->normals = NULL;
+	grid->indices = NULL;
+	grid->numVertices = grid->numIndices = 0;
+}
+///////////////////////////////////////
+//////////  STATIC BATCHES   //////////
+///////////////////////////////////////
+// primitives that never move relative to each other are transformed on the
+// CPU once and merged into one mesh per texture, so hundreds of objects cost a
+// few draw calls. removing an object collapses its triangles in place.
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+typedef struct{
+	unsigned int numVertices, numIndices;
+	const float *points, *normals, *texcoords;  // texcoords can be NULL
+	uint32_t *indices;
+} _BatchShape;
+static _BatchShape _batch_shapes[BATCH_PRIMITIVES];
+static const float _batch_square_points[] = { 0,1,0,  1,1,0,  0,0,0,  1,0,0 };
+static const float _batch_square_normals[] = { 0,0,1,  0,0,1,  0,0,1,  0,0,1 };
+static const float _batch_square_texcoords[] = { 0,0,  1,0,  0,1,  1,1 };
+// the toolbox draws the square and sphere as strips, a batch needs a triangle list
+static uint32_t *_batch_strip_to_list(unsigned int numVertices, unsigned int *numIndices){
+	*numIndices = (numVertices - 2) * 3;
+	uint32_t *indices = (uint32_t*)malloc(sizeof(uint32_t) * (*numIndices));
+	for(unsigned int i = 0; i < numVertices - 2; i++){
+		// every other triangle is flipped to keep the strip's winding
+		indices[i*3+0] = (i%2) ? i+1 : i;
+		indices[i*3+1] = (i%2) ? i : i+1;
+		indices[i*3+2] = i+2;
+	}
+	return indices;
+}
+static _BatchShape *_batch_shape(int primitive){
+	_BatchShape *shape = &_batch_shapes[primitive];
+	if(shape->indices != NULL){ return shape; }
+	switch(primitive){
+		case BATCH_SQUARE:
+			shape->numVertices = 4;
+			shape->points = _batch_square_points;
+			shape->normals = _batch_square_normals;
+			shape->texcoords = _batch_square_texcoords;
+			shape->indices = _batch_strip_to_list(shape->numVertices, &shape->numIndices);
+			break;
+		case BATCH_SPHERE:
+			shape->numVertices = _sphere_slices * _sphere_stacks * 2;
+			shape->points = _unit_sphere_vertices;
+			shape->normals = _unit_sphere_normals;
+			shape->texcoords = _unit_sphere_texture;
+			shape->indices = _batch_strip_to_list(shape->numVertices, &shape->numIndices);
+			break;
+		default:  // platonic solids, the normals point along the vertices
+			shape->numVertices = _platonic_num_vertices[primitive];
+			shape->points = shape->normals = _platonic_point_arrays[primitive];
+			shape->numIndices = 3 * _platonic_num_faces[primitive];
+			shape->indices = (uint32_t*)malloc(sizeof(uint32_t) * shape->numIndices);
+			for(unsigned int i = 0; i < shape->numIndices; i++){
+				shape->indices[i] = _platonic_face_array[primitive][i];
+			}
+			break;
+	}
+	return shape;
+}
+static void _batch_bake(StaticBatch *batch, int object, const float m[16]){
+	BatchRange *range = &batch->ranges[object];
+	BatchBucket *bucket = &batch->buckets[range->bucket];
+	_BatchShape *shape = _batch_shape(range->primitive);
+	// normals use the inverse transpose, so scaled objects stay lit correctly
+	float inverse[16];
+	if(!mat4Inverse(m, inverse)){ setMat4Identity(inverse); }
+	for(unsigned int i = 0; i < shape->numVertices; i++){
+		const float *p = &shape->points[i*3];
+		const float *n = &shape->normals[i*3];
+		float *position = &bucket->positions[(range->firstVertex + i) * 3];
+		float *normal = &bucket->normals[(range->firstVertex + i) * 3];
+		for(int j = 0; j < 3; j++){
+			position[j] = m[j]*p[0] + m[4+j]*p[1] + m[8+j]*p[2] + m[12+j];
+			normal[j] = inverse[j*4+0]*n[0] + inverse[j*4+1]*n[1] + inverse[j*4+2]*n[2];
+		}
+		vec3Normalize(normal);
+		if(bucket->texcoords != NULL){
+			float *texcoord = &bucket->texcoords[(range->firstVertex + i) * 2];
+			texcoord[0] = (shape->texcoords != NULL) ? shape->texcoords[i*2+0] : 0.0f;
+			texcoord[1] = (shape->texcoords != NULL) ? shape->texcoords[i*2+1] : 0.0f;
+		}
+	}
+	// a mirroring transform turns the triangles inside out, flip them back
+	float determinant = m[0]*(m[5]*m[10] - m[9]*m[6]) - m[4]*(m[1]*m[10] - m[9]*m[2]) + m[8]*(m[1]*m[6] - m[5]*m[2]);
+	uint32_t *indices = &bucket->indices[range->firstIndex];
+	for(unsigned int i = 0; i < shape->numIndices; i += 3){
+		indices[i+0] = range->firstVertex + shape->indices[i+0];
+		indices[i+1] = range->firstVertex + shape->indices[(determinant < 0) ? i+2 : i+1];
+		indices[i+2] = range->firstVertex + shape->indices[(determinant < 0) ? i+1 : i+2];
+	}
+}
+StaticBatch *buildStaticBatch(const BatchObject *objects, int count){
+	StaticBatch *batch = (StaticBatch*)calloc(1, sizeof(StaticBatch));
+	batch->numObjects = count;
+	batch->ranges = (BatchRange*)calloc(count + 1, sizeof(BatchRange));
+	batch->buckets = (BatchBucket*)calloc(count + 1, sizeof(BatchBucket));  // at most one per object
+	// first pass: find every object's bucket and its place inside it
+	for(int i = 0; i < count; i++){
+		BatchRange *range = &batch->ranges[i];
+		range->primitive = objects[i].primitive;
+		if(range->primitive < 0 || range->primitive >= BATCH_PRIMITIVES){
+			range->bucket = -1;
+			continue;
+		}
+		int b = 0;
+		while(b < batch->numBuckets && batch->buckets[b].texture != objects[i].texture){ b++; }
+		if(b == batch->numBuckets){
+			batch->buckets[b].texture = objects[i].texture;
+			batch->numBuckets++;
+		}
+		BatchBucket *bucket = &batch->buckets[b];
+		_BatchShape *shape = _batch_shape(range->primitive);
+		range->bucket = b;
+		range->firstVertex = bucket->numVertices;
+		range->firstIndex = bucket->numIndices;
+		bucket->numVertices += shape->numVertices;
+		bucket->numIndices += shape->numIndices;
+		if(objects[i].color[3] != 0.0f){ bucket->colored = 1; }
+	}
+	for(int b = 0; b < batch->numBuckets; b++){
+		BatchBucket *bucket = &batch->buckets[b];
+		bucket->positions = (float*)malloc(sizeof(float) * bucket->numVertices * 3);
+		bucket->normals = (float*)malloc(sizeof(float) * bucket->numVertices * 3);
+		bucket->indices = (uint32_t*)malloc(sizeof(uint32_t) * bucket->numIndices);
+		if(bucket->colored){ bucket->colors = (float*)malloc(sizeof(float) * bucket->numVertices * 4); }
+		if(bucket->texture){ bucket->texcoords = (float*)malloc(sizeof(float) * bucket->numVertices * 2); }
+	}
+	// second pass: bake
+	for(int i = 0; i < count; i++){
+		BatchRange *range = &batch->ranges[i];
+		if(range->bucket < 0){ continue; }
+		_batch_bake(batch, i, objects[i].transform);
+		BatchBucket *bucket = &batch->buckets[range->bucket];
+		if(bucket->colors == NULL){ continue; }
+		// uncolored objects sharing a bucket with colored ones are drawn white
+		const float white[4] = {1.0, 1.0, 1.0, 1.0};
+		const float *color = (objects[i].color[3] != 0.0f) ? objects[i].color : white;
+		for(unsigned int v = 0; v < _batch_shape(range->primitive)->numVertices; v++){
+			memcpy(&bucket->colors[(range->firstVertex + v) * 4], color, sizeof(float) * 4);
+		}
+	}
+	for(int b = 0; b < batch->numBuckets; b++){
+		BatchBucket *bucket = &batch->buckets[b];
+		bucket->mesh = createMesh(GL_TRIANGLES, bucket->numVertices, bucket->numIndices);
+		setMeshAttribute(bucket->mesh, MESH_POSITION, 3, bucket->positions);
+		setMeshAttribute(bucket->mesh, MESH_NORMAL, 3, bucket->normals);
+		setMeshAttribute(bucket->mesh, MESH_INDEX, 1, bucket->indices);
+		if(bucket->colors){ setMeshAttribute(bucket->mesh, MESH_COLOR, 4, bucket->colors); }
+		if(bucket->texcoords){ setMeshAttribute(bucket->mesh, MESH_TEXCOORD, 2, bucket->texcoords); }
+	}
+	return batch;
+}
+void setStaticBatchTransform(StaticBatch *batch, int object, const float transform[16]){
+	if(object < 0 || object >= batch->numObjects || batch->ranges[object].bucket < 0){ return; }
+	BatchRange *range = &batch->ranges[object];
+	BatchBucket *bucket = &batch->buckets[range->bucket];
+	_BatchShape *shape = _batch_shape(range->primitive);
+	_batch_bake(batch, object, transform);
+	meshDirty(bucket->mesh, MESH_POSITION, range->firstVertex, shape->numVertices);
+	meshDirty(bucket->mesh, MESH_NORMAL, range->firstVertex, shape->numVertices);
+	meshDirty(bucket->mesh, MESH_INDEX, range->firstIndex, shape->numIndices);
+}
+void removeFromStaticBatch(StaticBatch *batch, int object){
+	if(object < 0 || object >= batch->numObjects || batch->ranges[object].bucket < 0){ return; }
+	BatchRange *range = &batch->ranges[object];
+	BatchBucket *bucket = &batch->buckets[range->bucket];
+	_BatchShape *shape = _batch_shape(range->primitive);
+	// every index points at the same vertex, the triangles have no area and are skipped
+	for(unsigned int i = 0; i < shape->numIndices; i++){
+		bucket->indices[range->firstIndex + i] = range->firstVertex;
+	}
+	meshDirty(bucket->mesh, MESH_INDEX, range->firstIndex, shape->numIndices);
+	range->bucket = -1;
+}
+void drawStaticBatch(StaticBatch *batch){
+	if(batch == NULL){ return; }
+	for(int b = 0; b < batch->numBuckets; b++){
+		BatchBucket *bucket = &batch->buckets[b];
+		// array colors reach lit surfaces through GL_COLOR_MATERIAL, and leave
+		// the current color and material changed afterwards
+		if(bucket->colored){
+			glPushAttrib(GL_CURRENT_BIT | GL_LIGHTING_BIT);
+			glEnable(GL_COLOR_MATERIAL);
+		}
+		if(bucket->texture){ glBindTexture(GL_TEXTURE_2D, bucket->texture); }
+		drawMesh(bucket->mesh);
+		if(bucket->texture){ glBindTexture(GL_TEXTURE_2D, 0); }
+		if(bucket->colored){ glPopAttrib(); }
+	}
+}
+void freeStaticBatch(StaticBatch *batch){
+	if(batch == NULL){ return; }
+	for(int b = 0; b < batch->numBuckets; b++){
+		BatchBucket *bucket = &batch->buckets[b];
+		freeMesh(bucket->mesh);
+		free(bucket->positions);
+		free(bucket->normals);
+		free(bucket->colors);
+		free(bucket->texcoords);
+		free(bucket->indices);
+	}
+	free(batch->buckets);
+	free(batch->ranges);
+	free(batch);
+}
+#endif
+//////// the camera
+// the perspectives keep the camera's turn and position in the projection
+// matrix, so eye space isn't the camera's. depth and distance come from
+// clip = projection * modelview instead
+static void _view_clip(const float modelview[16], float clip[16]){
+	float projection[16];
+	glGetFloatv(GL_PROJECTION_MATRIX, projection);
+	mat4x4MultUnique(modelview, projection, clip);
+}
+// nothing is divided by depth: the clip matrix's bottom row leaves w alone
+static unsigned char _view_orthographic(const float clip[16]){
+	return clip[3] == 0 && clip[7] == 0 && clip[11] == 0;
+}
+// the eye in the modelview's coordinates: where clip sends to infinity, the
+// inverse's third column. orthographic views have no such point
+static unsigned char _view_eye(const float clip[16], float eye[3]){
+	float inverse[16];
+	if(!mat4Inverse(clip, inverse) || fabsf(inverse[11]) < 1e-12){ return 0; }
+	for(int j = 0; j < 3; j++){ eye[j] = inverse[8+j] / inverse[11]; }
+	return 1;
+}
+// pixels per unit at a distance of 1, through the frustum the perspectives build
+static float _view_pixels(){
+	return min(WIDTH, HEIGHT) * 0.5 * NEAR_CLIP / FOV;
+}
+///////////////////////////////////////
+//////////   RENDER QUEUE    //////////
+///////////////////////////////////////
+// each draw is stored with its modelview and a 64 bit key, sorted, then run
+// in order. state is only changed between draws that differ. opaque draws are
+// grouped by shader and texture, nearest first so early depth testing rejects
+// hidden pixels; blended draws go farthest first with depth writes off.
+typedef struct{
+	uint64_t key;
+	unsigned int order;  // submission order, keeps equal keys stable
+	int pass;
+	GLuint shader, texture;
+	float modelview[16];
+	void (*draw)(void *data);
+	void *data;
+} _QueuedDraw;
+static _QueuedDraw *_render_queue = NULL;
+static unsigned int _render_queue_count = 0, _render_queue_capacity = 0;
+static RenderQueueStats _render_queue_stats;
+void submitDraw(int pass, GLuint shader, GLuint texture, void (*draw)(void *data), void *data){
+	if(draw == NULL){ return; }
+	if(_render_queue_count == _render_queue_capacity){
+		_render_queue_capacity = (_render_queue_capacity) ? _render_queue_capacity * 2 : 64;
+		_render_queue = (_QueuedDraw*)realloc(_render_queue, sizeof(_QueuedDraw) * _render_queue_capacity);
+	}
+	_QueuedDraw *entry = &_render_queue[_render_queue_count];
+	entry->order = _render_queue_count++;
+	entry->pass = (pass == RENDER_BLENDED) ? RENDER_BLENDED : RENDER_OPAQUE;
+	entry->shader = shader;
+	entry->texture = texture;
+	entry->draw = draw;
+	entry->data = data;
+	glGetFloatv(GL_MODELVIEW_MATRIX, entry->modelview);
+	// depth of the draw's origin in front of the camera: clip w, or clip z
+	// without perspective. positive floats compare the same as their bits
+	float clip[16];
+	_view_clip(entry->modelview, clip);
+	float distance = max(0.0, _view_orthographic(clip) ? clip[14] + 1 : clip[15]);
+	uint32_t depth;
+	memcpy(&depth, &distance, sizeof(depth));
+	uint64_t key = (uint64_t)entry->pass << 62;
+	if(entry->pass == RENDER_OPAQUE){
+		key |= (uint64_t)(shader & 0x3FFF) << 48;
+		key |= (uint64_t)(texture & 0xFFFF) << 32;
+		key |= depth;
+	} else{
+		key |= (uint64_t)(0xFFFFFFFF - depth) << 28;
+		key |= (uint64_t)(shader & 0x3FFF) << 14;
+		key |= (texture & 0x3FFF);
+	}
+	entry->key = key;
+}
+static int _render_queue_compare(const void *a, const void *b){
+	const _QueuedDraw *one = (const _QueuedDraw*)a, *two = (const _QueuedDraw*)b;
+	if(one->key != two->key){ return (one->key < two->key) ? -1 : 1; }
+	return (int)one->order - (int)two->order;
+}
+static int _render_queue_changes(const _QueuedDraw *from, const _QueuedDraw *to){
+	return (from->shader != to->shader) + (from->texture != to->texture) + (from->pass != to->pass);
+}
+void flushRenderQueue(){
+	if(_render_queue_count == 0){ return; }
+	// what running the draws as submitted would have cost
+	_QueuedDraw current = {0};
+	int unsorted = 0;
+	for(unsigned int i = 0; i < _render_queue_count; i++){
+		unsorted += _render_queue_changes(&current, &_render_queue[i]);
+		current = _render_queue[i];
+	}
+	qsort(_render_queue, _render_queue_count, sizeof(_QueuedDraw), _render_queue_compare);
+	memset(&current, 0, sizeof(current));
+	int sorted = 0;
+	glPushMatrix();
+	for(unsigned int i = 0; i < _render_queue_count; i++){
+		_QueuedDraw *entry = &_render_queue[i];
+		sorted += _render_queue_changes(&current, entry);
+		if(entry->pass != current.pass){
+			glEnable(GL_BLEND);
+			glDepthMask(GL_FALSE);
+		}
+#if defined(__glew_h__) || defined(GL_VERSION_2_0)
+		if(entry->shader != current.shader){ glUseProgram(entry->shader); }
+#endif
+		if(entry->texture != current.texture){ glBindTexture(GL_TEXTURE_2D, entry->texture); }
+		glLoadMatrixf(entry->modelview);
+		entry->draw(entry->data);
+		current = *entry;
+	}
+	glPopMatrix();
+	if(current.pass == RENDER_BLENDED){ glDepthMask(GL_TRUE); }
+#if defined(__glew_h__) || defined(GL_VERSION_2_0)
+	if(current.shader){ glUseProgram(0); }
+#endif
+	if(current.texture){ glBindTexture(GL_TEXTURE_2D, 0); }
+	_render_queue_stats.draws = _render_queue_count;
+	_render_queue_stats.stateChanges = sorted;
+	_render_queue_stats.stateChangesAvoided = unsorted - sorted;
+	_render_queue_count = 0;
+}
+RenderQueueStats renderQueueStats(){ return _render_queue_stats; }
+///////////////////////////////////////
+//////////      TERRAIN      //////////
+///////////////////////////////////////
+// tiles live in a fixed set of slots sized by the memory budget, so memory
+// stays bounded however far the camera goes. every frame the ring around the
+// camera is requested nearest first, workers fill the slots' arrays, and the
+// main thread uploads a few finished tiles. slots are recycled least recently
+// used first. vertex positions come from integer sample coordinates and normals
+// from a one-sample border, so both sides of a seam compute identical vertices.
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+enum{ TILE_EMPTY, TILE_QUEUED, TILE_WORKING, TILE_READY, TILE_UPLOADED };
+typedef struct{
+	int x, y;  // tile coordinates
+	int state;
+	unsigned long lastUsed;  // frame
+	float *heights;  // (resolution+2)^2, with a border for the normals
+	float *positions, *normals, *colors;
+	Mesh *mesh;
+} _TerrainTile;
+struct _TerrainStreamer{
+	_TerrainTile *tiles;
+	int numTiles;
+	int *queue;  // slot indices waiting for a worker, nearest first
+	int queueLength;
+	Mesh *indices;  // one strip pattern shared by every tile
+	unsigned int numIndices;
+	pthread_t *workers;
+	int numWorkers;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	unsigned char quit;
+	Terrain *terrain;
+};
+static size_t _terrain_tile_bytes(Terrain *terrain){
+	size_t n = terrain->resolution * terrain->resolution;
+	size_t border = (terrain->resolution + 2) * (terrain->resolution + 2);
+	// heights, then positions, normals and colors on both the CPU and the GPU
+	return sizeof(float) * (border + n * 9 * 2);
+}
+static void _terrain_generate(Terrain *terrain, _TerrainTile *tile){
+	int res = terrain->resolution;
+	int span = res + 2;
+	float spacing = terrain->tileSize / (res - 1);
+	// sample coordinates are integers shared by neighboring tiles
+	long firstX = (long)tile->x * (res - 1) - 1;
+	long firstY = (long)tile->y * (res - 1) - 1;
+	for(int r = 0; r < span; r++){
+		for(int c = 0; c < span; c++){
+			tile->heights[r*span+c] = terrain->height((firstX + c) * spacing, (firstY + r) * spacing, terrain->context);
+		}
+	}
+	for(int r = 0; r < res; r++){
+		for(int c = 0; c < res; c++){
+			int i = r*res + c;
+			const float *h = &tile->heights[(r+1)*span + (c+1)];
+			float x = (firstX + c + 1) * spacing;
+			float y = (firstY + r + 1) * spacing;
+			tile->positions[i*3+0] = x;
+			tile->positions[i*3+1] = y;
+			tile->positions[i*3+2] = h[0];
+			// central differences: (-dh/dx, -dh/dy, 1)
+			float n[3] = { (h[-1] - h[1]) / (2*spacing), (h[-span] - h[span]) / (2*spacing), 1.0 };
+			vec3Normalize(n);
+			memcpy(&tile->normals[i*3], n, sizeof(float)*3);
+			if(terrain->color != NULL){ terrain->color(x, y, h[0], &tile->colors[i*3], terrain->context); }
+		}
+	}
+}
+static void *_terrain_worker(void *arg){
+	struct _TerrainStreamer *streamer = (struct _TerrainStreamer*)arg;
+	pthread_mutex_lock(&streamer->lock);
+	while(1){
+		while(!streamer->quit && streamer->queueLength == 0){
+			pthread_cond_wait(&streamer->wake, &streamer->lock);
+		}
+		if(streamer->quit){ break; }
+		_TerrainTile *tile = &streamer->tiles[streamer->queue[0]];
+		streamer->queueLength--;
+		memmove(streamer->queue, &streamer->queue[1], sizeof(int) * streamer->queueLength);
+		tile->state = TILE_WORKING;
+		pthread_mutex_unlock(&streamer->lock);
+		_terrain_generate(streamer->terrain, tile);
+		pthread_mutex_lock(&streamer->lock);
+		tile->state = TILE_READY;
+	}
+	pthread_mutex_unlock(&streamer->lock);
+	return NULL;
+}
+static void _terrain_start(Terrain *terrain){
+	struct _TerrainStreamer *streamer = (struct _TerrainStreamer*)calloc(1, sizeof(struct _TerrainStreamer));
+	if(terrain->resolution < 2){ terrain->resolution = 65; }
+	if(terrain->tileSize <= 0){ terrain->tileSize = 64; }
+	if(terrain->radius < 1){ terrain->radius = 1; }
+	int ring = (terrain->radius*2 + 1) * (terrain->radius*2 + 1);
+	streamer->numTiles = terrain->memoryBudget / _terrain_tile_bytes(terrain);
+	if(streamer->numTiles < ring){ streamer->numTiles = ring; }
+	streamer->tiles = (_TerrainTile*)calloc(streamer->numTiles, sizeof(_TerrainTile));
+	streamer->queue = (int*)malloc(sizeof(int) * streamer->numTiles);
+	streamer->terrain = terrain;
+	int n = terrain->resolution * terrain->resolution;
+	int border = (terrain->resolution + 2) * (terrain->resolution + 2);
+	for(int i = 0; i < streamer->numTiles; i++){
+		_TerrainTile *tile = &streamer->tiles[i];
+		tile->heights = (float*)malloc(sizeof(float) * border);
+		tile->positions = (float*)malloc(sizeof(float) * n * 3);
+		tile->normals = (float*)malloc(sizeof(float) * n * 3);
+		tile->colors = (float*)calloc(n * 3, sizeof(float));
+	}
+	terrain->memoryUsed = streamer->numTiles * _terrain_tile_bytes(terrain);
+	// every tile draws with the same strip pattern
+	Grid pattern = {0};
+	pattern.columns = pattern.rows = terrain->resolution;
+	pattern.strips = 1;
+	pattern.threads = 1;
+	buildGrid(&pattern);
+	streamer->numIndices = pattern.numIndices;
+	streamer->indices = createMesh(GL_TRIANGLE_STRIP, 0, pattern.numIndices);
+	setMeshAttribute(streamer->indices, MESH_INDEX, 1, pattern.indices);
+	freeGrid(&pattern);
+	pthread_mutex_init(&streamer->lock, NULL);
+	pthread_cond_init(&streamer->wake, NULL);
+	streamer->numWorkers = (terrain->threads > 0) ? terrain->threads : _cpu_count() - 1;
+	if(streamer->numWorkers < 1){ streamer->numWorkers = 1; }
+	streamer->workers = (pthread_t*)malloc(sizeof(pthread_t) * streamer->numWorkers);
+	for(int i = 0; i < streamer->numWorkers; i++){
+		if(pthread_create(&streamer->workers[i], NULL, _terrain_worker, streamer) != 0){
+			streamer->numWorkers = i;  // none at all: updateTerrain() builds the tiles
+			break;
+		}
+	}
+	terrain->streamer = streamer;
+}
+static _TerrainTile *_terrain_find(struct _TerrainStreamer *streamer, int x, int y){
+	for(int i = 0; i < streamer->numTiles; i++){
+		_TerrainTile *tile = &streamer->tiles[i];
+		if(tile->state != TILE_EMPTY && tile->x == x && tile->y == y){ return tile; }
+	}
+	return NULL;
+}
+// a free slot, or the least recently used one outside the ring, emptied. NULL if all are busy
+static _TerrainTile *_terrain_slot(struct _TerrainStreamer *streamer, unsigned long frame){
+	_TerrainTile *oldest = NULL;
+	for(int i = 0; i < streamer->numTiles; i++){
+		_TerrainTile *tile = &streamer->tiles[i];
+		if(tile->state == TILE_EMPTY){ return tile; }
+		if(tile->state == TILE_WORKING || tile->lastUsed == frame){ continue; }
+		if(oldest == NULL || tile->lastUsed < oldest->lastUsed){ oldest = tile; }
+	}
+	if(oldest != NULL && oldest->state == TILE_QUEUED){
+		int slot = oldest - streamer->tiles;
+		for(int i = 0; i < streamer->queueLength; i++){
+			if(streamer->queue[i] != slot){ continue; }
+			streamer->queueLength--;
+			memmove(&streamer->queue[i], &streamer->queue[i+1], sizeof(int) * (streamer->queueLength - i));
+			break;
+		}
+		oldest->state = TILE_EMPTY;  // queued again for its new tile
+	}
+	return oldest;
+}
+static void _terrain_upload(struct _TerrainStreamer *streamer, _TerrainTile *tile){
+	Terrain *terrain = streamer->terrain;
+	unsigned int n = terrain->resolution * terrain->resolution;
+	if(tile->mesh == NULL){
+		tile->mesh = createMesh(GL_TRIANGLE_STRIP, n, streamer->numIndices);
+		tile->mesh->primitiveRestart = _primitive_restart;
+		setMeshAttribute(tile->mesh, MESH_POSITION, 3, tile->positions);
+		setMeshAttribute(tile->mesh, MESH_NORMAL, 3, tile->normals);
+		if(terrain->color != NULL){ setMeshAttribute(tile->mesh, MESH_COLOR, 3, tile->colors); }
+		// borrowed, see freeTerrain()
+		tile->mesh->buffers[MESH_INDEX] = streamer->indices->buffers[MESH_INDEX];
+		tile->mesh->components[MESH_INDEX] = 1;
+	} else{
+		updateMesh(tile->mesh, MESH_POSITION, 0, n, tile->positions);
+		updateMesh(tile->mesh, MESH_NORMAL, 0, n, tile->normals);
+		if(terrain->color != NULL){ updateMesh(tile->mesh, MESH_COLOR, 0, n, tile->colors); }
+	}
+}
+void updateTerrain(Terrain *terrain, float x, float y){
+	if(terrain->height == NULL){ return; }
+	if(terrain->streamer == NULL){ _terrain_start(terrain); }
+	struct _TerrainStreamer *streamer = terrain->streamer;
+	int centerX = floorf(x / terrain->tileSize);
+	int centerY = floorf(y / terrain->tileSize);
+	int uploads = (terrain->uploadsPerFrame > 0) ? terrain->uploadsPerFrame : 1;
+	_TerrainTile *ready[uploads];
+	int numReady = 0;
+	pthread_mutex_lock(&streamer->lock);
+	// the ring, nearest tiles first
+	for(int d = 0; d <= terrain->radius; d++){
+		for(int ty = centerY - d; ty <= centerY + d; ty++){
+			for(int tx = centerX - d; tx <= centerX + d; tx++){
+				if(abs(tx - centerX) != d && abs(ty - centerY) != d){ continue; }
+				_TerrainTile *tile = _terrain_find(streamer, tx, ty);
+				if(tile == NULL){
+					tile = _terrain_slot(streamer, FRAME);
+					if(tile == NULL){ continue; }
+					streamer->queue[streamer->queueLength++] = tile - streamer->tiles;
+					tile->x = tx;
+					tile->y = ty;
+					tile->state = TILE_QUEUED;
+				}
+				tile->lastUsed = FRAME;
+				// the nearest finished tiles go to the GPU first
+				if(tile->state == TILE_READY && numReady < uploads){ ready[numReady++] = tile; }
+			}
+		}
+	}
+	// without workers the nearest waiting tile is built here, one a frame
+	_TerrainTile *build = NULL;
+	if(streamer->numWorkers == 0 && streamer->queueLength){
+		build = &streamer->tiles[streamer->queue[0]];
+		streamer->queueLength--;
+		memmove(streamer->queue, &streamer->queue[1], sizeof(int) * streamer->queueLength);
+		build->state = TILE_WORKING;
+	}
+	terrain->tilesPending = streamer->queueLength;
+	if(streamer->queueLength){ pthread_cond_broadcast(&streamer->wake); }
+	pthread_mutex_unlock(&streamer->lock);
+	// uploading and building run unlocked: only this thread hands out slots, so these stay put
+	for(int i = 0; i < numReady; i++){ _terrain_upload(streamer, ready[i]); }
+	if(build != NULL){ _terrain_generate(terrain, build); }
+	if(numReady == 0 && build == NULL){ return; }
+	pthread_mutex_lock(&streamer->lock);
+	for(int i = 0; i < numReady; i++){ ready[i]->state = TILE_UPLOADED; }
+	if(build != NULL){ build->state = TILE_READY; }
+	pthread_mutex_unlock(&streamer->lock);
+}
+void drawTerrain(Terrain *terrain){
+	struct _TerrainStreamer *streamer = terrain->streamer;
+	terrain->tilesDrawn = 0;
+	if(streamer == NULL){ return; }
+	// tiles are only drawn once uploaded, the workers never touch them after
+	for(int i = 0; i < streamer->numTiles; i++){
+		_TerrainTile *tile = &streamer->tiles[i];
+		if(tile->lastUsed != FRAME || tile->mesh == NULL){ continue; }
+		if(tile->state != TILE_UPLOADED){ continue; }
+		drawMesh(tile->mesh);
+		terrain->tilesDrawn++;
+	}
+}
+// bilinear from a loaded tile, otherwise straight from the height function
+float terrainHeight(Terrain *terrain, float x, float y){
+	struct _TerrainStreamer *streamer = terrain->streamer;
+	if(streamer != NULL){
+		int res = terrain->resolution;
+		float spacing = terrain->tileSize / (res - 1);
+		int tx = floorf(x / terrain->tileSize);
+		int ty = floorf(y / terrain->tileSize);
+		// held while sampling, the slot can be handed to a worker for another tile
+		pthread_mutex_lock(&streamer->lock);
+		_TerrainTile *tile = _terrain_find(streamer, tx, ty);
+		if(tile != NULL && (tile->state == TILE_READY || tile->state == TILE_UPLOADED)){
+			float u = (x - tx * terrain->tileSize) / spacing;
+			float v = (y - ty * terrain->tileSize) / spacing;
+			int c = min(max(floorf(u), 0), res - 2);
+			int r = min(max(floorf(v), 0), res - 2);
+			float fu = u - c, fv = v - r;
+			int span = res + 2;
+			const float *h = &tile->heights[(r+1)*span + (c+1)];
+			float height = (h[0] * (1-fu) + h[1] * fu) * (1-fv) + (h[span] * (1-fu) + h[span+1] * fu) * fv;
+			pthread_mutex_unlock(&streamer->lock);
+			return height;
+		}
+		pthread_mutex_unlock(&streamer->lock);
+	}
+	return (terrain->height != NULL) ? terrain->height(x, y, terrain->context) : 0.0;
+}
+void freeTerrain(Terrain *terrain){
+	struct _TerrainStreamer *streamer = terrain->streamer;
+	if(streamer == NULL){ return; }
+	pthread_mutex_lock(&streamer->lock);
+	streamer->quit = 1;
+	pthread_cond_broadcast(&streamer->wake);
+	pthread_mutex_unlock(&streamer->lock);
+	for(int i = 0; i < streamer->numWorkers; i++){ pthread_join(streamer->workers[i], NULL); }
+	for(int i = 0; i < streamer->numTiles; i++){
+		_TerrainTile *tile = &streamer->tiles[i];
+		if(tile->mesh != NULL){
+			tile->mesh->buffers[MESH_INDEX] = 0;  // the shared pattern is freed once below
+			freeMesh(tile->mesh);
+		}
+		free(tile->heights);
+		free(tile->positions);
+		free(tile->normals);
+		free(tile->colors);
+	}
+	freeMesh(streamer->indices);
+	pthread_mutex_destroy(&streamer->lock);
+	pthread_cond_destroy(&streamer->wake);
+	free(streamer->workers);
+	free(streamer->queue);
+	free(streamer->tiles);
+	free(streamer);
+	terrain->streamer = NULL;
+	terrain->memoryUsed = 0;
+}
+#endif
+///////////////////////////////////////
+//////////      GRID LOD     //////////
+///////////////////////////////////////
+// geomipmapping: every patch has an index range per level, level l stepping
+// over 2^l vertices. a level's error is the largest height difference between
+// it and the full grid; each frame a patch draws the coarsest level whose error
+// projects to less than pixelError on screen. neighbors at different levels
+// leave cracks along their edges, each patch hangs a skirt there to cover them.
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+typedef struct{
+	const Grid *grid;
+	GridLOD *lod;
+	int patchColumns;
+} _GridLODBuild;
+// the samples a level keeps along one side of a patch, the last one always included
+static int _grid_lod_samples(int first, int quads, int step, int *samples){
+	int n = 0;
+	for(int i = 0; i < quads; i += step){ samples[n++] = first + i; }
+	samples[n++] = first + quads;
+	return n;
+}
+// patch p covers quads [first, first+quads) along one axis
+static void _grid_lod_span(int p, int patchSize, int vertices, int *first, int *quads){
+	*first = p * patchSize;
+	*quads = min(patchSize, vertices - 1 - *first);
+}
+static float _grid_lod_z(const Grid *grid, int c, int r){
+	return grid->positions[(r * grid->columns + c) * 3 + 2];
+}
+// bounds and per level errors, one row of patches at a time
+static void _grid_lod_errors(void *context, int first, int end){
+	_GridLODBuild *build = (_GridLODBuild*)context;
+	const Grid *grid = build->grid;
+	GridLOD *lod = build->lod;
+	int cs[lod->patchSize + 1], rs[lod->patchSize + 1];
+	for(int py = first; py < end; py++){
+		for(int px = 0; px < build->patchColumns; px++){
+			GridPatch *patch = &lod->patches[py * build->patchColumns + px];
+			int c0, nc, r0, nr;
+			_grid_lod_span(px, lod->patchSize, grid->columns, &c0, &nc);
+			_grid_lod_span(py, lod->patchSize, grid->rows, &r0, &nr);
+			for(int j = 0; j < 3; j++){
+				patch->bounds[j] = INFINITY;
+				patch->bounds[3+j] = -INFINITY;
+			}
+			for(int r = r0; r <= r0 + nr; r++){
+				for(int c = c0; c <= c0 + nc; c++){
+					const float *v = &grid->positions[(r * grid->columns + c) * 3];
+					for(int j = 0; j < 3; j++){
+						patch->bounds[j] = min(patch->bounds[j], v[j]);
+						patch->bounds[3+j] = max(patch->bounds[3+j], v[j]);
+					}
+				}
+			}
+			patch->errors[0] = 0;
+			for(int l = 1; l < lod->levels; l++){
+				int step = 1 << l;
+				int ncs = _grid_lod_samples(c0, nc, step, cs);
+				int nrs = _grid_lod_samples(r0, nr, step, rs);
+				float error = patch->errors[l-1];
+				// every full resolution vertex against the coarse triangle over it
+				for(int j = 0; j < nrs - 1; j++){
+					for(int i = 0; i < ncs - 1; i++){
+						float z00 = _grid_lod_z(grid, cs[i], rs[j]), z01 = _grid_lod_z(grid, cs[i+1], rs[j]);
+						float z10 = _grid_lod_z(grid, cs[i], rs[j+1]), z11 = _grid_lod_z(grid, cs[i+1], rs[j+1]);
+						for(int r = rs[j]; r <= rs[j+1]; r++){
+							float v = (float)(r - rs[j]) / (rs[j+1] - rs[j]);
+							for(int c = cs[i]; c <= cs[i+1]; c++){
+								float u = (float)(c - cs[i]) / (cs[i+1] - cs[i]);
+								// the same diagonal as the triangles, see _grid_lod_indices()
+								float z = (u + v <= 1)
+									? z00 + u * (z01 - z00) + v * (z10 - z00)
+									: z11 + (1-u) * (z10 - z11) + (1-v) * (z01 - z11);
+								error = max(error, fabsf(_grid_lod_z(grid, c, r) - z));
+							}
+						}
+					}
+				}
+				patch->errors[l] = error;
+			}
+		}
+	}
+}
+// skirt vertices hang under every vertex on a patch border, first along the
+// border rows, one line per patch row edge, then along the border columns
+static int _grid_lod_line(int vertices, int patchSize, int i){
+	return (i == vertices - 1) ? (vertices - 2) / patchSize + 1 : i / patchSize;
+}
+static uint32_t _grid_lod_row_skirt(const Grid *grid, int patchSize, int c, int r){
+	return grid->columns * grid->rows + _grid_lod_line(grid->rows, patchSize, r) * grid->columns + c;
+}
+static uint32_t _grid_lod_column_skirt(const Grid *grid, int patchSize, int c, int r){
+	int patchRows = _grid_lod_line(grid->rows, patchSize, grid->rows - 1);
+	return grid->columns * grid->rows + (patchRows + 1) * grid->columns + _grid_lod_line(grid->columns, patchSize, c) * grid->rows + r;
+}
+// a level's triangles with the grid's winding, then the skirt around it.
+// returns the number of indices, index can be NULL to only count
+static unsigned int _grid_lod_indices(const Grid *grid, int patchSize, int c0, int nc, int r0, int nr, int step, uint32_t *index){
+	int cs[patchSize + 1], rs[patchSize + 1];
+	int ncs = _grid_lod_samples(c0, nc, step, cs);
+	int nrs = _grid_lod_samples(r0, nr, step, rs);
+	int columns = grid->columns;
+	unsigned int count = ((ncs-1) * (nrs-1) + (ncs-1 + nrs-1) * 2) * 6;
+	if(index == NULL){ return count; }
+	for(int j = 0; j < nrs - 1; j++){
+		for(int i = 0; i < ncs - 1; i++){
+			*index++ = rs[j]*columns + cs[i];
+			*index++ = rs[j+1]*columns + cs[i];
+			*index++ = rs[j]*columns + cs[i+1];
+			*index++ = rs[j+1]*columns + cs[i];
+			*index++ = rs[j+1]*columns + cs[i+1];
+			*index++ = rs[j]*columns + cs[i+1];
+		}
+	}
+	// walk the border all the way around in one direction, so every skirt faces out
+	int border[(patchSize + 1) * 4][2];
+	int n = 0;
+	for(int i = 0; i < ncs - 1; i++){ border[n][0] = cs[i]; border[n++][1] = r0; }
+	for(int j = 0; j < nrs - 1; j++){ border[n][0] = c0 + nc; border[n++][1] = rs[j]; }
+	for(int i = ncs - 1; i > 0; i--){ border[n][0] = cs[i]; border[n++][1] = r0 + nr; }
+	for(int j = nrs - 1; j > 0; j--){ border[n][0] = c0; border[n++][1] = rs[j]; }
+	for(int k = 0; k < n; k++){
+		int *a = border[k], *b = border[(k+1) % n];
+		// the skirt under an edge follows that edge's border line, corners included
+		uint32_t a2, b2;
+		if(a[1] == b[1]){
+			a2 = _grid_lod_row_skirt(grid, patchSize, a[0], a[1]);
+			b2 = _grid_lod_row_skirt(grid, patchSize, b[0], b[1]);
+		} else{
+			a2 = _grid_lod_column_skirt(grid, patchSize, a[0], a[1]);
+			b2 = _grid_lod_column_skirt(grid, patchSize, b[0], b[1]);
+		}
+		*index++ = a[1]*columns + a[0];
+		*index++ = b[1]*columns + b[0];
+		*index++ = a2;
+		*index++ = b[1]*columns + b[0];
+		*index++ = b2;
+		*index++ = a2;
+	}
+	return count;
+}
+GridLOD *buildGridLOD(const Grid *grid, const float *colors, int patchSize){
+	if(grid->positions == NULL || grid->columns < 2 || grid->rows < 2){ return NULL; }
+	GridLOD *lod = (GridLOD*)calloc(1, sizeof(GridLOD));
+	// a power of 2, no larger than the levels allow
+	if(patchSize <= 0){ patchSize = 32; }
+	lod->patchSize = 1;
+	lod->levels = 1;
+	while(lod->patchSize * 2 <= patchSize && lod->levels < GRID_LOD_MAX_LEVELS){
+		lod->patchSize *= 2;
+		lod->levels++;
+	}
+	lod->pixelError = 1.0;
+	int patchColumns = _grid_lod_line(grid->columns, lod->patchSize, grid->columns - 1);
+	int patchRows = _grid_lod_line(grid->rows, lod->patchSize, grid->rows - 1);
+	lod->numPatches = patchColumns * patchRows;
+	lod->patches = (GridPatch*)calloc(lod->numPatches, sizeof(GridPatch));
+	lod->drawCounts = (GLsizei*)malloc(sizeof(GLsizei) * lod->numPatches);
+	lod->drawOffsets = (const void**)malloc(sizeof(void*) * lod->numPatches);
+	_GridLODBuild build = { grid, lod, patchColumns };
+	_parallelRows(patchRows, grid->threads, _grid_lod_errors, &build);
+
+	// skirts reach below the largest difference two neighbors can have
+	float depth = 0;
+	for(int i = 0; i < lod->numPatches; i++){ depth = max(depth, lod->patches[i].errors[lod->levels-1] * 2); }
+	for(int i = 0; i < lod->numPatches; i++){ lod->patches[i].bounds[2] -= depth; }
+	unsigned int numVertices = grid->columns * grid->rows;
+	unsigned int numSkirts = (patchRows + 1) * grid->columns + (patchColumns + 1) * grid->rows;
+	float *skirts = (float*)malloc(sizeof(float) * numSkirts * 3);
+	unsigned int *sources = (unsigned int*)malloc(sizeof(unsigned int) * numSkirts);  // the grid vertex each skirt hangs under
+	for(int k = 0; k <= patchRows; k++){
+		int r = min(k * lod->patchSize, grid->rows - 1);
+		for(int c = 0; c < grid->columns; c++){ sources[k * grid->columns + c] = r * grid->columns + c; }
+	}
+	for(int k = 0; k <= patchColumns; k++){
+		int c = min(k * lod->patchSize, grid->columns - 1);
+		for(int r = 0; r < grid->rows; r++){ sources[(patchRows + 1) * grid->columns + k * grid->rows + r] = r * grid->columns + c; }
+	}
+
+	// every level of every patch, one after the other in one index buffer
+	unsigned int numIndices = 0;
+	for(int i = 0; i < lod->numPatches; i++){
+		int c0, nc, r0, nr;
+		_grid_lod_span(i % patchColumns, lod->patchSize, grid->columns, &c0, &nc);
+		_grid_lod_span(i / patchColumns, lod->patchSize, grid->rows, &r0, &nr);
+		for(int l = 0; l < lod->levels; l++){
+			lod->patches[i].first[l] = numIndices;
+			lod->patches[i].count[l] = _grid_lod_indices(grid, lod->patchSize, c0, nc, r0, nr, 1 << l, NULL);
+			numIndices += lod->patches[i].count[l];
+		}
+	}
+	uint32_t *indices = (uint32_t*)malloc(sizeof(uint32_t) * numIndices);
+	for(int i = 0; i < lod->numPatches; i++){
+		int c0, nc, r0, nr;
+		_grid_lod_span(i % patchColumns, lod->patchSize, grid->columns, &c0, &nc);
+		_grid_lod_span(i / patchColumns, lod->patchSize, grid->rows, &r0, &nr);
+		for(int l = 0; l < lod->levels; l++){
+			_grid_lod_indices(grid, lod->patchSize, c0, nc, r0, nr, 1 << l, &indices[lod->patches[i].first[l]]);
+		}
+	}
+
+	// the grid's arrays are sent as they are, the skirts copy their vertex lowered
+	lod->mesh = createMesh(GL_TRIANGLES, numVertices + numSkirts, numIndices);
+	const float *attributes[3] = { grid->positions, grid->normals, colors };
+	for(int a = MESH_POSITION; a <= MESH_COLOR; a++){
+		if(attributes[a] == NULL){ continue; }
+		for(unsigned int i = 0; i < numSkirts; i++){ memcpy(&skirts[i*3], &attributes[a][sources[i]*3], sizeof(float) * 3); }
+		if(a == MESH_POSITION){
+			for(unsigned int i = 0; i < numSkirts; i++){ skirts[i*3+2] -= depth; }
+		}
+		setMeshAttribute(lod->mesh, a, 3, NULL);
+		updateMesh(lod->mesh, a, 0, numVertices, attributes[a]);
+		updateMesh(lod->mesh, a, numVertices, numSkirts, skirts);
+	}
+	setMeshAttribute(lod->mesh, MESH_INDEX, 1, indices);
+	lod->mesh->data[MESH_INDEX] = NULL;
+	free(indices);
+	free(skirts);
+	free(sources);
+	return lod;
+}
+void drawGridLOD(GridLOD *lod){
+	if(lod == NULL){ return; }
+	float modelview[16], projection[16], clip[16], camera[3];
+	glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+	glGetFloatv(GL_PROJECTION_MATRIX, projection);
+	mat4x4MultUnique(modelview, projection, clip);  // column-major projection * modelview
+	unsigned char orthographic = !_view_eye(clip, camera);
+	// pixels per unit of height error, at a distance of 1 (or anywhere in orthographic)
+	float pixels = orthographic ? HEIGHT * 0.5 * projection[5] : _view_pixels();
+	// the view frustum's planes, from the rows of the clip matrix
+	float planes[6][4];
+	for(int p = 0; p < 6; p++){
+		int row = p / 2;
+		float sign = (p % 2) ? -1 : 1;
+		for(int j = 0; j < 4; j++){ planes[p][j] = clip[j*4+3] + sign * clip[j*4+row]; }
+	}
+	int draws = 0;
+	lod->patchesDrawn = 0;
+	lod->trianglesDrawn = 0;
+	for(int i = 0; i < lod->numPatches; i++){
+		GridPatch *patch = &lod->patches[i];
+		const float *b = patch->bounds;
+		unsigned char visible = 1;
+		for(int p = 0; p < 6 && visible; p++){
+			// the box corner farthest along the plane's normal
+			float d = planes[p][3];
+			for(int j = 0; j < 3; j++){ d += planes[p][j] * ((planes[p][j] > 0) ? b[3+j] : b[j]); }
+			if(d < 0){ visible = 0; }
+		}
+		if(!visible){ continue; }
+		float distance = 1;
+		if(!orthographic){
+			float d2 = 0;
+			for(int j = 0; j < 3; j++){
+				float d = max(max(b[j] - camera[j], camera[j] - b[3+j]), 0);
+				d2 += d*d;
+			}
+			distance = max(sqrtf(d2), 1e-4);
+		}
+		int level = lod->levels - 1;
+		while(level > 0 && patch->errors[level] * pixels > lod->pixelError * distance){ level--; }
+		lod->drawCounts[draws] = patch->count[level];
+		lod->drawOffsets[draws] = (const void*)(size_t)(sizeof(uint32_t) * patch->first[level]);
+		lod->trianglesDrawn += patch->count[level] / 3;
+		draws++;
+	}
+	lod->patchesDrawn = draws;
+	if(draws == 0){ return; }
+	_mesh_bind(lod->mesh);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod->mesh->buffers[MESH_INDEX]);
+	glMultiDrawElements(GL_TRIANGLES, lod->drawCounts, GL_UNSIGNED_INT, lod->drawOffsets, draws);
+	_state_count_draw(lod->trianglesDrawn * 3);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	_mesh_unbind();
+}
+void freeGridLOD(GridLOD *lod){
+	if(lod == NULL){ return; }
+	freeMesh(lod->mesh);
+	free(lod->patches);
+	free(lod->drawCounts);
+	free(lod->drawOffsets);
+	free(lod);
+}
+#endif
+///////////////////////////////////////
+//////////     HEIGHTMAPS    //////////
+///////////////////////////////////////
+// only the heights live on the GPU: 4 bytes a vertex instead of a position,
+// normal and color. one small flat patch is drawn across the map, the vertex
+// shader moves it into place with u_patch, reads its height from the texture,
+// and derives the normal from the neighboring texels (examples/shaders/heightmap.vert)
+#if defined(__glew_h__) || defined(GL_VERSION_2_0)
+#define HEIGHTMAP_PATCH 64
+#ifdef GL_R32F
+#  define HEIGHTMAP_INTERNAL_FORMAT GL_R32F
+#  define HEIGHTMAP_FORMAT GL_RED
+#else
+#  define HEIGHTMAP_INTERNAL_FORMAT GL_LUMINANCE32F_ARB
+#  define HEIGHTMAP_FORMAT GL_LUMINANCE
+#endif
+Heightmap *createHeightmap(int columns, int rows, float spacing, const float *heights){
+	if(columns < 2 || rows < 2){ return NULL; }
+	Heightmap *map = (Heightmap*)calloc(1, sizeof(Heightmap));
+	map->columns = columns;
+	map->rows = rows;
+	map->spacing = spacing;
+	map->patchSize = min(HEIGHTMAP_PATCH, max(columns, rows) - 1);
+	glGenTextures(1, &map->texture);
+	glBindTexture(GL_TEXTURE_2D, map->texture);
+	// the shader reads texel centers, nothing is filtered
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexImage2D(GL_TEXTURE_2D, 0, HEIGHTMAP_INTERNAL_FORMAT, columns, rows, 0, HEIGHTMAP_FORMAT, GL_FLOAT, heights);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	// the patch's vertices are texel offsets, the indices come from a flat grid
+	int side = map->patchSize + 1;
+	float *offsets = (float*)malloc(sizeof(float) * side * side * 2);
+	for(int r = 0; r < side; r++){
+		for(int c = 0; c < side; c++){
+			offsets[(r*side+c)*2+0] = c;
+			offsets[(r*side+c)*2+1] = r;
+		}
+	}
+	Grid flat = {0};
+	flat.columns = flat.rows = side;
+	flat.threads = 1;
+	buildGrid(&flat);
+	map->patch = createMesh(GL_TRIANGLES, side * side, flat.numIndices);
+	setMeshAttribute(map->patch, MESH_POSITION, 2, offsets);
+	setMeshAttribute(map->patch, MESH_INDEX, 1, flat.indices);
+	map->patch->data[MESH_POSITION] = map->patch->data[MESH_INDEX] = NULL;
+	map->memoryUsed = sizeof(float) * (columns * rows + side * side * 2) + sizeof(uint32_t) * flat.numIndices;
+	freeGrid(&flat);
+	free(offsets);
+	return map;
+}
+// only the rectangle is sent, read straight out of the full array
+void updateHeightmap(Heightmap *map, int x, int y, int width, int height, const float *heights){
+	if(map == NULL){ return; }
+	if(x < 0){ width += x;  x = 0; }
+	if(y < 0){ height += y;  y = 0; }
+	width = min(width, map->columns - x);
+	height = min(height, map->rows - y);
+	if(width <= 0 || height <= 0){ return; }
+	glBindTexture(GL_TEXTURE_2D, map->texture);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, map->columns);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, HEIGHTMAP_FORMAT, GL_FLOAT, &heights[y * map->columns + x]);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+void drawHeightmap(Heightmap *map, GLuint shader){
+	if(map == NULL || !shader){ return; }
+	glUseProgram(shader);
+	glUniform1i(glGetUniformLocation(shader, "u_heightmap"), 0);
+	glUniform2f(glGetUniformLocation(shader, "u_size"), map->columns, map->rows);
+	glUniform1f(glGetUniformLocation(shader, "u_spacing"), map->spacing);
+	GLint patch = glGetUniformLocation(shader, "u_patch");
+	glBindTexture(GL_TEXTURE_2D, map->texture);
+	_mesh_bind(map->patch);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, map->patch->buffers[MESH_INDEX]);
+	// patches past the last row or column are folded onto it by the shader
+	for(int y = 0; y < map->rows - 1; y += map->patchSize){
+		for(int x = 0; x < map->columns - 1; x += map->patchSize){
+			glUniform2f(patch, x, y);
+			glDrawElements(GL_TRIANGLES, map->patch->numIndices, GL_UNSIGNED_INT, 0);
+		}
+	}
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	_mesh_unbind();
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+}
+void freeHeightmap(Heightmap *map){
+	if(map == NULL){ return; }
+	glDeleteTextures(1, &map->texture);
+	freeMesh(map->patch);
+	free(map);
+}
+#endif
+///////////////////////////////////////
+//////////     PARTICLES     //////////
+///////////////////////////////////////
+// structure of arrays: each step streams through whole arrays of one component,
+// 4 particles per SSE instruction, in pieces spread over the worker pool. dead particles are squeezed out in order
+// after the step. drawing writes the positions interleaved straight into a
+// mapped buffer, and a single glDrawArrays() draws every sprite
+Particles *createParticles(int capacity){
+	Particles *particles = (Particles*)calloc(1, sizeof(Particles));
+	particles->capacity = max(capacity, 1);
+	for(int a = 0; a < 3; a++){
+		particles->position[a] = (float*)malloc(sizeof(float) * particles->capacity);
+		particles->velocity[a] = (float*)malloc(sizeof(float) * particles->capacity);
+	}
+	particles->life = (float*)malloc(sizeof(float) * particles->capacity);
+	particles->color = (unsigned char*)malloc(4 * particles->capacity);
+	particles->size = 0.1;
+	return particles;
+}
+int emitParticle(Particles *particles, const float position[3], const float velocity[3], float life, const float color[4]){
+	if(particles->count >= particles->capacity){ return -1; }
+	int i = particles->count++;
+	for(int a = 0; a < 3; a++){
+		particles->position[a][i] = position[a];
+		particles->velocity[a][i] = (velocity != NULL) ? velocity[a] : 0.0;
+	}
+	particles->life[i] = (life > 0) ? life : INFINITY;
+	for(int c = 0; c < 4; c++){
+		float value = (color != NULL) ? color[c] : 1.0;
+		particles->color[i*4+c] = min(max(value, 0), 1) * 255;
+	}
+	return i;
+}
+void killParticle(Particles *particles, int index){
+	if(index >= 0 && index < particles->count){ particles->life[index] = 0; }
+}
+// keep the living in order, every array moves together
+static void _particles_compact(Particles *particles){
+	int alive = 0;
+	for(int i = 0; i < particles->count; i++){
+		if(!(particles->life[i] > 0)){ continue; }
+		if(alive != i){
+			for(int a = 0; a < 3; a++){
+				particles->position[a][alive] = particles->position[a][i];
+				particles->velocity[a][alive] = particles->velocity[a][i];
+			}
+			particles->life[alive] = particles->life[i];
+			memcpy(&particles->color[alive*4], &particles->color[i*4], 4);
+		}
+		alive++;
+	}
+	particles->count = alive;
+}
+typedef struct{
+	Particles *particles;
+	float dt;
+	unsigned char wrap[3];
+	float extent[3];
+	int dead;  // atomic
+} _ParticleStep;
+static void _particles_step(void *context, int first, int end){
+	_ParticleStep *step = (_ParticleStep*)context;
+	Particles *particles = step->particles;
+	float dt = step->dt;
+	int dead = 0;
+	int i = first;
+#ifdef __SSE2__
+	__m128 dt4 = _mm_set1_ps(dt);
+	__m128 zero = _mm_setzero_ps();
+	for(; i + 4 <= end; i += 4){
+		__m128 life = _mm_sub_ps(_mm_loadu_ps(&particles->life[i]), dt4);
+		_mm_storeu_ps(&particles->life[i], life);
+		int expired = _mm_movemask_ps(_mm_cmple_ps(life, zero));
+		dead += (expired & 1) + (expired >> 1 & 1) + (expired >> 2 & 1) + (expired >> 3 & 1);
+		for(int a = 0; a < 3; a++){
+			__m128 v = _mm_add_ps(_mm_loadu_ps(&particles->velocity[a][i]), _mm_set1_ps(particles->acceleration[a] * dt));
+			__m128 x = _mm_add_ps(_mm_loadu_ps(&particles->position[a][i]), _mm_mul_ps(v, dt4));
+			if(step->wrap[a]){
+				// one extent back inside, selected by the comparison masks
+				__m128 size = _mm_set1_ps(step->extent[a]);
+				x = _mm_add_ps(x, _mm_and_ps(_mm_cmplt_ps(x, _mm_set1_ps(particles->boundsMin[a])), size));
+				x = _mm_sub_ps(x, _mm_and_ps(_mm_cmpge_ps(x, _mm_set1_ps(particles->boundsMax[a])), size));
+			}
+			_mm_storeu_ps(&particles->velocity[a][i], v);
+			_mm_storeu_ps(&particles->position[a][i], x);
+		}
+	}
+#endif
+	// the remainder, or everything without SSE
+	for(; i < end; i++){
+		particles->life[i] -= dt;
+		if(particles->life[i] <= 0){ dead++; }
+		for(int a = 0; a < 3; a++){
+			float v = particles->velocity[a][i] + particles->acceleration[a] * dt;
+			float x = particles->position[a][i] + v * dt;
+			if(step->wrap[a]){
+				if(x < particles->boundsMin[a]){ x += step->extent[a]; }
+				if(x >= particles->boundsMax[a]){ x -= step->extent[a]; }
+			}
+			particles->velocity[a][i] = v;
+			particles->position[a][i] = x;
+		}
+	}
+	if(dead){ __atomic_add_fetch(&step->dead, dead, __ATOMIC_RELAXED); }
+}
+void updateParticles(Particles *particles, float dt){
+	_ParticleStep step = { particles, dt };
+	for(int a = 0; a < 3; a++){
+		step.extent[a] = particles->boundsMax[a] - particles->boundsMin[a];
+		step.wrap[a] = step.extent[a] > 0;
+	}
+	// pieces of a few pages of every array, spread across the worker pool
+	parallelFor(0, particles->count, 16384, _particles_step, &step);
+	if(step.dead){ _particles_compact(particles); }
+}
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+// X, Y and Z arrays into XYZ triples. 4 particles are transposed into 4 overlapping
+// stores of 4 floats, each one's fourth float is overwritten by the next
+static void _particles_interleave(Particles *particles, float *out){
+	int i = 0;
+	const float *x = particles->position[0], *y = particles->position[1], *z = particles->position[2];
+#ifdef __SSE2__
+	for(; i + 4 <= particles->count; i += 4){
+		__m128 r0 = _mm_loadu_ps(&x[i]), r1 = _mm_loadu_ps(&y[i]), r2 = _mm_loadu_ps(&z[i]), r3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(&out[i*3+0], r0);
+		_mm_storeu_ps(&out[i*3+3], r1);
+		_mm_storeu_ps(&out[i*3+6], r2);
+		_mm_storeu_ps(&out[i*3+9], r3);
+	}
+#endif
+	for(; i < particles->count; i++){
+		out[i*3+0] = x[i];
+		out[i*3+1] = y[i];
+		out[i*3+2] = z[i];
+	}
+}
+void drawParticles(Particles *particles){
+	if(particles->count == 0){ return; }
+	// one float of room past the positions for the last overlapping store
+	size_t positionBytes = sizeof(float) * (particles->capacity * 3 + 1);
+	if(!particles->buffer){ glGenBuffers(1, &particles->buffer); }
+	glBindBuffer(GL_ARRAY_BUFFER, particles->buffer);
+	// a new store every frame, the driver doesn't wait on the last frame's draw
+	glBufferData(GL_ARRAY_BUFFER, positionBytes + 4 * particles->capacity, NULL, GL_STREAM_DRAW);
+	float *mapped = (float*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+	if(mapped == NULL){
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		return;
+	}
+	_particles_interleave(particles, mapped);
+	memcpy((char*)mapped + positionBytes, particles->color, 4 * particles->count);
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+
+	glPushAttrib(GL_POINT_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT);
+	glDisable(GL_LIGHTING);
+	// size in pixels is size * pixels per unit at distance 1 / distance
+	float projection[16];
+	glGetFloatv(GL_PROJECTION_MATRIX, projection);
+	unsigned char orthographic = _view_orthographic(projection);
+	if(orthographic){ glPointSize(particles->size * HEIGHT * 0.5 * projection[5]); }
+	else{
+		// GL takes the distance in eye space, but the perspectives keep the camera in
+		// the projection. for this draw it moves to the modelview, the lens stays
+		float modelview[16], lens[16], inverse[16], camera[16], eye[16];
+		glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+		glMatrixMode(GL_PROJECTION);
+		glPushMatrix();
+		glLoadIdentity();
+		_view_frustum();
+		glGetFloatv(GL_PROJECTION_MATRIX, lens);
+		mat4Inverse(lens, inverse);
+		mat4x4MultUnique(projection, inverse, camera);  // inverse * projection
+		mat4x4MultUnique(modelview, camera, eye);
+		glMatrixMode(GL_MODELVIEW);
+		glPushMatrix();
+		glLoadMatrixf(eye);
+		float pixels = _view_pixels();
+		float attenuation[3] = { 0.0, 0.0, 1.0 / (pixels * pixels) };
+		glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION, attenuation);
+		glPointSize(particles->size);
+	}
+#ifdef GL_POINT_SPRITE
+	glEnable(GL_POINT_SPRITE);
+	glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_TRUE);
+#endif
+	_state_arrays(_STATE_VERTEX | _STATE_COLOR);
+	glVertexPointer(3, GL_FLOAT, 0, 0);
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, (const void*)positionBytes);
+	glDrawArrays(GL_POINTS, 0, particles->count);
+	_state_arrays_done();
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if(!orthographic){
+		glPopMatrix();
+		glMatrixMode(GL_PROJECTION);
+		glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+	}
+	glPopAttrib();
+}
+#endif
+void freeParticles(Particles *particles){
+	if(particles == NULL){ return; }
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+	if(particles->buffer){ glDeleteBuffers(1, &particles->buffer); }
+#endif
+	for(int a = 0; a < 3; a++){
+		free(particles->position[a]);
+		free(particles->velocity[a]);
+	}
+	free(particles->life);
+	free(particles->color);
+	free(particles);
+}
+///////////////////////////////////////
+//////////       STARS       //////////
+///////////////////////////////////////
+// the file is already in the order and layout the buffer wants: it's mapped and
+// handed to the driver in one call. the magnitudes are read once, into a table of
+// how many stars come before each tenth of a magnitude. drawing is a few ranges
+// of that one buffer, a point size each, ending at the limiting magnitude
+#define STAR_MAGIC "WORLDSTR"
+static int _star_compare(const void *a, const void *b){
+	float ma = ((const StarRecord*)a)->magnitude, mb = ((const StarRecord*)b)->magnitude;
+	return (ma > mb) - (ma < mb);
+}
+// a blackbody's color, temperature from B-V (Ballesteros) and RGB fit by Tanner Helland
+static void _star_color(float colorIndex, float magnitude, unsigned char color[4]){
+	float t = 46.0 * (1.0 / (0.92 * colorIndex + 1.7) + 1.0 / (0.92 * colorIndex + 0.62));  // kelvin / 100
+	float rgb[3];
+	rgb[0] = (t <= 66) ? 255 : 329.698727446 * powf(t - 60, -0.1332047592);
+	rgb[1] = (t <= 66) ? 99.4708025861 * logf(t) - 161.1195681661 : 288.1221695283 * powf(t - 60, -0.0755148492);
+	rgb[2] = (t >= 66) ? 255 : (t <= 19) ? 0 : 138.5177312231 * logf(t - 10) - 305.0447927307;
+	for(int i = 0; i < 3; i++){ color[i] = (unsigned char)min(max(rgb[i], 0), 255); }
+	// past magnitude 3 the points are the smallest they get, they fade instead
+	color[3] = (unsigned char)(255 * min(max(powf(10, -0.2 * (magnitude - 3)), 0.15), 1.0));
+}
+int saveStarCatalog(const char *filename, const float *positions, const float *magnitudes, const float *colorIndices, int count){
+	if(count < 0){ return 0; }
+	StarRecord *records = (StarRecord*)malloc(sizeof(StarRecord) * max(count, 1));
+	if(records == NULL){ return 0; }
+	for(int i = 0; i < count; i++){
+		memcpy(records[i].position, &positions[i*3], sizeof(float) * 3);
+		records[i].magnitude = magnitudes[i];
+		records[i].colorIndex = colorIndices ? colorIndices[i] : 0.4;
+		_star_color(records[i].colorIndex, records[i].magnitude, records[i].color);
+	}
+	qsort(records, count, sizeof(StarRecord), _star_compare);
+	FILE *file = fopen(filename, "wb");
+	int written = 0;
+	if(file){
+		uint32_t header[2] = { (uint32_t)count, sizeof(StarRecord) };
+		written = fwrite(STAR_MAGIC, 1, 8, file) == 8 && fwrite(header, sizeof(uint32_t), 2, file) == 2 && fwrite(records, sizeof(StarRecord), count, file) == (size_t)count;
+		if(fclose(file) != 0){ written = 0; }
+	}
+	free(records);
+	return written;
+}
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+StarCatalog *loadStarCatalog(const char *filename){
+	int fd = open(filename, O_RDONLY);
+	if(fd < 0){ return NULL; }
+	struct stat info;
+	if(fstat(fd, &info) != 0 || info.st_size < 16){
+		close(fd);
+		return NULL;
+	}
+	void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED){ return NULL; }
+	uint32_t header[2];
+	memcpy(header, (char*)map + 8, sizeof(header));
+	if(memcmp(map, STAR_MAGIC, 8) != 0 || header[1] != sizeof(StarRecord) || (off_t)(16 + (size_t)header[0] * sizeof(StarRecord)) > info.st_size){
+		munmap(map, info.st_size);
+		return NULL;
+	}
+	StarCatalog *catalog = (StarCatalog*)calloc(1, sizeof(StarCatalog));
+	catalog->count = header[0];
+	catalog->size = 6.0;
+	const StarRecord *records = (const StarRecord*)((char*)map + 16);
+	// files written by something else might not be in order
+	StarRecord *sorted = NULL;
+	for(int i = 1; i < catalog->count; i++){
+		if(records[i].magnitude < records[i-1].magnitude){
+			sorted = (StarRecord*)malloc(sizeof(StarRecord) * catalog->count);
+			memcpy(sorted, records, sizeof(StarRecord) * catalog->count);
+			qsort(sorted, catalog->count, sizeof(StarRecord), _star_compare);
+			records = sorted;
+			break;
+		}
+	}
+	if(catalog->count){
+		catalog->brightest = records[0].magnitude;
+		catalog->dimmest = records[catalog->count - 1].magnitude;
+	}
+	catalog->limitingMagnitude = catalog->dimmest;
+	catalog->magnitudes = (float*)malloc(sizeof(float) * max(catalog->count, 1));
+	for(int i = 0; i < catalog->count; i++){ catalog->magnitudes[i] = records[i].magnitude; }
+	for(int i = 0, star = 0; i < STAR_MAGNITUDE_STEPS; i++){
+		float step = -2.0 + (i + 1) * 0.1;
+		while(star < catalog->count && records[star].magnitude < step){ star++; }
+		catalog->brighter[i] = star;
+	}
+	glGenBuffers(1, &catalog->buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, catalog->buffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(StarRecord) * catalog->count, records, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	free(sorted);
+	munmap(map, info.st_size);
+	return catalog;
+}
+// how many stars are no dimmer than the magnitude. the table narrows it to a few
+// tenths (one more either way for rounding), a binary search of the magnitudes finishes it
+static int _star_index(const StarCatalog *catalog, float magnitude){
+	int step = (int)floorf((magnitude + 2.0) * 10.0);
+	int low = 0, high = catalog->count;
+	if(step - 2 >= STAR_MAGNITUDE_STEPS){ low = catalog->brighter[STAR_MAGNITUDE_STEPS - 1]; }
+	else if(step >= 2){ low = catalog->brighter[step - 2]; }
+	if(step + 1 < 0){ high = catalog->brighter[0]; }
+	else if(step + 1 < STAR_MAGNITUDE_STEPS){ high = catalog->brighter[step + 1]; }
+	while(low < high){
+		int middle = (low + high) / 2;
+		if(catalog->magnitudes[middle] <= magnitude){ low = middle + 1; }
+		else{ high = middle; }
+	}
+	return low;
+}
+void drawStarCatalog(const StarCatalog *catalog){
+	if(catalog == NULL){ return; }
+	int end = _star_index(catalog, catalog->limitingMagnitude);
+	if(end == 0){ return; }
+	glPushAttrib(GL_POINT_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT);
+	glDisable(GL_LIGHTING);
+#ifdef GL_POINT_SPRITE
+	glEnable(GL_POINT_SPRITE);
+	glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_TRUE);
+#endif
+	glBindBuffer(GL_ARRAY_BUFFER, catalog->buffer);
+	_state_arrays(_STATE_VERTEX | _STATE_COLOR);
+	glVertexPointer(3, GL_FLOAT, sizeof(StarRecord), (const void*)offsetof(StarRecord, position));
+	glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(StarRecord), (const void*)offsetof(StarRecord, color));
+	// one range per whole magnitude
+	int first = 0;
+	for(float magnitude = floorf(catalog->brightest) + 1; first < end; magnitude += 1){
+		int last = _star_index(catalog, magnitude);
+		if(last > end){ last = end; }
+		if(last > first){
+			glPointSize(max(catalog->size * powf(10, -0.2 * (magnitude - 0.5)), 1.0));
+			glDrawArrays(GL_POINTS, first, last - first);
+		}
+		first = last;
+	}
+	_state_arrays_done();
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glPopAttrib();
+}
+#endif
+void freeStarCatalog(StarCatalog *catalog){
+	if(catalog == NULL){ return; }
+#if defined(__glew_h__) || defined(GL_VERSION_1_5)
+	if(catalog->buffer){ glDeleteBuffers(1, &catalog->buffer); }
+#endif
+	free(catalog->magnitudes);
+	free(catalog);
+}
+#undef STAR_MAGIC
+///////////////////////////////////////
+//////////        JOBS       //////////
+///////////////////////////////////////
+// every thread owns a queue of jobs: it pushes and pops at the bottom, and
+// when its own runs dry it steals from the top of another, taking the oldest
+// and largest piece of a split range. parallelFor() halves its range until a
+// piece is under the grain, pushing one half and keeping the other. a thread
+// waiting on a job runs other jobs meanwhile, so nesting can't deadlock.
+// tasks come from a pool that waitTasks() recycles each frame
+#define JOB_QUEUE 1024  // a power of 2
+#define TASK_BLOCK 64
+enum{ JOB_RANGE, JOB_TASK };
+typedef struct _TaskLink{
+	Task *task;
+	struct _TaskLink *next;
+} _TaskLink;
+struct _Task{
+	int kind;
+	int done;  // atomic
+	// JOB_RANGE
+	void (*body)(void *context, int first, int end);
+	int first, end, grain;
+	// JOB_TASK
+	void (*task)(void *context);
+	void *context;
+	int waiting;  // unfinished dependencies, atomic
+	_TaskLink *dependents;  // guarded by _jobs.lock
+	_TaskLink links[TASK_MAX_DEPENDENCIES];  // this task's place in its dependencies' lists
+};
+typedef struct{
+	pthread_mutex_t lock;
+	Task *jobs[JOB_QUEUE];
+	unsigned int top, bottom;
+} _JobQueue;
+static struct{
+	int numQueues;  // the main thread's is 0
+	_JobQueue *queues;
+	int queued;  // atomic, workers sleep while it's 0
+	int outstanding;  // atomic, tasks not yet done
+	pthread_mutex_t lock;  // sleeping, dependencies and the task pool
+	pthread_cond_t wake;
+	int sleeping;
+	Task **blocks;
+	int numBlocks, used;
+} _jobs;
+static pthread_once_t _jobs_once = PTHREAD_ONCE_INIT;
+static __thread int _job_queue = 0;
+static int _jobs_push(Task *job){
+	_JobQueue *queue = &_jobs.queues[_job_queue];
+	pthread_mutex_lock(&queue->lock);
+	if(queue->bottom - queue->top >= JOB_QUEUE){
+		pthread_mutex_unlock(&queue->lock);
+		return 0;
+	}
+	queue->jobs[queue->bottom++ % JOB_QUEUE] = job;
+	pthread_mutex_unlock(&queue->lock);
+	__atomic_add_fetch(&_jobs.queued, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_lock(&_jobs.lock);
+	if(_jobs.sleeping){ pthread_cond_signal(&_jobs.wake); }
+	pthread_mutex_unlock(&_jobs.lock);
+	return 1;
+}
+// the newest of our own jobs, or the oldest of someone else's
+static Task *_jobs_find(){
+	for(int i = 0; i < _jobs.numQueues; i++){
+		_JobQueue *queue = &_jobs.queues[(_job_queue + i) % _jobs.numQueues];
+		Task *job = NULL;
+		pthread_mutex_lock(&queue->lock);
+		if(queue->bottom != queue->top){
+			job = (i == 0) ? queue->jobs[--queue->bottom % JOB_QUEUE] : queue->jobs[queue->top++ % JOB_QUEUE];
+		}
+		pthread_mutex_unlock(&queue->lock);
+		if(job != NULL){
+			__atomic_sub_fetch(&_jobs.queued, 1, __ATOMIC_SEQ_CST);
+			return job;
+		}
+	}
+	return NULL;
+}
+static void _jobs_run(Task *job);
+static void _jobs_wait(int *done){
+	while(!__atomic_load_n(done, __ATOMIC_ACQUIRE)){
+		Task *job = _jobs_find();
+		if(job != NULL){ _jobs_run(job); }
+		else{ sched_yield(); }
+	}
+}
+static void _jobs_range(void (*body)(void *context, int first, int end), void *context, int first, int end, int grain){
+	while(end - first > grain){
+		// the half on the queue lives on this stack until it's done
+		Task half;
+		half.kind = JOB_RANGE;
+		half.done = 0;
+		half.body = body;
+		half.context = context;
+		half.first = first + (end - first) / 2;
+		half.end = end;
+		half.grain = grain;
+		if(!_jobs_push(&half)){ break; }
+		_jobs_range(body, context, first, half.first, grain);
+		_jobs_wait(&half.done);
+		return;
+	}
+	body(context, first, end);
+}
+static void _jobs_schedule(Task *task){
+	if(!_jobs_push(task)){ _jobs_run(task); }
+}
+static void _jobs_run(Task *job){
+	if(job->kind == JOB_RANGE){
+		_jobs_range(job->body, job->context, job->first, job->end, job->grain);
+		__atomic_store_n(&job->done, 1, __ATOMIC_RELEASE);
+		return;
+	}
+	job->task(job->context);
+	pthread_mutex_lock(&_jobs.lock);
+	__atomic_store_n(&job->done, 1, __ATOMIC_RELEASE);
+	_TaskLink *dependents = job->dependents;
+	pthread_mutex_unlock(&_jobs.lock);
+	for(_TaskLink *link = dependents; link != NULL; link = link->next){
+		if(__atomic_sub_fetch(&link->task->waiting, 1, __ATOMIC_ACQ_REL) == 0){ _jobs_schedule(link->task); }
+	}
+	__atomic_sub_fetch(&_jobs.outstanding, 1, __ATOMIC_ACQ_REL);
+}
+static void *_jobs_worker(void *queue){
+	_job_queue = (int)(intptr_t)queue;
+	while(1){
+		Task *job = _jobs_find();
+		if(job != NULL){
+			_jobs_run(job);
+			continue;
+		}
+		pthread_mutex_lock(&_jobs.lock);
+		while(__atomic_load_n(&_jobs.queued, __ATOMIC_SEQ_CST) == 0){
+			_jobs.sleeping++;
+			pthread_cond_wait(&_jobs.wake, &_jobs.lock);
+			_jobs.sleeping--;
+		}
+		pthread_mutex_unlock(&_jobs.lock);
+	}
+	return NULL;
+}
+static void _jobs_create(int threads){
+	if(_jobs.numQueues){ return; }
+	pthread_mutex_init(&_jobs.lock, NULL);
+	pthread_cond_init(&_jobs.wake, NULL);
+	_jobs.queues = (_JobQueue*)calloc(max(threads, 1), sizeof(_JobQueue));
+	for(int i = 0; i < max(threads, 1); i++){ pthread_mutex_init(&_jobs.queues[i].lock, NULL); }
+	_jobs.numQueues = max(threads, 1);
+	// the main thread is one of them
+	for(int i = 1; i < _jobs.numQueues; i++){
+		pthread_t thread;
+		if(pthread_create(&thread, NULL, _jobs_worker, (void*)(intptr_t)i) != 0){
+			// fewer workers, down to the main thread alone
+			__atomic_store_n(&_jobs.numQueues, i, __ATOMIC_RELEASE);
+			break;
+		}
+		pthread_detach(thread);
+	}
+}
+static void _jobs_start(){ _jobs_create(_cpu_count()); }
+int workerCount(){
+	pthread_once(&_jobs_once, _jobs_start);
+	return _jobs.numQueues;
+}
+void parallelFor(int first, int end, int grain, void (*body)(void *context, int first, int end), void *context){
+	if(end <= first){ return; }
+	int workers = workerCount();
+	// a few pieces per thread leaves room to balance uneven work
+	if(grain <= 0){ grain = max((end - first) / (workers * 8), 1); }
+	if(workers == 1 || end - first <= grain){
+		body(context, first, end);
+		return;
+	}
+	_jobs_range(body, context, first, end, grain);
+}
+Task *submitTask(void (*task)(void *context), void *context, Task **dependencies, int numDependencies){
+	workerCount();
+	__atomic_add_fetch(&_jobs.outstanding, 1, __ATOMIC_ACQ_REL);
+	pthread_mutex_lock(&_jobs.lock);
+	if(_jobs.used == _jobs.numBlocks * TASK_BLOCK){
+		_jobs.blocks = (Task**)realloc(_jobs.blocks, sizeof(Task*) * (_jobs.numBlocks + 1));
+		_jobs.blocks[_jobs.numBlocks++] = (Task*)malloc(sizeof(Task) * TASK_BLOCK);
+	}
+	Task *t = &_jobs.blocks[_jobs.used / TASK_BLOCK][_jobs.used % TASK_BLOCK];
+	_jobs.used++;
+	memset(t, 0, sizeof(Task));
+	t->kind = JOB_TASK;
+	t->task = task;
+	t->context = context;
+	t->waiting = 1;  // held until every dependency is linked
+	for(int i = 0; i < numDependencies && i < TASK_MAX_DEPENDENCIES; i++){
+		if(dependencies[i] == NULL || dependencies[i]->done){ continue; }
+		t->waiting++;
+		t->links[i].task = t;
+		t->links[i].next = dependencies[i]->dependents;
+		dependencies[i]->dependents = &t->links[i];
+	}
+	pthread_mutex_unlock(&_jobs.lock);
+	// past the limit, the submitting thread waits for the rest itself
+	for(int i = TASK_MAX_DEPENDENCIES; i < numDependencies; i++){
+		if(dependencies[i] != NULL){ waitTask(dependencies[i]); }
+	}
+	if(__atomic_sub_fetch(&t->waiting, 1, __ATOMIC_ACQ_REL) == 0){ _jobs_schedule(t); }
+	return t;
+}
+void waitTask(Task *task){
+	if(task != NULL){ _jobs_wait(&task->done); }
+}
+void waitTasks(){
+	if(!_jobs.numQueues){ return; }
+	while(__atomic_load_n(&_jobs.outstanding, __ATOMIC_ACQUIRE) > 0){
+		Task *job = _jobs_find();
+		if(job != NULL){ _jobs_run(job); }
+		else{ sched_yield(); }
+	}
+	pthread_mutex_lock(&_jobs.lock);
+	_jobs.used = 0;
+	pthread_mutex_unlock(&_jobs.lock);
+}
+///////////////////////////////////////
+//////////      PIPELINE     //////////
+///////////////////////////////////////
+// updateWorld() copies the state, hands update() to the simulation thread and
+// returns, and display() draws the copy. the next updateWorld() waits for that
+// update() first, so a frame costs the slower of the two instead of both.
+// tasks from update() are finished on the simulation thread
+static struct{
+	void *state, *snapshot;
+	size_t size;
+	int running;  // the last update() went to the thread. main thread only
+	int started;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t done;
+	unsigned long requested, completed;  // guarded by lock
+} _pipeline = { NULL, NULL, 0, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0 };
+static void *_pipeline_thread(void *arg){
+	pthread_mutex_lock(&_pipeline.lock);
+	while(1){
+		while(_pipeline.completed == _pipeline.requested){ pthread_cond_wait(&_pipeline.done, &_pipeline.lock); }
+		pthread_mutex_unlock(&_pipeline.lock);
+		update();
+		waitTasks();
+		pthread_mutex_lock(&_pipeline.lock);
+		_pipeline.completed++;
+		pthread_cond_broadcast(&_pipeline.done);
+	}
+	return NULL;
+}
+static void _pipeline_wait(){
+	pthread_mutex_lock(&_pipeline.lock);
+	while(_pipeline.completed != _pipeline.requested){ pthread_cond_wait(&_pipeline.done, &_pipeline.lock); }
+	pthread_mutex_unlock(&_pipeline.lock);
+}
+static int _pipeline_running(){ return _pipeline.running; }
+// 0 if update() should run here, after the last one is done
+static int _pipeline_update(){
+	_pipeline.running = 0;
+	if(!PIPELINE){ return 0; }
+	pthread_mutex_lock(&_pipeline.lock);
+	if(!_pipeline.started){
+		if(pthread_create(&_pipeline.thread, NULL, _pipeline_thread, NULL) != 0){
+			pthread_mutex_unlock(&_pipeline.lock);
+			PIPELINE = 0;
+			return 0;
+		}
+		pthread_detach(_pipeline.thread);
+		_pipeline.started = 1;
+	}
+	if(_pipeline.state != NULL){ memcpy(_pipeline.snapshot, _pipeline.state, _pipeline.size); }
+	_pipeline.running = 1;
+	_pipeline.requested++;
+	pthread_cond_broadcast(&_pipeline.done);
+	pthread_mutex_unlock(&_pipeline.lock);
+	return 1;
+}
+void pipelineState(void *state, size_t size){
+	// from setup() or an input callback, update() may be running
+	_pipeline_wait();
+	_pipeline.running = 0;
+	if(state == NULL){ size = 0; }
+	if(size != _pipeline.size){
+		free(_pipeline.snapshot);
+		_pipeline.snapshot = (state != NULL && size) ? malloc(size) : NULL;
+	}
+	_pipeline.state = (_pipeline.snapshot != NULL) ? state : NULL;
+	_pipeline.size = (_pipeline.snapshot != NULL) ? size : 0;
+}
+const void *drawState(){
+	return _pipeline.running ? _pipeline.snapshot : _pipeline.state;
+}
+///////////////////////////////////////
+//////////     CELESTIAL     //////////
+///////////////////////////////////////
+// every conversion is the same three steps: angles to a unit vector, one 3x3
+// rotation, and back to angles. the rotation takes the place of the trig of
+// each formula, so a frame change costs 9 multiply-adds per star, plus a
+// sine, cosine and arctangent pair on each side when the ends are angles.
+// the SSE2 path has its own float sincos and atan2 (Cephes' polynomials),
+// within a few hundred-thousandths of a degree, about what a float holds at 360
+#define CELESTIAL_OBLIQUITY 23.4392911  // J2000
+float localSiderealTime(double days, float longitude){
+	double t = days / 36525.0;
+	double degrees = fmod(280.46061837 + 360.98564736629 * days + 0.000387933 * t * t + longitude, 360.0);
+	return (degrees < 0) ? degrees + 360.0 : degrees;
+}
+// rows of the rotation from equatorial into the frame, and its transpose back
+static void _celestial_from_equatorial(int frame, const Observer *observer, double m[9]){
+	double identity[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+	memcpy(m, identity, sizeof(identity));
+	if(frame == CELESTIAL_ECLIPTIC){
+		double e = ((observer && observer->obliquity) ? observer->obliquity : CELESTIAL_OBLIQUITY) * D2R;
+		m[4] = cos(e);  m[5] = sin(e);
+		m[7] = -sin(e); m[8] = cos(e);
+	}
+	if(frame == CELESTIAL_HORIZONTAL){
+		// turned by the sidereal time, X is on the meridian and Y to the east,
+		// then tipped by the latitude so Z is the zenith: (north, east, up)
+		double t = (observer ? observer->siderealTime : 0) * D2R;
+		double p = (observer ? observer->latitude : 0) * D2R;
+		m[0] = -sin(p) * cos(t); m[1] = -sin(p) * sin(t); m[2] = cos(p);
+		m[3] = -sin(t);          m[4] = cos(t);           m[5] = 0;
+		m[6] = cos(p) * cos(t);  m[7] = cos(p) * sin(t);  m[8] = sin(p);
+	}
+}
+static void _celestial_rotation(int from, int to, const Observer *observer, float rotation[9]){
+	double a[9], b[9];
+	_celestial_from_equatorial(from, observer, a);
+	_celestial_from_equatorial(to, observer, b);
+	for(int r = 0; r < 3; r++){
+		for(int c = 0; c < 3; c++){
+			rotation[r*3+c] = b[r*3+0] * a[c*3+0] + b[r*3+1] * a[c*3+1] + b[r*3+2] * a[c*3+2];
+		}
+	}
+}
+void celestialMatrix(int from, int to, const Observer *observer, float m[16]){
+	float rotation[9];
+	_celestial_rotation(from, to, observer, rotation);
+	memset(m, 0, sizeof(float) * 16);
+	for(int r = 0; r < 3; r++){
+		for(int c = 0; c < 3; c++){ m[c*4+r] = rotation[r*3+c]; }
+	}
+	m[15] = 1;
+}
+typedef struct{
+	float rotation[9];
+	const float *longitude, *latitude, *xyz;  // input, angles or vectors
+	float *outLongitude, *outLatitude, *out;  // output, angles or vectors
+} _CelestialBatch;
+#ifdef __SSE2__
+#define _CELESTIAL_SHUFFLE(a, b, i0, i1, i2, i3) _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0))
+// x in radians, within a few turns of 0
+static void _celestial_sincos4(__m128 x, __m128 *s, __m128 *c){
+	__m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.63661977236758134f)));
+	__m128 n = _mm_cvtepi32_ps(q);
+	// pi/2 in three parts, each product exact
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(1.5703125f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(4.837512969970703125e-4f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(7.54978995489188216e-8f)));
+	__m128 z = _mm_mul_ps(r, r);
+	__m128 sine = _mm_add_ps(_mm_set1_ps(8.3321608736e-3f), _mm_mul_ps(z, _mm_set1_ps(-1.9515295891e-4f)));
+	sine = _mm_add_ps(_mm_set1_ps(-1.6666654611e-1f), _mm_mul_ps(z, sine));
+	sine = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), sine));
+	__m128 cosine = _mm_add_ps(_mm_set1_ps(-1.388731625493765e-3f), _mm_mul_ps(z, _mm_set1_ps(2.443315711809948e-5f)));
+	cosine = _mm_add_ps(_mm_set1_ps(4.166664568298827e-2f), _mm_mul_ps(z, cosine));
+	cosine = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_mul_ps(_mm_mul_ps(z, z), cosine));
+	// odd quadrants swap the two, the second bit of the quadrant flips the sign
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	*s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cosine), _mm_andnot_ps(swap, sine)), sinSign);
+	*c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sine), _mm_andnot_ps(swap, cosine)), cosSign);
+}
+// radians, atan2(0, 0) is 0
+static __m128 _celestial_atan2_4(__m128 y, __m128 x){
+	__m128 signBit = _mm_set1_ps(-0.0f);
+	__m128 ax = _mm_andnot_ps(signBit, x), ay = _mm_andnot_ps(signBit, y);
+	__m128 steep = _mm_cmpgt_ps(ay, ax);
+	__m128 big = _mm_max_ps(ax, ay);
+	__m128 t = _mm_andnot_ps(_mm_cmpeq_ps(big, _mm_setzero_ps()), _mm_div_ps(_mm_min_ps(ax, ay), big));
+	// past tan(pi/8), around 1 instead
+	__m128 far = _mm_cmpgt_ps(t, _mm_set1_ps(0.4142135623730950f));
+	__m128 shifted = _mm_div_ps(_mm_sub_ps(t, _mm_set1_ps(1.0f)), _mm_add_ps(t, _mm_set1_ps(1.0f)));
+	t = _mm_or_ps(_mm_and_ps(far, shifted), _mm_andnot_ps(far, t));
+	__m128 z = _mm_mul_ps(t, t);
+	__m128 p = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(8.05374449538e-2f), z), _mm_set1_ps(1.38776856032e-1f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.99777106478e-1f));
+	p = _mm_sub_ps(_mm_mul_ps(p, z), _mm_set1_ps(3.33329491539e-1f));
+	__m128 a = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), t), t);
+	a = _mm_add_ps(a, _mm_and_ps(far, _mm_set1_ps(0.78539816339744831f)));
+	a = _mm_or_ps(_mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(1.57079632679489662f), a)), _mm_andnot_ps(steep, a));
+	__m128 left = _mm_cmplt_ps(x, _mm_setzero_ps());
+	a = _mm_or_ps(_mm_and_ps(left, _mm_sub_ps(_mm_set1_ps(3.14159265358979324f), a)), _mm_andnot_ps(left, a));
+	return _mm_or_ps(a, _mm_and_ps(signBit, y));
+}
+#endif
+static void _celestial_step(void *context, int first, int end){
+	const _CelestialBatch *batch = (const _CelestialBatch*)context;
+	const float *m = batch->rotation;
+	int i = first;
+#ifdef __SSE2__
+	__m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	__m128 m3 = _mm_set1_ps(m[3]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+	__m128 m6 = _mm_set1_ps(m[6]), m7 = _mm_set1_ps(m[7]), m8 = _mm_set1_ps(m[8]);
+	for(; i + 4 <= end; i += 4){
+		__m128 x, y, z;
+		if(batch->xyz){
+			// 4 triples in 3 loads, pulled apart into X, Y and Z
+			__m128 a = _mm_loadu_ps(&batch->xyz[i*3+0]), b = _mm_loadu_ps(&batch->xyz[i*3+4]), c = _mm_loadu_ps(&batch->xyz[i*3+8]);
+			x = _CELESTIAL_SHUFFLE(_CELESTIAL_SHUFFLE(a, b, 0, 3, 2, 2), _CELESTIAL_SHUFFLE(b, c, 2, 2, 1, 1), 0, 1, 0, 2);
+			y = _CELESTIAL_SHUFFLE(_CELESTIAL_SHUFFLE(a, b, 1, 1, 0, 0), _CELESTIAL_SHUFFLE(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+			z = _CELESTIAL_SHUFFLE(_CELESTIAL_SHUFFLE(a, b, 2, 2, 1, 1), _CELESTIAL_SHUFFLE(c, c, 0, 0, 3, 3), 0, 2, 0, 2);
+		} else{
+			__m128 sl, cl, sb, cb;
+			_celestial_sincos4(_mm_mul_ps(_mm_loadu_ps(&batch->longitude[i]), _mm_set1_ps(D2R)), &sl, &cl);
+			_celestial_sincos4(_mm_mul_ps(_mm_loadu_ps(&batch->latitude[i]), _mm_set1_ps(D2R)), &sb, &cb);
+			x = _mm_mul_ps(cb, cl);
+			y = _mm_mul_ps(cb, sl);
+			z = sb;
+		}
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_mul_ps(m2, z));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m5, z));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m6, x), _mm_mul_ps(m7, y)), _mm_mul_ps(m8, z));
+		if(batch->out){
+			__m128 xy = _mm_unpacklo_ps(rx, ry), xyHigh = _mm_unpackhi_ps(rx, ry);
+			_mm_storeu_ps(&batch->out[i*3+0], _CELESTIAL_SHUFFLE(xy, _CELESTIAL_SHUFFLE(rz, rx, 0, 0, 1, 1), 0, 1, 0, 2));
+			_mm_storeu_ps(&batch->out[i*3+4], _CELESTIAL_SHUFFLE(_CELESTIAL_SHUFFLE(ry, rz, 1, 1, 1, 1), xyHigh, 0, 2, 0, 1));
+			_mm_storeu_ps(&batch->out[i*3+8], _CELESTIAL_SHUFFLE(_CELESTIAL_SHUFFLE(rz, rx, 2, 2, 3, 3), _CELESTIAL_SHUFFLE(ry, rz, 3, 3, 3, 3), 0, 2, 0, 2));
+		} else{
+			__m128 lon = _mm_mul_ps(_celestial_atan2_4(ry, rx), _mm_set1_ps(R2D));
+			lon = _mm_add_ps(lon, _mm_and_ps(_mm_cmplt_ps(lon, _mm_setzero_ps()), _mm_set1_ps(360.0f)));
+			__m128 lat = _celestial_atan2_4(rz, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry))));
+			_mm_storeu_ps(&batch->outLongitude[i], lon);
+			_mm_storeu_ps(&batch->outLatitude[i], _mm_mul_ps(lat, _mm_set1_ps(R2D)));
+		}
+	}
+#endif
+	// the remainder, or everything without SSE
+	for(; i < end; i++){
+		float v[3], r[3];
+		if(batch->xyz){ memcpy(v, &batch->xyz[i*3], sizeof(v)); }
+		else{
+			float lon = batch->longitude[i] * D2R, lat = batch->latitude[i] * D2R;
+			v[0] = cosf(lat) * cosf(lon);
+			v[1] = cosf(lat) * sinf(lon);
+			v[2] = sinf(lat);
+		}
+		mat3Vec3Mult(m, v, r);
+		if(batch->out){ memcpy(&batch->out[i*3], r, sizeof(r)); }
+		else{
+			float lon = atan2f(r[1], r[0]) * R2D;
+			batch->outLongitude[i] = (lon < 0) ? lon + 360.0f : lon;
+			batch->outLatitude[i] = atan2f(r[2], sqrtf(r[0]*r[0] + r[1]*r[1])) * R2D;
+		}
+	}
+}
+#undef _CELESTIAL_SHUFFLE
+static void _celestial_run(_CelestialBatch *batch, int count){
+	// one piece is a few pages of each array
+	parallelFor(0, count, 16384, _celestial_step, batch);
+}
+void convertCelestial(int from, int to, const Observer *observer, const float *longitude, const float *latitude, float *outLongitude, float *outLatitude, int count){
+	_CelestialBatch batch = { {0}, longitude, latitude, NULL, outLongitude, outLatitude, NULL };
+	_celestial_rotation(from, to, observer, batch.rotation);
+	_celestial_run(&batch, count);
+}
+void convertCartesian(int from, int to, const Observer *observer, const float *xyz, float *out, int count){
+	_CelestialBatch batch = { {0}, NULL, NULL, xyz, NULL, NULL, out };
+	_celestial_rotation(from, to, observer, batch.rotation);
+	_celestial_run(&batch, count);
+}
+void celestialToCartesian(const float *longitude, const float *latitude, float *xyz, int count){
+	_CelestialBatch batch = { {1, 0, 0, 0, 1, 0, 0, 0, 1}, longitude, latitude, NULL, NULL, NULL, xyz };
+	_celestial_run(&batch, count);
+}
+void cartesianToCelestial(const float *xyz, float *longitude, float *latitude, int count){
+	_CelestialBatch batch = { {1, 0, 0, 0, 1, 0, 0, 0, 1}, NULL, NULL, xyz, longitude, latitude, NULL };
+	_celestial_run(&batch, count);
+}
+///////////////////////////////////////
+//////////       SKYBOX      //////////
+///////////////////////////////////////
+// six 90 degree views from the origin, one per face of a cubemap. drawing it is
+// 12 triangles around the eye, each corner's texture coordinate its own direction,
+// so however much went into the bake, the frame pays for one cube
+#if defined(__glew_h__) || defined(GL_VERSION_1_3)
+static const float _skybox_corners[24] = { -1,-1,-1,  1,-1,-1,  1, 1,-1,  -1, 1,-1,  -1,-1, 1,  1,-1, 1,  1, 1, 1,  -1, 1, 1 };
+static const GLubyte _skybox_indices[36] = {
+	0, 1, 2, 0, 2, 3,  4, 5, 6, 4, 6, 7,  0, 1, 5, 0, 5, 4,
+	3, 2, 6, 3, 6, 7,  0, 3, 7, 0, 7, 4,  1, 2, 6, 1, 6, 5 };
+// direction and up of each face, in GL_TEXTURE_CUBE_MAP_POSITIVE_X order
+static const float _skybox_views[6][6] = {
+	{ 1, 0, 0,  0,-1, 0}, {-1, 0, 0,  0,-1, 0}, { 0, 1, 0,  0, 0, 1},
+	{ 0,-1, 0,  0, 0,-1}, { 0, 0, 1,  0,-1, 0}, { 0, 0,-1,  0,-1, 0} };
+static void _skybox_allocate(Skybox *sky, int size){
+	sky->size = size;
+	glBindTexture(GL_TEXTURE_CUBE_MAP, sky->texture);
+	for(int face = 0; face < 6; face++){
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	}
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	sky->memoryUsed = (size_t)size * size * 4 * 6;
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+	if(sky->depth){
+		glBindRenderbuffer(GL_RENDERBUFFER, sky->depth);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		sky->memoryUsed += (size_t)size * size * 4;
+	}
+#endif
+}
+Skybox *createSkybox(int size){
+	if(size <= 0){ return NULL; }
+	Skybox *sky = (Skybox*)calloc(1, sizeof(Skybox));
+	glGenTextures(1, &sky->texture);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, sky->texture);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+	glGenFramebuffers(1, &sky->framebuffer);
+	glGenRenderbuffers(1, &sky->depth);
+#endif
+	_skybox_allocate(sky, size);
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+	// checked once, against the first face. whatever was bound is put back, it can be a render target
+	GLint bound;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+	glBindFramebuffer(GL_FRAMEBUFFER, sky->framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X, sky->texture, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, sky->depth);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, bound);
+	if(status != GL_FRAMEBUFFER_COMPLETE){
+		glDeleteFramebuffers(1, &sky->framebuffer);
+		glDeleteRenderbuffers(1, &sky->depth);
+		sky->framebuffer = sky->depth = 0;
+		_skybox_allocate(sky, size);
+	}
+#endif
+	sky->clear[3] = 1.0;
+	return sky;
+}
+unsigned char bakeSkybox(Skybox *sky, unsigned long key, void (*draw)(void *context), void *context){
+	if(sky == NULL || (sky->valid && sky->key == key)){ return 0; }
+	if(!sky->framebuffer){
+		// the faces are drawn in the window, and have to fit
+		int fits = 1;
+		while(fits * 2 <= min(WIDTH, HEIGHT)){ fits *= 2; }
+		if(sky->size > fits){ _skybox_allocate(sky, fits); }
+	}
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+	// the 3D pass can be drawing into a render target, it goes on there afterwards
+	GLint bound = 0;
+	if(sky->framebuffer){ glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound); }
+#endif
+	glPushAttrib(GL_ALL_ATTRIB_BITS);
+	glDisable(GL_SCISSOR_TEST);  // baked from inside a viewport
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	gluPerspective(90, 1, NEAR_CLIP, FAR_CLIP);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glViewport(0, 0, sky->size, sky->size);
+	glClearColor(sky->clear[0], sky->clear[1], sky->clear[2], sky->clear[3]);
+	for(int face = 0; face < 6; face++){
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+		if(sky->framebuffer){
+			glBindFramebuffer(GL_FRAMEBUFFER, sky->framebuffer);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, sky->texture, 0);
+		}
+#endif
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		const float *v = _skybox_views[face];
+		glLoadIdentity();
+		gluLookAt(0, 0, 0, v[0], v[1], v[2], v[3], v[4], v[5]);
+		glPushMatrix();
+			glColor4f(1.0, 1.0, 1.0, 1.0);
+			draw(context);
+		glPopMatrix();
+		if(!sky->framebuffer){
+			glBindTexture(GL_TEXTURE_CUBE_MAP, sky->texture);
+			glCopyTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, 0, 0, 0, 0, sky->size, sky->size);
+			glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		}
+	}
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+	if(sky->framebuffer){ glBindFramebuffer(GL_FRAMEBUFFER, bound); }
+#endif
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+	// what the copies left in the back buffer
+	if(!sky->framebuffer){ glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
+	sky->key = key;
+	sky->valid = 1;
+	return 1;
+}
+void drawSkybox(const Skybox *sky){
+	if(sky == NULL || !sky->valid){ return; }
+	float modelview[16], clip[16], eye[3];
+	glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+	_view_clip(modelview, clip);
+	if(!_view_eye(clip, eye)){ return; }
+	// anywhere between the clipping planes, nothing else is depth tested against it
+	float radius = sqrtf(NEAR_CLIP * FAR_CLIP);
+	glPushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glDisable(GL_TEXTURE_2D);
+	glEnable(GL_TEXTURE_CUBE_MAP);
+	glDepthMask(GL_FALSE);
+	glColor4f(1.0, 1.0, 1.0, 1.0);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, sky->texture);
+	glPushMatrix();
+		glTranslatef(eye[0], eye[1], eye[2]);
+		glScalef(radius, radius, radius);
+		_state_arrays(_STATE_VERTEX | _STATE_TEXCOORD);
+		glVertexPointer(3, GL_FLOAT, 0, _skybox_corners);
+		glTexCoordPointer(3, GL_FLOAT, 0, _skybox_corners);
+		glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_BYTE, _skybox_indices);
+		_state_arrays_done();
+	glPopMatrix();
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	glPopAttrib();
+}
+void freeSkybox(Skybox *sky){
+	if(sky == NULL){ return; }
+	glDeleteTextures(1, &sky->texture);
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+	if(sky->framebuffer){ glDeleteFramebuffers(1, &sky->framebuffer); }
+	if(sky->depth){ glDeleteRenderbuffers(1, &sky->depth); }
+#endif
+	free(sky);
+}
+#endif
+///////////////////////////////////////
+//////////      CAPTURE      //////////
+///////////////////////////////////////
+// display() starts an asynchronous glReadPixels into one pixel buffer of the
+// ring, then maps the oldest one, which the GPU finished frames ago. its pixels
+// are copied into the next slot of a single producer, single consumer queue:
+// the main thread publishes the head, the writer the tail, and the writer only
+// takes the lock to sleep when the queue is empty. BGRA is the driver's own
+// order, turning it into RGB rows, top first, is left to the writer
+#define CAPTURE_RING 3  // pixel buffers, the frames of latency
+#define CAPTURE_QUEUE 8  // frames waiting for the writer
+typedef struct{
+	unsigned char *pixels;  // BGRA, bottom row first
+	unsigned long number;
+	int last;  // tells the writer to finish
+} _CaptureFrame;
+static struct{
+	int active, format, policy;
+	char *path;
+	FILE *stream;
+	GLuint buffers[CAPTURE_RING];
+	int pending[CAPTURE_RING];  // a read was started into it
+	int next;  // the buffer this frame reads into
+	_CaptureFrame frames[CAPTURE_QUEUE];
+	unsigned long head, tail;  // atomic. head is written by the main thread, tail by the writer
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	int sleeping;  // guarded by lock
+	int failed;  // atomic, a write failed
+	CaptureStats stats;  // written and dropped are atomic
+} _capture = { 0, 0, 0, NULL, NULL, {0}, {0}, 0, {{0}}, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static int _capture_write(const _CaptureFrame *frame, unsigned char *rgb){
+	int width = _capture.stats.width, height = _capture.stats.height;
+	for(int y = 0; y < height; y++){
+		const unsigned char *in = &frame->pixels[(size_t)(height - 1 - y) * width * 4];
+		unsigned char *out = &rgb[(size_t)y * width * 3];
+		for(int x = 0; x < width; x++){
+			out[x*3+0] = in[x*4+2];
+			out[x*3+1] = in[x*4+1];
+			out[x*3+2] = in[x*4+0];
+		}
+	}
+	size_t size = (size_t)width * height * 3;
+	if(_capture.format == CAPTURE_RAW){ return fwrite(rgb, 1, size, _capture.stream) == size; }
+	char filename[512];
+	snprintf(filename, sizeof(filename), _capture.path, (int)frame->number);
+	FILE *file = fopen(filename, "wb");
+	if(file == NULL){ return 0; }
+	int written = fprintf(file, "P6\n%d %d\n255\n", width, height) > 0 && fwrite(rgb, 1, size, file) == size;
+	if(fclose(file) != 0){ written = 0; }
+	return written;
+}
+static void *_capture_thread(void *arg){
+	unsigned char *rgb = (unsigned char*)malloc((size_t)_capture.stats.width * _capture.stats.height * 3);
+	while(1){
+		unsigned long tail = _capture.tail;
+		if(__atomic_load_n(&_capture.head, __ATOMIC_ACQUIRE) == tail){
+			pthread_mutex_lock(&_capture.lock);
+			_capture.sleeping = 1;
+			while(__atomic_load_n(&_capture.head, __ATOMIC_ACQUIRE) == tail){ pthread_cond_wait(&_capture.wake, &_capture.lock); }
+			_capture.sleeping = 0;
+			pthread_mutex_unlock(&_capture.lock);
+		}
+		_CaptureFrame *frame = &_capture.frames[tail % CAPTURE_QUEUE];
+		if(frame->last){ break; }
+		if(_capture_write(frame, rgb)){ __atomic_add_fetch(&_capture.stats.written, 1, __ATOMIC_RELAXED); }
+		else{ __atomic_store_n(&_capture.failed, 1, __ATOMIC_RELAXED); }
+		__atomic_store_n(&_capture.tail, tail + 1, __ATOMIC_RELEASE);
+	}
+	free(rgb);
+	return NULL;
+}
+// a free slot in the queue, NULL when the writer is behind and frames are dropped
+static _CaptureFrame *_capture_slot(int policy){
+	while(_capture.head - __atomic_load_n(&_capture.tail, __ATOMIC_ACQUIRE) >= CAPTURE_QUEUE){
+		if(policy == CAPTURE_DROP){ return NULL; }
+		struct timespec pause = { 0, 500000 };
+		nanosleep(&pause, NULL);
+	}
+	return &_capture.frames[_capture.head % CAPTURE_QUEUE];
+}
+static void _capture_push(){
+	__atomic_store_n(&_capture.head, _capture.head + 1, __ATOMIC_RELEASE);
+	pthread_mutex_lock(&_capture.lock);
+	if(_capture.sleeping){ pthread_cond_signal(&_capture.wake); }
+	pthread_mutex_unlock(&_capture.lock);
+}
+static void _capture_queue(const void *pixels, int policy){
+	_CaptureFrame *frame = _capture_slot(policy);
+	if(frame == NULL){
+		__atomic_add_fetch(&_capture.stats.dropped, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	memcpy(frame->pixels, pixels, (size_t)_capture.stats.width * _capture.stats.height * 4);
+	frame->number = _capture.stats.captured++;
+	_capture_push();
+}
+#if defined(__glew_h__) || defined(GL_VERSION_2_1)
+// the oldest read, now long finished, out of its pixel buffer and onto the queue
+static void _capture_collect(int buffer, int policy){
+	if(!_capture.pending[buffer]){ return; }
+	_capture.pending[buffer] = 0;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, _capture.buffers[buffer]);
+	const void *pixels = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+	if(pixels != NULL){
+		_capture_queue(pixels, policy);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+#endif
+static void _capture_frame(){
+	if(!_capture.active){ return; }
+	if(WIDTH != _capture.stats.width || HEIGHT != _capture.stats.height){
+		__atomic_add_fetch(&_capture.stats.dropped, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+	glReadBuffer(GL_BACK);
+#if defined(__glew_h__) || defined(GL_VERSION_2_1)
+	int buffer = _capture.next;
+	_capture.next = (buffer + 1) % CAPTURE_RING;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, _capture.buffers[buffer]);
+	glReadPixels(0, 0, WIDTH, HEIGHT, GL_BGRA, GL_UNSIGNED_BYTE, 0);  // returns right away
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	_capture.pending[buffer] = 1;
+	_capture_collect(_capture.next, _capture.policy);
+#else
+	// without pixel buffers the read waits for the frame, only the writing is off this thread
+	_CaptureFrame *frame = _capture_slot(_capture.policy);
+	if(frame != NULL){
+		glReadPixels(0, 0, WIDTH, HEIGHT, GL_BGRA, GL_UNSIGNED_BYTE, frame->pixels);
+		frame->number = _capture.stats.captured++;
+		_capture_push();
+	}
+	else{ __atomic_add_fetch(&_capture.stats.dropped, 1, __ATOMIC_RELAXED); }
+#endif
+	glPopClientAttrib();
+}
+static void _capture_release(){
+#if defined(__glew_h__) || defined(GL_VERSION_2_1)
+	glDeleteBuffers(CAPTURE_RING, _capture.buffers);
+#endif
+	for(int i = 0; i < CAPTURE_QUEUE; i++){
+		free(_capture.frames[i].pixels);
+		_capture.frames[i].pixels = NULL;
+	}
+	if(_capture.stream != NULL){ fclose(_capture.stream); }
+	_capture.stream = NULL;
+	free(_capture.path);
+	_capture.path = NULL;
+}
+int startCapture(const char *path, int format, int policy){
+	if(_capture.active || path == NULL){ return 0; }
+	memset(&_capture.stats, 0, sizeof(CaptureStats));
+	_capture.stats.width = WIDTH;
+	_capture.stats.height = HEIGHT;
+	_capture.format = format;
+	_capture.policy = policy;
+	if(format == CAPTURE_RAW && (_capture.stream = fopen(path, "wb")) == NULL){ return 0; }
+	_capture.path = strdup(path);
+	size_t size = (size_t)WIDTH * HEIGHT * 4;
+	for(int i = 0; i < CAPTURE_QUEUE; i++){
+		_capture.frames[i].pixels = (unsigned char*)malloc(size);
+		_capture.frames[i].last = 0;
+	}
+#if defined(__glew_h__) || defined(GL_VERSION_2_1)
+	glGenBuffers(CAPTURE_RING, _capture.buffers);
+	for(int i = 0; i < CAPTURE_RING; i++){
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, _capture.buffers[i]);
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+		_capture.pending[i] = 0;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	_capture.next = 0;
+#endif
+	_capture.head = _capture.tail = 0;
+	_capture.failed = 0;
+	if(pthread_create(&_capture.thread, NULL, _capture_thread, NULL) != 0){
+		_capture_release();
+		return 0;
+	}
+	_capture.active = 1;
+	return 1;
+}
+void stopCapture(){
+	if(!_capture.active){ return; }
+	_capture.active = 0;
+#if defined(__glew_h__) || defined(GL_VERSION_2_1)
+	// the reads still in flight, oldest first
+	for(int i = 0; i < CAPTURE_RING; i++){ _capture_collect((_capture.next + i) % CAPTURE_RING, CAPTURE_BLOCK); }
+#endif
+	_capture_slot(CAPTURE_BLOCK)->last = 1;
+	_capture_push();
+	pthread_join(_capture.thread, NULL);
+	_capture_release();
+	if(_capture.failed){ printf("capture: some frames could not be written\n"); }
+}
+unsigned char isCapturing(){ return _capture.active; }
+CaptureStats captureStats(){
+	CaptureStats stats = _capture.stats;
+	stats.written = __atomic_load_n(&_capture.stats.written, __ATOMIC_RELAXED);
+	stats.dropped = __atomic_load_n(&_capture.stats.dropped, __ATOMIC_RELAXED);
+	return stats;
+}
+///////////////////////////////////////
+//////////  RENDER TARGETS   //////////
+///////////////////////////////////////
+// a framebuffer with a color texture and a depth renderbuffer. multisampled,
+// drawing goes into a second framebuffer of multisample renderbuffers, which
+// resolveRenderTarget() blits into the texture.
+// dynamic resolution keeps one target the size of the window and draws the 3D
+// pass into its lower left corner, RESOLUTION_SCALE of each side, so the scale
+// changes without reallocating. timer queries measure that pass a few frames
+// late; its cost over the scale squared is the cost of the whole window, which
+// sets the next scale
+#if defined(__glew_h__) || defined(GL_VERSION_3_0)
+static RenderTarget *_render_target_current = NULL;  // what bindRenderTarget(NULL) binds: the window, or the 3D pass's target
+static int _render_target_viewport[2];  // and its size
+static int _render_target_allocate(RenderTarget *target){
+	int width = target->width, height = target->height, samples = target->samples;
+	GLint bound;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+	glBindTexture(GL_TEXTURE_2D, target->color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindRenderbuffer(GL_RENDERBUFFER, target->depth);
+	if(samples){ glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, width, height); }
+	else{ glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height); }
+	if(samples){
+		glBindRenderbuffer(GL_RENDERBUFFER, target->multisampleColor);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+	}
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	target->memoryUsed = (size_t)width * height * 4 * (samples ? 1 + samples * 2 : 2);
+	glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target->color, 0);
+	if(!samples){ glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->depth); }
+	int complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	if(samples){
+		glBindFramebuffer(GL_FRAMEBUFFER, target->multisample);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target->multisampleColor);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->depth);
+		complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, bound);
+	return complete;
+}
+RenderTarget *createRenderTarget(int width, int height, int samples){
+	if(width <= 0 || height <= 0){ return NULL; }
+	RenderTarget *target = (RenderTarget*)calloc(1, sizeof(RenderTarget));
+	target->width = width;
+	target->height = height;
+	if(samples > 1){
+		GLint most = 0;
+		glGetIntegerv(GL_MAX_SAMPLES, &most);
+		target->samples = (samples < most) ? samples : most;
+		if(target->samples < 2){ target->samples = 0; }
+	}
+	glGenFramebuffers(1, &target->framebuffer);
+	glGenTextures(1, &target->color);
+	glBindTexture(GL_TEXTURE_2D, target->color);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glGenRenderbuffers(1, &target->depth);
+	if(target->samples){
+		glGenFramebuffers(1, &target->multisample);
+		glGenRenderbuffers(1, &target->multisampleColor);
+	}
+	if(!_render_target_allocate(target)){
+		freeRenderTarget(target);
+		return NULL;
+	}
+	return target;
+}
+void resizeRenderTarget(RenderTarget *target, int width, int height){
+	if(target == NULL || width <= 0 || height <= 0 || (width == target->width && height == target->height)){ return; }
+	target->width = width;
+	target->height = height;
+	_render_target_allocate(target);
+}
+void bindRenderTarget(RenderTarget *target){
+	if(target == NULL){
+		target = _render_target_current;
+		if(target == NULL){
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, WIDTH, HEIGHT);
+			return;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, target->samples ? target->multisample : target->framebuffer);
+		glViewport(0, 0, _render_target_viewport[0], _render_target_viewport[1]);
+		return;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, target->samples ? target->multisample : target->framebuffer);
+	glViewport(0, 0, target->width, target->height);
+}
+static void _render_target_resolve(RenderTarget *target, int width, int height){
+	if(target == NULL || !target->samples){ return; }
+	GLint bound;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, target->multisample);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target->framebuffer);
+	glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_FRAMEBUFFER, bound);
+}
+void resolveRenderTarget(RenderTarget *target){
+	if(target != NULL){ _render_target_resolve(target, target->width, target->height); }
+}
+// s and t: how much of the texture, from its lower left corner
+static void _render_target_draw(const RenderTarget *target, float s, float t, float x, float y, float width, float height){
+	float vertices[8] = { x, y,  x + width, y,  x + width, y + height,  x, y + height };
+	float coordinates[8] = { 0, 0,  s, 0,  s, t,  0, t };
+	glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, target->color);
+	glColor4f(1.0, 1.0, 1.0, 1.0);
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0, WIDTH, 0, HEIGHT, -1, 1);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+	_state_arrays(_STATE_VERTEX | _STATE_TEXCOORD);
+	glVertexPointer(2, GL_FLOAT, 0, vertices);
+	glTexCoordPointer(2, GL_FLOAT, 0, coordinates);
+	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+	_state_arrays_done();
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glPopAttrib();
+}
+void presentRenderTarget(RenderTarget *target, float x, float y, float width, float height){
+	if(target == NULL){ return; }
+	_render_target_draw(target, 1, 1, x, y, width, height);
+}
+void freeRenderTarget(RenderTarget *target){
+	if(target == NULL){ return; }
+	if(_render_target_current == target){ _render_target_current = NULL; }
+	glDeleteFramebuffers(1, &target->framebuffer);
+	glDeleteTextures(1, &target->color);
+	glDeleteRenderbuffers(1, &target->depth);
+	if(target->multisample){ glDeleteFramebuffers(1, &target->multisample); }
+	if(target->multisampleColor){ glDeleteRenderbuffers(1, &target->multisampleColor); }
+	free(target);
+}
+// DYNAMIC RESOLUTION
+#define RESOLUTION_QUERIES 4  // frames of timings in flight
+static struct{
+	RenderTarget *target;
+	GLuint queries[RESOLUTION_QUERIES];
+	float scales[RESOLUTION_QUERIES];  // each query's RESOLUTION_SCALE, 0 when it's not in flight
+	int next;
+	int timing;  // a query was started this frame
+	float windowCost;  // milliseconds for the whole window, smoothed
+	struct timespec start;
+} _resolution;
+static void _resolution_sample(float milliseconds, float scale){
+	float cost = milliseconds / (scale * scale);
+	_resolution.windowCost = (_resolution.windowCost == 0) ? cost : _resolution.windowCost * 0.75 + cost * 0.25;
+	// aim under the budget, and leave small differences alone so the scale doesn't shimmer
+	float fit = sqrtf(FRAME_BUDGET * 0.9 / _resolution.windowCost);
+	fit = min(max(fit, MIN_RESOLUTION_SCALE), 1.0);
+	if(fabsf(fit - RESOLUTION_SCALE) > 0.03 || (fit == 1.0 && RESOLUTION_SCALE != 1.0)){ RESOLUTION_SCALE = fit; }
+}
+static unsigned char _resolution_begin(){
+	if(!DYNAMIC_RESOLUTION){
+		RESOLUTION_SCALE = 1.0;
+		return 0;
+	}
+	if(_resolution.target == NULL){
+		if((_resolution.target = createRenderTarget(WIDTH, HEIGHT, 0)) == NULL){
+			DYNAMIC_RESOLUTION = 0;
+			return 0;
+		}
+#ifdef GL_TIME_ELAPSED
+		glGenQueries(RESOLUTION_QUERIES, _resolution.queries);
+#endif
+	}
+	resizeRenderTarget(_resolution.target, WIDTH, HEIGHT);
+	_resolution.timing = 0;
+#ifdef GL_TIME_ELAPSED
+	// every finished query, oldest first
+	for(int i = 0; i < RESOLUTION_QUERIES; i++){
+		int q = (_resolution.next + i) % RESOLUTION_QUERIES;
+		if(_resolution.scales[q] == 0){ continue; }
+		GLint available = 0;
+		glGetQueryObjectiv(_resolution.queries[q], GL_QUERY_RESULT_AVAILABLE, &available);
+		if(!available){ continue; }
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(_resolution.queries[q], GL_QUERY_RESULT, &nanoseconds);
+		_resolution_sample(nanoseconds / 1000000.0, _resolution.scales[q]);
+		_resolution.scales[q] = 0;
+	}
+	if(_resolution.scales[_resolution.next] == 0){
+		glBeginQuery(GL_TIME_ELAPSED, _resolution.queries[_resolution.next]);
+		_resolution.scales[_resolution.next] = RESOLUTION_SCALE;
+		_resolution.timing = 1;
+	}
+#else
+	clock_gettime(CLOCK_MONOTONIC, &_resolution.start);
+#endif
+	_render_target_current = _resolution.target;
+	_render_target_viewport[0] = max(roundf(WIDTH * RESOLUTION_SCALE), 1);
+	_render_target_viewport[1] = max(roundf(HEIGHT * RESOLUTION_SCALE), 1);
+	bindRenderTarget(NULL);
+	return 1;
+}
+static void _resolution_end(){
+#ifdef GL_TIME_ELAPSED
+	if(_resolution.timing){
+		glEndQuery(GL_TIME_ELAPSED);
+		_resolution.next = (_resolution.next + 1) % RESOLUTION_QUERIES;
+	}
+#else
+	// without timer queries, the time to hand the pass to the driver and draw it
+	glFinish();
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	_resolution_sample((end.tv_sec - _resolution.start.tv_sec) * 1000.0 + (end.tv_nsec - _resolution.start.tv_nsec) / 1000000.0, RESOLUTION_SCALE);
+#endif
+	RenderTarget *target = _resolution.target;
+	int width = _render_target_viewport[0], height = _render_target_viewport[1];
+	_render_target_current = NULL;
+	bindRenderTarget(NULL);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	_render_target_draw(target, (float)width / target->width, (float)height / target->height, 0, 0, WIDTH, HEIGHT);
+}
+#else
+static unsigned char _resolution_begin(){ return 0; }
+static void _resolution_end(){ }
+#endif
+//////////  VIEWPORTS   //////////
+static Viewport *_viewports[MAX_VIEWPORTS];
+static int _viewport_count = 0;
+static int _viewport_focused = 0;  // its camera is the globals
+static Viewport *_viewport_current = NULL;
+static void _viewport_store(Viewport *view){
+	view->perspective = PERSPECTIVE;
+	view->settings = SETTINGS;
+	view->fov = FOV;
+	memcpy(view->origin, ORIGIN, sizeof(view->origin));
+	memcpy(view->horizon, HORIZON, sizeof(view->horizon));
+	memcpy(view->window, WINDOW, sizeof(view->window));
+}
+static void _viewport_load(const Viewport *view){
+	PERSPECTIVE = view->perspective;
+	SETTINGS = view->settings;
+	FOV = view->fov;
+	memcpy(ORIGIN, view->origin, sizeof(view->origin));
+	memcpy(HORIZON, view->horizon, sizeof(view->horizon));
+	memcpy(WINDOW, view->window, sizeof(view->window));
+}
+Viewport *addViewport(float x, float y, float width, float height){
+	if(_viewport_count >= MAX_VIEWPORTS){ return NULL; }
+	Viewport *view = malloc(sizeof(Viewport));
+	view->x = x;
+	view->y = y;
+	view->width = width;
+	view->height = height;
+	_viewport_store(view);
+	_viewports[_viewport_count++] = view;
+	return view;
+}
+void removeViewport(Viewport *viewport){
+	int i = 0;
+	while(i < _viewport_count && _viewports[i] != viewport){ i++; }
+	if(i == _viewport_count){ return; }
+	memmove(&_viewports[i], &_viewports[i+1], (_viewport_count - i - 1) * sizeof(Viewport*));
+	_viewport_count--;
+	if(i < _viewport_focused){ _viewport_focused--; }
+	else if(i == _viewport_focused){
+		// the globals keep the removed camera when no view is left to take over
+		_viewport_focused = 0;
+		if(_viewport_count){ _viewport_load(_viewports[0]); }
+	}
+	free(viewport);
+	rebuildProjection();
+}
+void focusViewport(Viewport *viewport){
+	for(int i = 0; i < _viewport_count; i++){
+		if(_viewports[i] != viewport){ continue; }
+		if(i != _viewport_focused){
+			_viewport_store(_viewports[_viewport_focused]);
+			_viewport_load(viewport);
+			_viewport_focused = i;
+			rebuildProjection();
+		}
+		return;
+	}
+}
+Viewport *focusedViewport(){ return _viewport_count ? _viewports[_viewport_focused] : NULL; }
+Viewport *currentViewport(){ return _viewport_current; }
+static void _viewports_focus(int x, int y){
+	// the last view added is on top
+	float fx = (float)x / WIDTH, fy = 1.0 - (float)y / HEIGHT;
+	for(int i = _viewport_count - 1; i >= 0; i--){
+		Viewport *view = _viewports[i];
+		if(fx >= view->x && fx < view->x + view->width && fy >= view->y && fy < view->y + view->height){
+			focusViewport(view);
+			return;
+		}
+	}
+}
+static void _viewports_display(){
+	if(!_viewport_count){
+		_display_3d();
+		return;
+	}
+	GLint frame[4];  // the window, or the smaller target of DYNAMIC_RESOLUTION
+	glGetIntegerv(GL_VIEWPORT, frame);
+	int width = WIDTH, height = HEIGHT;
+	float aspect = ASPECT;
+	_viewport_store(_viewports[_viewport_focused]);
+	glEnable(GL_SCISSOR_TEST);
+	for(int i = 0; i < _viewport_count; i++){
+		Viewport *view = _viewports[i];
+		// neighbors share their edge pixels exactly
+		GLint left = frame[0] + (GLint)roundf(view->x * frame[2]);
+		GLint bottom = frame[1] + (GLint)roundf(view->y * frame[3]);
+		GLint right = frame[0] + (GLint)roundf((view->x + view->width) * frame[2]);
+		GLint top = frame[1] + (GLint)roundf((view->y + view->height) * frame[3]);
+		if(right <= left || top <= bottom){ continue; }
+		glViewport(left, bottom, right - left, top - bottom);
+		glScissor(left, bottom, right - left, top - bottom);
+		if(i){ glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }  // over the views before it
+		// the projections take their aspect from WIDTH and HEIGHT
+		WIDTH = max(roundf(view->width * width), 1);
+		HEIGHT = max(roundf(view->height * height), 1);
+		ASPECT = (float)WIDTH / (float)HEIGHT;
+		_viewport_load(view);
+		WINDOW[0] += (WINDOW[2] - WINDOW[3] * ASPECT) * 0.5;
+		WINDOW[2] = WINDOW[3] * ASPECT;
+		_viewport_current = view;
+		rebuildProjection();
+		_display_3d();
+		_viewport_store(view);
+	}
+	_viewport_current = NULL;
+	glDisable(GL_SCISSOR_TEST);
+	glViewport(frame[0], frame[1], frame[2], frame[3]);
+	WIDTH = width;
+	HEIGHT = height;
+	ASPECT = aspect;
+	_viewport_load(_viewports[_viewport_focused]);
+}
 #endif /* WORLD_FRAMEWORK */